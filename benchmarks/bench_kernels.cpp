@@ -0,0 +1,332 @@
+// pytafast_bench - where the time goes below Python, per function and size.
+//
+// Every TA-Lib function (through the abstract interface, so new functions
+// are picked up without edits) is timed in two layers:
+//   raw   TA_CallFunc into preallocated outputs: TA-Lib compute only
+//   core  pytafast::compute, pytafast_core's span API, into preallocated
+//         outputs: the function table lookup's result, parameter defaults,
+//         lookback, argument checks and NaN fill of the lookback around the
+//         same kernel
+// benchmarks/bench_layers.py adds the third layer, the Python call, to the
+// same JSON; its output allocation and numpy conversion are what python -
+// core leaves.
+//
+// Build with -DPYTAFAST_BENCHMARKS=ON, then:
+//   pytafast_bench [--filter SUBSTR] [--sizes 10,1000,...] [--max-size N]
+//                  [--min-time SECONDS] [--out FILE]
+// Sizes default to powers of ten from 10 up to --max-size (10^7; 10^8 needs
+// about 9 GB for the inputs and outputs).
+#include <pytafast/core.h>
+#include <ta_libc.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+  std::string filter;
+  std::vector<size_t> sizes;
+  size_t max_size = 10'000'000;
+  double min_time = 0.05;
+  std::string out;
+};
+
+// Random-walk OHLCV shared by every function, at the largest size
+struct Market {
+  explicit Market(size_t n)
+      : open(n), high(n), low(n), close(n), volume(n) {
+    std::mt19937_64 rng(42);
+    std::normal_distribution<double> step(0.0, 1.0);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    double price = 100.0;
+    for (size_t i = 0; i < n; ++i) {
+      open[i] = price;
+      price = std::max(1.0, price + step(rng));
+      close[i] = price;
+      high[i] = std::max(open[i], close[i]) + unit(rng);
+      low[i] = std::min(open[i], close[i]) - unit(rng);
+      volume[i] = 1000.0 + 1000.0 * unit(rng);
+    }
+  }
+  std::vector<double> open, high, low, close, volume;
+};
+
+struct Output {
+  bool integer;
+};
+
+// One function with its inputs bound and optional inputs at their defaults
+class Function {
+public:
+  Function(const TA_FuncInfo *info, const Market &market) : info_(info) {
+    check(TA_ParamHolderAlloc(info->handle, &params_), "TA_ParamHolderAlloc");
+    // Real inputs cycle through close, high, low so that two-series
+    // functions (BETA, CORREL, ...) get distinct data
+    const double *reals[] = {market.close.data(), market.high.data(),
+                             market.low.data()};
+    unsigned n_real = 0;
+    for (unsigned i = 0; i < info->nbInput; ++i) {
+      const TA_InputParameterInfo *in;
+      check(TA_GetInputParameterInfo(info->handle, i, &in),
+            "TA_GetInputParameterInfo");
+      if (in->type == TA_Input_Price) {
+        check(TA_SetInputParamPricePtr(params_, i, market.open.data(),
+                                       market.high.data(), market.low.data(),
+                                       market.close.data(),
+                                       market.volume.data(), nullptr),
+              "TA_SetInputParamPricePtr");
+      } else if (in->type == TA_Input_Real) {
+        check(TA_SetInputParamRealPtr(params_, i, reals[n_real++ % 3]),
+              "TA_SetInputParamRealPtr");
+      } else {
+        throw std::runtime_error("integer inputs are not benchmarked");
+      }
+    }
+    for (unsigned i = 0; i < info->nbOptInput; ++i) {
+      const TA_OptInputParameterInfo *opt;
+      check(TA_GetOptInputParameterInfo(info->handle, i, &opt),
+            "TA_GetOptInputParameterInfo");
+      if (opt->type == TA_OptInput_RealRange ||
+          opt->type == TA_OptInput_RealList)
+        check(TA_SetOptInputParamReal(params_, i, opt->defaultValue),
+              "TA_SetOptInputParamReal");
+      else
+        check(TA_SetOptInputParamInteger(params_, i, (int)opt->defaultValue),
+              "TA_SetOptInputParamInteger");
+    }
+    for (unsigned i = 0; i < info->nbOutput; ++i) {
+      const TA_OutputParameterInfo *out;
+      check(TA_GetOutputParameterInfo(info->handle, i, &out),
+            "TA_GetOutputParameterInfo");
+      outputs_.push_back({out->type == TA_Output_Integer});
+    }
+  }
+  ~Function() { TA_ParamHolderFree(params_); }
+  Function(const Function &) = delete;
+  Function &operator=(const Function &) = delete;
+
+  const char *name() const { return info_->name; }
+
+  // Points output i at `data` (8 bytes per bar for both output types, as
+  // the bindings allocate)
+  void bind_output(unsigned i, void *data) {
+    if (outputs_[i].integer)
+      TA_SetOutputParamIntegerPtr(params_, i, (TA_Integer *)data);
+    else
+      TA_SetOutputParamRealPtr(params_, i, (TA_Real *)data);
+  }
+
+  void call(size_t n) {
+    TA_Integer begin, count;
+    check(TA_CallFunc(params_, 0, (TA_Integer)n - 1, &begin, &count),
+          info_->name);
+  }
+
+  size_t n_outputs() const { return outputs_.size(); }
+
+private:
+  static void check(TA_RetCode code, const char *what) {
+    if (code != TA_SUCCESS)
+      throw std::runtime_error(std::string(what) +
+                               " failed with TA_RetCode: " +
+                               std::to_string(code));
+  }
+
+  const TA_FuncInfo *info_;
+  TA_ParamHolder *params_ = nullptr;
+  std::vector<Output> outputs_;
+};
+
+// The same function through pytafast::compute, with the inputs bound by
+// name as bench_layers.py binds them for the Python call
+class CoreCall {
+public:
+  CoreCall(const pytafast::FunctionInfo &fn, const Market &market)
+      : fn_(fn) {
+    for (const char *name : fn.inputs) {
+      std::string in = name;
+      const std::vector<double> &series =
+          in == "inOpen"     ? market.open
+          : in == "inHigh"   ? market.high
+          : in == "inLow"    ? market.low
+          : in == "inVolume" ? market.volume
+          : in == "inReal1"  ? market.high
+                             : market.close;
+      series_.push_back(&series);
+    }
+  }
+
+  void call(size_t n, double *outputs, size_t stride) {
+    inputs_.clear();
+    for (const std::vector<double> *series : series_)
+      inputs_.emplace_back(series->data(), n);
+    if (fn_.integer_output) {
+      int_outputs_.clear();
+      for (size_t i = 0; i < fn_.outputs.size(); ++i)
+        int_outputs_.emplace_back(
+            reinterpret_cast<int *>(outputs + i * stride), n);
+      pytafast::compute(fn_, inputs_, {}, int_outputs_);
+    } else {
+      real_outputs_.clear();
+      for (size_t i = 0; i < fn_.outputs.size(); ++i)
+        real_outputs_.emplace_back(outputs + i * stride, n);
+      pytafast::compute(fn_, inputs_, {}, real_outputs_);
+    }
+  }
+
+private:
+  const pytafast::FunctionInfo &fn_;
+  std::vector<const std::vector<double> *> series_;
+  std::vector<pytafast::span<const double>> inputs_;
+  std::vector<pytafast::span<double>> real_outputs_;
+  std::vector<pytafast::span<int>> int_outputs_;
+};
+
+struct Result {
+  std::string name, layer;
+  size_t size, iterations;
+  double min_ns, median_ns;
+};
+
+// Repeats `body` for at least `min_time` seconds (and 5 runs)
+template <typename F>
+Result measure(const char *name, const char *layer, size_t size, F &&body,
+               double min_time) {
+  std::vector<double> runs;
+  auto deadline = Clock::now() + std::chrono::duration<double>(min_time);
+  do {
+    auto start = Clock::now();
+    body();
+    runs.push_back(
+        std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+  } while (runs.size() < 5 || Clock::now() < deadline);
+  std::sort(runs.begin(), runs.end());
+  Result r;
+  r.name = name;
+  r.layer = layer;
+  r.size = size;
+  r.iterations = runs.size();
+  r.min_ns = runs.front();
+  r.median_ns = runs[runs.size() / 2];
+  return r;
+}
+
+std::vector<size_t> parse_sizes(const char *text) {
+  std::vector<size_t> sizes;
+  for (const char *p = text; *p;) {
+    char *end;
+    sizes.push_back((size_t)std::strtod(p, &end));
+    if (end == p) throw std::invalid_argument("bad --sizes");
+    p = *end == ',' ? end + 1 : end;
+  }
+  return sizes;
+}
+
+Options parse_args(int argc, char **argv) {
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    auto value = [&]() -> const char * {
+      if (i + 1 >= argc) throw std::invalid_argument(arg + " needs a value");
+      return argv[++i];
+    };
+    if (arg == "--filter") opt.filter = value();
+    else if (arg == "--sizes") opt.sizes = parse_sizes(value());
+    else if (arg == "--max-size") opt.max_size = (size_t)std::strtod(value(), nullptr);
+    else if (arg == "--min-time") opt.min_time = std::strtod(value(), nullptr);
+    else if (arg == "--out") opt.out = value();
+    else throw std::invalid_argument("unknown argument " + arg);
+  }
+  if (opt.sizes.empty())
+    for (size_t n = 10; n <= opt.max_size; n *= 10) opt.sizes.push_back(n);
+  return opt;
+}
+
+void write_json(std::FILE *f, const std::vector<Result> &results) {
+  std::fprintf(f, "{\n  \"context\": {\"tool\": \"pytafast_bench\", "
+                  "\"unit\": \"ns\"},\n  \"benchmarks\": [");
+  for (size_t i = 0; i < results.size(); ++i) {
+    const Result &r = results[i];
+    std::fprintf(f,
+                 "%s\n    {\"name\": \"%s\", \"layer\": \"%s\", \"size\": %zu, "
+                 "\"iterations\": %zu, \"min_ns\": %.0f, \"median_ns\": %.0f, "
+                 "\"ns_per_element\": %.4f}",
+                 i ? "," : "", r.name.c_str(), r.layer.c_str(), r.size,
+                 r.iterations, r.min_ns, r.median_ns, r.min_ns / r.size);
+  }
+  std::fprintf(f, "\n  ]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  try {
+    Options opt = parse_args(argc, argv);
+    pytafast::initialize();
+
+    std::vector<const TA_FuncInfo *> infos;
+    TA_ForEachFunc(
+        [](const TA_FuncInfo *info, void *opaque) {
+          static_cast<std::vector<const TA_FuncInfo *> *>(opaque)->push_back(info);
+        },
+        &infos);
+    std::sort(infos.begin(), infos.end(),
+              [](auto *a, auto *b) { return std::strcmp(a->name, b->name) < 0; });
+
+    size_t largest = *std::max_element(opt.sizes.begin(), opt.sizes.end());
+    Market market(largest);
+    std::vector<double> outputs(3 * largest);
+
+    std::vector<Result> results;
+    for (const TA_FuncInfo *info : infos) {
+      if (!opt.filter.empty() && !std::strstr(info->name, opt.filter.c_str()))
+        continue;
+      std::unique_ptr<Function> fn;
+      const pytafast::FunctionInfo *core_fn =
+          pytafast::lookup_function(info->name);
+      try {
+        fn = std::make_unique<Function>(info, market);
+        if (!core_fn) throw std::runtime_error("not in pytafast_core");
+      } catch (const std::exception &e) {
+        std::fprintf(stderr, "skipping %s: %s\n", info->name, e.what());
+        continue;
+      }
+      CoreCall core_call(*core_fn, market);
+      for (size_t n : opt.sizes) {
+        for (unsigned i = 0; i < fn->n_outputs(); ++i)
+          fn->bind_output(i, outputs.data() + i * largest);
+        Result raw = measure(info->name, "raw", n, [&] { fn->call(n); },
+                             opt.min_time);
+        Result core = measure(
+            info->name, "core", n,
+            [&] { core_call.call(n, outputs.data(), largest); }, opt.min_time);
+        std::fprintf(stderr, "%-20s n=%-10zu raw %12.0f ns  core %12.0f ns\n",
+                     info->name, n, raw.min_ns, core.min_ns);
+        results.push_back(raw);
+        results.push_back(core);
+      }
+    }
+
+    std::FILE *f = opt.out.empty() ? stdout : std::fopen(opt.out.c_str(), "w");
+    if (!f) throw std::runtime_error("cannot open " + opt.out);
+    write_json(f, results);
+    if (f != stdout) std::fclose(f);
+    pytafast::shutdown();
+  } catch (const std::exception &e) {
+    std::fprintf(stderr, "pytafast_bench: %s\n", e.what());
+    return 1;
+  }
+  return 0;
+}
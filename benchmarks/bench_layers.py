@@ -0,0 +1,96 @@
+"""
+Adds the Python layer to pytafast_bench output.
+
+pytafast_bench (benchmarks/bench_kernels.cpp) times each TA-Lib function raw
+and through pytafast_core's pytafast::compute in C++. This script times the
+public Python call - argument parsing, numpy conversion and result wrapping
+included - for every function and size in that file, on the same random-walk
+OHLCV data shape and default parameters, and writes all three layers to one
+JSON:
+
+    python - core = binding overhead: conversion, output allocation, wrapping
+    core - raw    = pytafast_core's parameter, lookback and NaN handling
+
+Run with:
+    cmake -S . -B build -DPYTAFAST_BENCHMARKS=ON && cmake --build build --target pytafast_bench
+    build/pytafast_bench --out kernels.json
+    uv run python benchmarks/bench_layers.py kernels.json --out layers.json
+"""
+
+import argparse
+import json
+import time
+
+import numpy as np
+
+import pytafast
+
+# Registry input names -> series, matching the C++ benchmark's binding
+# (real inputs take close, then high)
+_SERIES = {
+    "inOpen": "open", "inHigh": "high", "inLow": "low", "inClose": "close",
+    "inVolume": "volume", "inReal": "close", "inReal0": "close",
+    "inReal1": "high",
+}
+
+
+def _market(n, seed=42):
+    rng = np.random.default_rng(seed)
+    close = np.maximum(1.0, 100.0 + np.cumsum(rng.standard_normal(n)))
+    open_ = np.concatenate(([100.0], close[:-1]))
+    high = np.maximum(open_, close) + rng.random(n)
+    low = np.minimum(open_, close) - rng.random(n)
+    volume = 1000.0 + 1000.0 * rng.random(n)
+    return {"open": open_, "high": high, "low": low, "close": close,
+            "volume": volume}
+
+
+def _measure(call, min_time):
+    runs = []
+    deadline = time.perf_counter() + min_time
+    while len(runs) < 5 or time.perf_counter() < deadline:
+        start = time.perf_counter_ns()
+        call()
+        runs.append(time.perf_counter_ns() - start)
+    runs.sort()
+    return runs
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("kernels", help="JSON written by pytafast_bench")
+    parser.add_argument("--out", help="output file (default: stdout)")
+    parser.add_argument("--min-time", type=float, default=0.05)
+    args = parser.parse_args()
+
+    with open(args.kernels) as f:
+        report = json.load(f)
+    known = set(pytafast.function_names())
+    cases = sorted({(b["size"], b["name"]) for b in report["benchmarks"]
+                    if b["name"] in known})
+
+    market = {}
+    for size, name in cases:
+        if size not in market:
+            market = {size: _market(size)}  # one size at a time
+        fn = getattr(pytafast, name)
+        inputs = [market[size][_SERIES[i]]
+                  for i in pytafast.function_info(name)["inputs"]]
+        runs = _measure(lambda: fn(*inputs), args.min_time)
+        report["benchmarks"].append({
+            "name": name, "layer": "python", "size": size,
+            "iterations": len(runs), "min_ns": runs[0],
+            "median_ns": runs[len(runs) // 2],
+            "ns_per_element": round(runs[0] / size, 4),
+        })
+    report["benchmarks"].sort(key=lambda b: (b["name"], b["size"]))
+
+    if args.out:
+        with open(args.out, "w") as f:
+            json.dump(report, f, indent=2)
+    else:
+        print(json.dumps(report, indent=2))
+
+
+if __name__ == "__main__":
+    main()
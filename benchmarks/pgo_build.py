@@ -0,0 +1,230 @@
+"""
+Profile-guided build of pytafast.
+
+Builds and installs an instrumented pytafast (PYTAFAST_PGO=GENERATE), runs
+the training workload, then rebuilds in the same build directory with the
+recorded profiles (PYTAFAST_PGO=USE) and installs that:
+
+    uv run python benchmarks/pgo_build.py            # into the current env
+
+The training workload is the benchmark suite with timing disabled
+(tests/test_benchmark.py needs ta-lib-python, otherwise it is skipped;
+tests/test_benchmark_overhead.py) plus a sweep of every registered function
+at several sizes, so the profile weights the TA-Lib loops by how often
+real inputs take each branch.
+
+    uv run python benchmarks/pgo_build.py --compare
+
+first builds and times a plain build, then the PGO build, and prints the
+change per indicator group as a Markdown table (every registered function
+at MEASURE_SIZE bars, summed over the group) headed by the compiler and
+CPU. ``--out BENCHMARK_RESULTS.md`` appends the table to that file too.
+"""
+
+import argparse
+import glob
+import json
+import os
+import pathlib
+import platform
+import shutil
+import subprocess
+import sys
+import time
+
+ROOT = pathlib.Path(__file__).resolve().parent.parent
+SIZES = [100, 10_000, 1_000_000]
+MEASURE_SIZE = 100_000
+
+
+def _series(rng, n):
+    import numpy as np
+
+    close = np.maximum(1.0, 100.0 + np.cumsum(rng.standard_normal(n)))
+    open_ = np.concatenate(([100.0], close[:-1]))
+    return {
+        "inOpen": open_,
+        "inHigh": np.maximum(open_, close) + rng.random(n),
+        "inLow": np.minimum(open_, close) - rng.random(n),
+        "inClose": close,
+        "inVolume": 1000.0 + 1000.0 * rng.random(n),
+        "inReal": close,
+        "inReal0": close,
+        "inReal1": open_,
+    }
+
+
+def train():
+    """Every registered function on random-walk OHLCV, numpy and pandas."""
+    import numpy as np
+    import pandas as pd
+    import pytafast
+
+    rng = np.random.default_rng(42)
+    for n in SIZES:
+        series = _series(rng, n)
+        repeat = max(1, 100_000 // n)
+        for name in pytafast.function_names():
+            fn = getattr(pytafast, name)
+            inputs = [series[i] for i in pytafast.function_info(name)["inputs"]]
+            for _ in range(repeat):
+                fn(*inputs)
+            fn(*[pd.Series(x) for x in inputs])
+
+
+def measure(out, min_time=0.1):
+    """Best time of every registered function at MEASURE_SIZE, as JSON."""
+    import numpy as np
+    import pytafast
+
+    series = _series(np.random.default_rng(42), MEASURE_SIZE)
+    report = {}
+    for name in pytafast.function_names():
+        info = pytafast.function_info(name)
+        fn = getattr(pytafast, name)
+        inputs = [series[i] for i in info["inputs"]]
+        best = float("inf")
+        deadline = time.perf_counter() + min_time
+        runs = 0
+        while runs < 5 or time.perf_counter() < deadline:
+            start = time.perf_counter_ns()
+            fn(*inputs)
+            best = min(best, time.perf_counter_ns() - start)
+            runs += 1
+        report[name] = {"group": info["group"], "ns": best}
+    with open(out, "w") as f:
+        json.dump(report, f, indent=2)
+
+
+def _cpu():
+    try:
+        with open("/proc/cpuinfo") as f:
+            for line in f:
+                if line.startswith("model name"):
+                    return line.split(":", 1)[1].strip()
+    except OSError:
+        pass
+    return platform.processor() or platform.machine()
+
+
+def _compiler(build_dir):
+    """The C++ compiler CMake used for the PGO build, with its version."""
+    try:
+        with open(build_dir / "CMakeCache.txt") as f:
+            for line in f:
+                if line.startswith("CMAKE_CXX_COMPILER:"):
+                    path = line.split("=", 1)[1].strip()
+                    version = subprocess.run([path, "--version"],
+                                             capture_output=True, text=True)
+                    return version.stdout.splitlines()[0]
+    except (OSError, IndexError):
+        pass
+    return "unknown compiler"
+
+
+def _comparison(plain_file, pgo_file, build_dir):
+    """The per-group table as Markdown, headed by the compiler and CPU."""
+    with open(plain_file) as f:
+        plain = json.load(f)
+    with open(pgo_file) as f:
+        pgo = json.load(f)
+    groups = {}
+    for name, entry in plain.items():
+        if name in pgo:
+            totals = groups.setdefault(entry["group"], [0, 0, 0])
+            totals[0] += 1
+            totals[1] += entry["ns"]
+            totals[2] += pgo[name]["ns"]
+    lines = [
+        f"### PGO, {time.strftime('%Y-%m-%d')}",
+        "",
+        f"{_compiler(build_dir)} on {_cpu()} ({platform.system()}, "
+        f"Python {platform.python_version()}); best of at least 5 runs at "
+        f"{MEASURE_SIZE:,} bars, summed per group.",
+        "",
+        "| Group | Functions | Plain (us) | PGO (us) | Change |",
+        "|---|---:|---:|---:|---:|",
+    ]
+    for group, (count, before, after) in sorted(groups.items()):
+        lines.append(f"| {group} | {count} | {before / 1e3:.1f} | "
+                     f"{after / 1e3:.1f} | {(after / before - 1) * 100:+.1f}% |")
+    return "\n".join(lines) + "\n"
+
+
+def _pip_install(build_dir, stage, profile_dir):
+    subprocess.check_call([
+        sys.executable, "-m", "pip", "install", "--force-reinstall", "--no-deps",
+        str(ROOT),
+        "-C", f"build-dir={build_dir}",
+        "-C", f"cmake.define.PYTAFAST_PGO={stage}",
+        "-C", f"cmake.define.PYTAFAST_PGO_DIR={profile_dir}",
+    ])
+
+
+def _merge_clang_profiles(profile_dir):
+    raw = glob.glob(str(profile_dir / "*.profraw"))
+    if not raw:
+        return  # GCC: .gcda files are read in place
+    tool = shutil.which("llvm-profdata")
+    if tool is None:
+        sys.exit("Clang profiles need llvm-profdata on PATH to merge")
+    subprocess.check_call([tool, "merge", "-o",
+                           str(profile_dir / "pytafast.profdata"), *raw])
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("--build-dir", default=str(ROOT / "build" / "pgo"))
+    parser.add_argument("--train", action="store_true",
+                        help="only run the training sweep in this interpreter")
+    parser.add_argument("--measure", metavar="FILE",
+                        help="only time the installed build into FILE")
+    parser.add_argument("--compare", action="store_true",
+                        help="time a plain build first, then the PGO build, "
+                             "and print the change per indicator group")
+    parser.add_argument("--out", metavar="FILE",
+                        help="with --compare, also append the table to FILE "
+                             "(e.g. BENCHMARK_RESULTS.md)")
+    args = parser.parse_args()
+    if args.train:
+        train()
+        return
+    if args.measure:
+        measure(args.measure)
+        return
+
+    build_dir = pathlib.Path(args.build_dir).resolve()
+    if args.compare:
+        build_dir.mkdir(parents=True, exist_ok=True)
+        _pip_install(build_dir.parent / "plain", "OFF", build_dir / "profile")
+        subprocess.check_call([sys.executable, __file__, "--measure",
+                               str(build_dir / "plain.json")])
+    profile_dir = build_dir / "profile"
+    shutil.rmtree(profile_dir, ignore_errors=True)
+    profile_dir.mkdir(parents=True)
+
+    _pip_install(build_dir, "GENERATE", profile_dir)
+    # Fresh interpreters, so the instrumented module flushes its profile on exit
+    env = dict(os.environ, LLVM_PROFILE_FILE=str(profile_dir / "%p.profraw"))
+    subprocess.check_call([sys.executable, __file__, "--train"], env=env)
+    subprocess.call([
+        sys.executable, "-m", "pytest", "-q", "--benchmark-disable",
+        str(ROOT / "tests" / "test_benchmark.py"),
+        str(ROOT / "tests" / "test_benchmark_overhead.py"),
+    ], cwd=ROOT, env=env)
+    _merge_clang_profiles(profile_dir)
+
+    _pip_install(build_dir, "USE", profile_dir)
+    if args.compare:
+        subprocess.check_call([sys.executable, __file__, "--measure",
+                               str(build_dir / "pgo.json")])
+        table = _comparison(build_dir / "plain.json", build_dir / "pgo.json",
+                            build_dir)
+        print(table, end="")
+        if args.out:
+            with open(args.out, "a") as f:
+                f.write("\n" + table)
+
+
+if __name__ == "__main__":
+    main()
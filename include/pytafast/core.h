@@ -0,0 +1,315 @@
+#pragma once
+// pytafast_core - the TA-Lib layer of pytafast as a plain C++ library: the
+// function table with its metadata and lookbacks, and every function run
+// over caller-owned buffers. No Python; the pytafast extension module is a
+// binding layer on top of it.
+//
+//   #include <pytafast/core.h>
+//
+//   pytafast::initialize();
+//   const pytafast::FunctionInfo &rsi = pytafast::find_function("RSI");
+//   std::vector<double> out(close.size());
+//   pytafast::compute(rsi, {close}, {14}, {out});
+//
+// Three ways to run a function:
+//   compute       one series
+//   compute_many  many equal-length series stored row after row, spread
+//                 over threads
+//   Stream        one bar at a time
+// HilbertStream runs HT_ALL one bar at a time on its recursive state, and
+// CandleStream any set of candlestick patterns.
+// Outputs cover every input bar: bars before the lookback are NaN (0 for
+// integer outputs), as in Python. Inputs and outputs are in the order of
+// FunctionInfo::inputs / outputs, parameters in the order of
+// FunctionInfo::params; trailing parameters left out take their defaults.
+//
+// Bad arguments (unknown function, wrong number of inputs, lengths that do
+// not match) throw std::invalid_argument; a failing TA-Lib call throws
+// pytafast::Error.
+//
+// Built with CMake as the pytafast_core target; installed, it is
+//   find_package(pytafast CONFIG REQUIRED)
+//   target_link_libraries(app PRIVATE pytafast::core)
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pytafast {
+
+// A contiguous range of T (std::span is C++20; pytafast builds as C++17).
+// Converts from anything with data() and size() - std::vector, std::array,
+// a span of non-const T - from a C array and, for const T, from a braced
+// list of values.
+template <typename T> class span {
+public:
+  constexpr span() noexcept = default;
+  constexpr span(T *data, size_t size) noexcept : data_(data), size_(size) {}
+
+  template <typename C,
+            typename = std::enable_if_t<std::is_convertible_v<
+                decltype(std::declval<C &>().data()), T *>>>
+  constexpr span(C &&c) noexcept : data_(c.data()), size_(c.size()) {}
+
+  template <typename U, size_t N,
+            typename = std::enable_if_t<
+                std::is_convertible_v<U (*)[], T (*)[]>>>
+  constexpr span(U (&array)[N]) noexcept : data_(array), size_(N) {}
+
+  // Only lives until the end of the full expression: for arguments
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Winit-list-lifetime"
+#endif
+  template <typename U = T, typename = std::enable_if_t<std::is_const_v<U>>>
+  constexpr span(std::initializer_list<std::remove_const_t<T>> list) noexcept
+      : data_(list.begin()), size_(list.size()) {}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+  constexpr T *data() const noexcept { return data_; }
+  constexpr size_t size() const noexcept { return size_; }
+  constexpr bool empty() const noexcept { return size_ == 0; }
+  constexpr T &operator[](size_t i) const noexcept { return data_[i]; }
+  constexpr T *begin() const noexcept { return data_; }
+  constexpr T *end() const noexcept { return data_ + size_; }
+
+private:
+  T *data_ = nullptr;
+  size_t size_ = 0;
+};
+
+// A TA-Lib function returned something other than TA_SUCCESS
+class Error : public std::runtime_error {
+public:
+  Error(const std::string &what, int code)
+      : std::runtime_error(what), code_(code) {}
+  // The TA_RetCode
+  int code() const noexcept { return code_; }
+
+private:
+  int code_;
+};
+
+// Throws Error("<what> failed with TA_RetCode: <code>") unless code is
+// TA_SUCCESS
+void check_retcode(int code, const char *what);
+
+// TA-Lib's context (TA_Initialize / TA_Shutdown) is process-wide and
+// shared by every user of the library - the Python module, plugins, the
+// application. Each user calls initialize() before its first call and
+// shutdown() once done with it; the context is set up by the first
+// initialize() and torn down by the last shutdown()
+void initialize();
+void shutdown();
+
+// --- Function table ---
+
+enum class ParamType { Int, Real, MAType };
+
+struct ParamInfo {
+  const char *name;
+  ParamType type;
+  double default_value;
+};
+
+// Runs a function over bars [0, size) of `inputs`. `outputs` are double* or,
+// for integer functions, int*, each with room for `size` values; the
+// function writes from bar `lookback` on (its lookback for `params`) and
+// returns a TA_RetCode.
+using ComputeFn = int (*)(int size, int lookback, const double *const *inputs,
+                          const double *params, void *const *outputs);
+
+struct FunctionInfo {
+  const char *name;
+  const char *group;
+  // Public names: inReal, inHigh, ..., and real, macd, ...
+  std::vector<const char *> inputs;
+  std::vector<const char *> outputs;
+  bool integer_output;
+  std::vector<ParamInfo> params;
+  // Leading bars without output for the given parameter values, one per
+  // entry of `params` in order. Multi-output functions report the longest.
+  int (*lookback)(const double *params);
+  ComputeFn compute;
+  // Output at bar i depends only on bars [i - lookback, i] - no recursive
+  // state - so a tail can be computed from the bars just before it
+  bool windowed = false;
+};
+
+const std::vector<FunctionInfo> &function_table();
+
+// Case-insensitive; throws std::invalid_argument for an unknown name
+const FunctionInfo &find_function(const std::string &name);
+// The same, null for an unknown name
+const FunctionInfo *lookup_function(const std::string &name);
+
+// --- Functions added at run time ---
+
+// Adds `fn` to the functions find_function / lookup_function know, under
+// the same rules as the table. Everything `fn` points to must outlive the
+// process. Throws std::invalid_argument if its name is taken or it lacks
+// inputs, outputs, lookback or compute.
+const FunctionInfo &register_function(FunctionInfo fn);
+
+// Registered functions, in registration order
+std::vector<const FunctionInfo *> registered_functions();
+
+// Loads a native plugin (pytafast/plugin.h) and registers its functions,
+// which it returns. The library stays loaded; loading it again returns the
+// same functions.
+std::vector<const FunctionInfo *> load_plugin(const std::string &path);
+
+// `params` completed with the defaults of the parameters left out
+std::vector<double> resolve_params(const FunctionInfo &fn,
+                                   span<const double> params);
+
+int lookback(const FunctionInfo &fn, span<const double> params = {});
+
+// --- One series ---
+
+// Every output holds as many values as each input
+void compute(const FunctionInfo &fn, span<const span<const double>> inputs,
+             span<const double> params, span<const span<double>> outputs);
+// For integer functions (candlestick patterns, HT_TRENDMODE, MINMAXINDEX)
+void compute(const FunctionInfo &fn, span<const span<const double>> inputs,
+             span<const double> params, span<const span<int>> outputs);
+
+// --- Many series ---
+
+// `count` series of `size` bars each. inputs[j] and outputs[k] are
+// (count, size) row-major blocks: series s is at offset s * size. The
+// series are split over `threads` threads (0: one per hardware thread).
+void compute_many(const FunctionInfo &fn, size_t count, size_t size,
+                  span<const double *const> inputs, span<const double> params,
+                  span<double *const> outputs, unsigned threads = 0);
+void compute_many(const FunctionInfo &fn, size_t count, size_t size,
+                  span<const double *const> inputs, span<const double> params,
+                  span<int *const> outputs, unsigned threads = 0);
+
+// --- One bar at a time ---
+
+// Feeds bars to a function and returns each bar's outputs as they come.
+// Windowed functions keep their last lookback + 1 bars and give exactly
+// the values a batch run over the whole series would. Recursive ones (EMA,
+// RSI, ADX, ...) keep every bar unless max_history is set, in which case
+// each value is that of a run over the last max_history bars - the same
+// trade-off as fetching lookback plus extra history in Python.
+// An update costs one run over the kept bars.
+class Stream {
+public:
+  explicit Stream(const FunctionInfo &fn, span<const double> params = {},
+                  size_t max_history = 0);
+
+  // Adds a bar, one value per input. Once past the lookback, writes one
+  // value per output to `out` (integer outputs converted) and returns true.
+  bool update(span<const double> bar, span<double> out);
+
+  // Drops every bar
+  void reset();
+
+  const FunctionInfo &function() const { return *fn_; }
+  int lookback() const { return lookback_; }
+  // Bars added since construction or the last reset
+  size_t bars() const { return bars_; }
+
+private:
+  const FunctionInfo *fn_;
+  std::vector<double> params_;
+  int lookback_;
+  size_t history_; // 0: unbounded
+  size_t bars_ = 0;
+  size_t begin_ = 0; // first kept bar in each of inputs_
+  std::vector<std::vector<double>> inputs_;
+  std::vector<const double *> in_ptrs_;
+  std::vector<void *> out_ptrs_;
+  std::vector<std::vector<double>> real_out_;
+  std::vector<std::vector<int>> int_out_;
+};
+
+class HilbertTransform;
+
+// HT_ALL (HT_DCPERIOD, HT_DCPHASE, HT_PHASOR, HT_SINE, HT_TRENDLINE and
+// HT_TRENDMODE) one bar at a time. Keeps the Hilbert transform's state
+// rather than the bars, so an update costs the same whatever the history,
+// and gives exactly the values of a batch run over the whole series.
+class HilbertStream {
+public:
+  static constexpr size_t kOutputs = 8;
+
+  HilbertStream();
+  ~HilbertStream();
+  HilbertStream(HilbertStream &&) noexcept;
+  HilbertStream &operator=(HilbertStream &&) noexcept;
+
+  // Adds a bar. Writes the kOutputs outputs, in HT_ALL's order, to `out` -
+  // NaN for those still within their lookback - and returns true once past
+  // every lookback.
+  bool update(double value, span<double> out);
+
+  // Drops the state, as if no bar had been added
+  void reset();
+
+  int lookback() const { return lookback_; }
+  // Bars added since construction or the last reset
+  size_t bars() const;
+
+private:
+  std::unique_ptr<HilbertTransform> state_;
+  int lookbacks_[kOutputs];
+  int lookback_;
+};
+
+// Candlestick patterns (group "Pattern Recognition") one bar at a time:
+// any subset of them, each bar's signals for all of them in one update.
+// Keeps the last bars in a ring as long as the longest selected lookback
+// needs. An update reruns each pattern's TA-Lib function over its own
+// lookback + 1 bars - TA-Lib's candle-setting averages and the pattern's
+// candles - so the signals are those of a batch run. This is a windowed
+// recomputation, not an incremental recognizer: no running candle-setting
+// sums are kept, and a bar costs in proportion to the sum of the selected
+// patterns' lookbacks, however long the history.
+class CandleStream {
+public:
+  // `patterns` by name; empty for every pattern in the function table.
+  // Patterns that take a penetration use `penetration` when given, their
+  // own default otherwise. Throws std::invalid_argument for a name that is
+  // not a pattern.
+  explicit CandleStream(span<const std::string> patterns = {});
+  CandleStream(span<const std::string> patterns, double penetration);
+
+  // Adds a bar and writes one signal per pattern to `out`, in the order of
+  // patterns(): 0 while the pattern is within its lookback
+  void update(double open, double high, double low, double close,
+              span<int> out);
+
+  // Drops every bar
+  void reset();
+
+  const std::vector<const FunctionInfo *> &patterns() const {
+    return patterns_;
+  }
+  // Bars added since construction or the last reset
+  size_t bars() const { return bars_; }
+
+private:
+  void init(span<const std::string> patterns, const double *penetration);
+
+  std::vector<const FunctionInfo *> patterns_;
+  std::vector<std::vector<double>> params_;
+  std::vector<int> lookbacks_;
+  size_t capacity_ = 0; // bars kept
+  size_t head_ = 0;     // slot of the next bar
+  size_t bars_ = 0;
+  // Open, high, low, close, each bar stored at its slot and at slot +
+  // capacity_ so that the last bars are always contiguous
+  std::vector<double> ring_[4];
+  std::vector<int> signal_;
+};
+
+} // namespace pytafast
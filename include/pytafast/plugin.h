@@ -0,0 +1,101 @@
+#pragma once
+/* Native indicator plugins - the C ABI.
+ *
+ * A plugin is a shared library that exports pytafast_plugin_entry(),
+ * returning a table of functions. pytafast::load_plugin (C++) or
+ * pytafast.load_plugin (Python) registers them next to the TA-Lib
+ * functions: they are found by name, listed by function_names(), and run by
+ * compute / compute_many / Stream and by the Python wrappers (pandas,
+ * nan_policy, the result cache, layout=, pytafast.aio, SharedMemoryEngine).
+ *
+ *   static const char *const inputs[] = {"inHigh", "inLow"};
+ *   static const char *const outputs[] = {"real"};
+ *   static const pytafast_param params[] = {
+ *       {"timeperiod", PYTAFAST_PARAM_INT, 10}};
+ *
+ *   static int range_lookback(const double *params) {
+ *     return (int)params[0] - 1;
+ *   }
+ *   static int range_compute(int size, int lookback,
+ *                            const double *const *in, const double *params,
+ *                            void *const *out) { ... }
+ *
+ *   static const pytafast_function functions[] = {
+ *       {"RANGE", "Custom", 2, inputs, 1, outputs, 0, 1, params,
+ *        range_lookback, range_compute, 1}};
+ *   static const pytafast_plugin plugin = {PYTAFAST_PLUGIN_ABI, 1,
+ *                                          functions};
+ *
+ *   PYTAFAST_PLUGIN_EXPORT const pytafast_plugin *pytafast_plugin_entry(void) {
+ *     return &plugin;
+ *   }
+ *
+ * The declaration below gives the entry point C linkage in C++ plugins
+ * too. The library is never unloaded, and the table and everything it
+ * points to must stay as they are. compute is called from several threads
+ * at once (the GIL is released), so it must not keep state between calls.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Bumped whenever the structs below change layout */
+#define PYTAFAST_PLUGIN_ABI 1
+
+/* pytafast_param.type; MATYPE parameters take a pytafast.MAType */
+enum { PYTAFAST_PARAM_INT, PYTAFAST_PARAM_REAL, PYTAFAST_PARAM_MATYPE };
+
+typedef struct pytafast_param {
+  const char *name;
+  int type;
+  double default_value;
+} pytafast_param;
+
+typedef struct pytafast_function {
+  /* Public name (pytafast.<name>), unique across all functions */
+  const char *name;
+  const char *group;
+  /* Input and output names, as in function_info(): inReal, inHigh, ...,
+   * real, upper, ... */
+  int n_inputs;
+  const char *const *inputs;
+  int n_outputs;
+  const char *const *outputs;
+  /* Nonzero: outputs are int (patterns, flags), else double */
+  int integer_output;
+  int n_params;
+  const pytafast_param *params;
+  /* Leading bars without output, for one value per parameter in order */
+  int (*lookback)(const double *params);
+  /* Writes bars [lookback, size) of every output; the bars before it are
+   * filled by pytafast. Returns 0, or an error code (reported as
+   * "<name> failed with TA_RetCode: <code>"). */
+  int (*compute)(int size, int lookback, const double *const *inputs,
+                 const double *params, void *const *outputs);
+  /* Nonzero if the output at bar i only depends on bars [i - lookback, i]
+   * (no recursive state): cached results are then extended bar by bar and
+   * streams keep lookback + 1 bars */
+  int windowed;
+} pytafast_function;
+
+typedef struct pytafast_plugin {
+  int abi_version; /* PYTAFAST_PLUGIN_ABI */
+  int n_functions;
+  const pytafast_function *functions;
+} pytafast_plugin;
+
+#if defined(_WIN32)
+#define PYTAFAST_PLUGIN_EXPORT __declspec(dllexport)
+#else
+#define PYTAFAST_PLUGIN_EXPORT __attribute__((visibility("default")))
+#endif
+
+/* The symbol every plugin exports */
+#define PYTAFAST_PLUGIN_ENTRY "pytafast_plugin_entry"
+typedef const pytafast_plugin *(*pytafast_plugin_entry_fn)(void);
+PYTAFAST_PLUGIN_EXPORT const pytafast_plugin *pytafast_plugin_entry(void);
+
+#ifdef __cplusplus
+}
+#endif
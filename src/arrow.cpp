@@ -0,0 +1,186 @@
+#include "arrow.h"
+#include <memory>
+
+namespace {
+
+template <typename T> T *capsule_pointer(nb::handle capsule, const char *name) {
+  void *p = PyCapsule_GetPointer(capsule.ptr(), name);
+  if (!p) throw nb::python_error();
+  return static_cast<T *>(p);
+}
+
+// Owning pointer to an imported ArrowArray moved out of its capsule
+struct ReleaseArrowArray {
+  void operator()(ArrowArray *array) const noexcept {
+    if (array->release) array->release(array);
+    delete array;
+  }
+};
+using ArrowArrayPtr = std::unique_ptr<ArrowArray, ReleaseArrowArray>;
+
+// Consumers take ownership by copying the struct and marking the source
+// released, so the capsule destructor leaves it alone
+ArrowArrayPtr take_array(ArrowArray *source) {
+  ArrowArrayPtr array(new ArrowArray(*source));
+  source->release = nullptr;
+  return array;
+}
+
+void check_primitive(const ArrowArray &array) {
+  if (array.n_children != 0 || array.dictionary || array.n_buffers != 2)
+    throw std::invalid_argument(
+        "Arrow input must be a primitive numeric array");
+}
+
+template <typename T> void convert_chunk(const ArrowArray &array, double *out) {
+  const T *values = static_cast<const T *>(array.buffers[1]) + array.offset;
+  const auto *validity = static_cast<const uint8_t *>(array.buffers[0]);
+  for (int64_t i = 0; i < array.length; ++i) {
+    const int64_t bit = array.offset + i;
+    const bool valid = !validity || ((validity[bit >> 3] >> (bit & 7)) & 1);
+    out[i] = valid ? static_cast<double>(values[i]) : NaN;
+  }
+}
+
+void convert_chunk(const std::string &format, const ArrowArray &array,
+                   double *out) {
+  if (format == "g") return convert_chunk<double>(array, out);
+  if (format == "f") return convert_chunk<float>(array, out);
+  if (format == "c") return convert_chunk<int8_t>(array, out);
+  if (format == "C") return convert_chunk<uint8_t>(array, out);
+  if (format == "s") return convert_chunk<int16_t>(array, out);
+  if (format == "S") return convert_chunk<uint16_t>(array, out);
+  if (format == "i") return convert_chunk<int32_t>(array, out);
+  if (format == "I") return convert_chunk<uint32_t>(array, out);
+  if (format == "l") return convert_chunk<int64_t>(array, out);
+  if (format == "L") return convert_chunk<uint64_t>(array, out);
+  throw std::invalid_argument("unsupported Arrow type '" + format +
+                              "', expected a numeric array");
+}
+
+DoubleArrayIN from_chunks(const std::string &format,
+                          std::vector<ArrowArrayPtr> chunks) {
+  for (const auto &chunk : chunks) check_primitive(*chunk);
+
+  // A null_count of -1 means "unknown", so only trust an explicit 0 or a
+  // missing validity buffer
+  if (chunks.size() == 1 && format == "g" &&
+      (chunks[0]->null_count == 0 || !chunks[0]->buffers[0])) {
+    ArrowArray *array = chunks[0].release();
+    const double *data =
+        array->length == 0
+            ? nullptr
+            : static_cast<const double *>(array->buffers[1]) + array->offset;
+    nb::capsule owner(array, [](void *p) noexcept {
+      ReleaseArrowArray()(static_cast<ArrowArray *>(p));
+    });
+    return DoubleArrayIN(data, {static_cast<size_t>(array->length)}, owner);
+  }
+
+  size_t size = 0;
+  for (const auto &chunk : chunks) size += chunk->length;
+  auto [data, owner] = alloc_output(size, 0);
+  double *out = data;
+  for (const auto &chunk : chunks) {
+    convert_chunk(format, *chunk, out);
+    out += chunk->length;
+  }
+  return DoubleArrayIN(data, {size}, owner);
+}
+
+void release_exported_schema(ArrowSchema *schema) { schema->release = nullptr; }
+
+// Keeps the result buffer alive for as long as the consumer holds the array
+struct ExportedArray {
+  DoubleArrayIN values;
+  std::vector<uint8_t> validity;
+  const void *buffers[2];
+};
+
+void release_exported_array(ArrowArray *array) {
+  {
+    nb::gil_scoped_acquire acquire;
+    delete static_cast<ExportedArray *>(array->private_data);
+  }
+  array->release = nullptr;
+}
+
+} // namespace
+
+DoubleArrayIN import_arrow_array(nb::handle obj) {
+  nb::tuple capsules = nb::borrow<nb::tuple>(obj.attr("__arrow_c_array__")());
+  auto *schema = capsule_pointer<ArrowSchema>(capsules[0], "arrow_schema");
+  auto *array = capsule_pointer<ArrowArray>(capsules[1], "arrow_array");
+  std::vector<ArrowArrayPtr> chunks;
+  chunks.push_back(take_array(array));
+  return from_chunks(schema->format, std::move(chunks));
+}
+
+DoubleArrayIN import_arrow_stream(nb::handle obj) {
+  nb::object capsule = obj.attr("__arrow_c_stream__")();
+  auto *stream =
+      capsule_pointer<ArrowArrayStream>(capsule, "arrow_array_stream");
+  auto check = [stream](int code) {
+    if (code != 0) {
+      const char *error = stream->get_last_error(stream);
+      throw std::runtime_error(std::string("Arrow stream error: ") +
+                               (error ? error : std::to_string(code)));
+    }
+  };
+
+  ArrowSchema schema;
+  check(stream->get_schema(stream, &schema));
+  std::string format = schema.format;
+  schema.release(&schema);
+
+  std::vector<ArrowArrayPtr> chunks;
+  for (;;) {
+    ArrowArray chunk;
+    check(stream->get_next(stream, &chunk));
+    if (!chunk.release) break;
+    chunks.push_back(take_array(&chunk));
+  }
+  return from_chunks(format, std::move(chunks));
+}
+
+ArrowResult::ArrowResult(DoubleArrayIN values)
+    : values_(values), null_count_(0) {
+  const double *data = values_.data();
+  while (null_count_ < size() && std::isnan(data[null_count_])) ++null_count_;
+}
+
+nb::tuple ArrowResult::arrow_c_array(nb::handle) const {
+  auto *schema = new ArrowSchema{};
+  schema->format = "g";
+  schema->name = "";
+  schema->flags = ARROW_FLAG_NULLABLE;
+  schema->release = release_exported_schema;
+  nb::capsule schema_capsule(schema, "arrow_schema", [](void *p) noexcept {
+    auto *s = static_cast<ArrowSchema *>(p);
+    if (s->release) s->release(s);
+    delete s;
+  });
+
+  auto *exported = new ExportedArray{values_, {}, {nullptr, values_.data()}};
+  if (null_count_ > 0) {
+    // LSB-first bitmap, 1 = valid
+    exported->validity.assign((size() + 7) / 8, 0xFF);
+    for (size_t i = 0; i < null_count_; ++i)
+      exported->validity[i >> 3] &= static_cast<uint8_t>(~(1u << (i & 7)));
+    exported->buffers[0] = exported->validity.data();
+  }
+  auto *array = new ArrowArray{};
+  array->length = static_cast<int64_t>(size());
+  array->null_count = static_cast<int64_t>(null_count_);
+  array->n_buffers = 2;
+  array->buffers = exported->buffers;
+  array->release = release_exported_array;
+  array->private_data = exported;
+  nb::capsule array_capsule(array, "arrow_array", [](void *p) noexcept {
+    auto *a = static_cast<ArrowArray *>(p);
+    if (a->release) a->release(a);
+    delete a;
+  });
+
+  return nb::make_tuple(schema_capsule, array_capsule);
+}
@@ -0,0 +1,32 @@
+#pragma once
+// Arrow C Data Interface support: zero-copy import of Arrow arrays and
+// streams exposed through the PyCapsule protocol (__arrow_c_array__ /
+// __arrow_c_stream__), and export of float64 results with a validity bitmap.
+#include "arrow_abi.h"
+#include "common.h"
+#include <cstdint>
+
+// Import a 1-D numeric Arrow array (obj.__arrow_c_array__()) or stream
+// (obj.__arrow_c_stream__()) as float64. A single float64 chunk without
+// nulls is used in place; anything else is converted with nulls -> NaN.
+DoubleArrayIN import_arrow_array(nb::handle obj);
+DoubleArrayIN import_arrow_stream(nb::handle obj);
+
+// A float64 result exported as an Arrow array sharing the result's buffer.
+// The leading NaN run (the lookback region) is marked null in the validity
+// bitmap; NaNs after it are ordinary values.
+class ArrowResult {
+public:
+  explicit ArrowResult(DoubleArrayIN values);
+
+  // PyCapsule protocol; requested_schema is ignored (always float64)
+  nb::tuple arrow_c_array(nb::handle requested_schema) const;
+
+  size_t size() const { return values_.shape(0); }
+  size_t null_count() const { return null_count_; }
+  DoubleArrayIN values() const { return values_; }
+
+private:
+  DoubleArrayIN values_;
+  size_t null_count_;
+};
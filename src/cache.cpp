@@ -0,0 +1,347 @@
+#include "cache.h"
+#include <cstring>
+
+namespace {
+
+constexpr uint64_t P1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t P2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t P3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t P4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t P5 = 0x27D4EB2F165667C5ULL;
+
+inline uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+inline uint64_t read64(const unsigned char *p) {
+  uint64_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+inline uint64_t mix_round(uint64_t acc, uint64_t input) {
+  return rotl(acc + input * P2, 31) * P1;
+}
+
+inline uint64_t merge_round(uint64_t acc, uint64_t val) {
+  return (acc ^ mix_round(0, val)) * P1 + P4;
+}
+
+inline uint64_t combine(uint64_t h, uint64_t v) {
+  return rotl(h ^ mix_round(0, v), 27) * P1 + P4;
+}
+
+using DoubleResult =
+    nb::ndarray<nb::numpy, const double, nb::c_contig, nb::ndim<1>>;
+using IntResult = nb::ndarray<nb::numpy, const int, nb::c_contig, nb::ndim<1>>;
+
+uint64_t hash_call(const CallKey &key) {
+  uint64_t h = key.salt;
+  if (key.info) h = hash_bytes(key.info->name, std::strlen(key.info->name), h);
+  return hash_bytes(key.params.data(), key.params.size() * sizeof(double), h);
+}
+
+} // namespace
+
+uint64_t hash_bytes(const void *data, size_t size, uint64_t seed) {
+  auto *p = static_cast<const unsigned char *>(data);
+  const unsigned char *end = p + size;
+  uint64_t h;
+  if (size >= 32) {
+    // Four independent lanes keep the multiplier pipelines busy
+    uint64_t v1 = seed + P1 + P2, v2 = seed + P2, v3 = seed, v4 = seed - P1;
+    for (; p + 32 <= end; p += 32) {
+      v1 = mix_round(v1, read64(p));
+      v2 = mix_round(v2, read64(p + 8));
+      v3 = mix_round(v3, read64(p + 16));
+      v4 = mix_round(v4, read64(p + 24));
+    }
+    h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+    h = merge_round(h, v1);
+    h = merge_round(h, v2);
+    h = merge_round(h, v3);
+    h = merge_round(h, v4);
+  } else {
+    h = seed + P5;
+  }
+  h += size;
+  for (; p + 8 <= end; p += 8) h = rotl(h ^ mix_round(0, read64(p)), 27) * P1 + P4;
+  for (; p < end; ++p) h = rotl(h ^ (*p * P5), 11) * P1;
+  h ^= h >> 33;
+  h *= P2;
+  h ^= h >> 29;
+  h *= P3;
+  h ^= h >> 32;
+  return h;
+}
+
+std::atomic<bool> ResultCache::enabled_{false};
+
+ResultCache &ResultCache::instance() {
+  // Deliberately leaked: entries hold Python objects, which must not be
+  // released after the interpreter is gone
+  static ResultCache *cache = new ResultCache();
+  return *cache;
+}
+
+void ResultCache::configure(size_t max_bytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  max_bytes_ = max_bytes;
+  evict(max_bytes);
+  enabled_.store(max_bytes > 0, std::memory_order_relaxed);
+}
+
+void ResultCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  evict(0);
+  hits_ = tail_hits_ = misses_ = 0;
+}
+
+nb::dict ResultCache::info() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  nb::dict info;
+  info["enabled"] = enabled();
+  info["max_bytes"] = max_bytes_;
+  info["bytes"] = bytes_;
+  info["entries"] = lru_.size();
+  info["hits"] = hits_;
+  info["tail_hits"] = tail_hits_;
+  info["misses"] = misses_;
+  return info;
+}
+
+bool ResultCache::split(nb::handle result, bool &tuple,
+                        std::vector<Output> &outputs) {
+  tuple = nb::isinstance<nb::tuple>(result);
+  nb::tuple columns =
+      tuple ? nb::borrow<nb::tuple>(result) : nb::make_tuple(result);
+  for (nb::handle column : columns) {
+    DoubleResult real;
+    IntResult integer;
+    if (nb::try_cast(column, real, false))
+      outputs.push_back({false, real.data(), real.shape(0), nb::borrow(column)});
+    else if (nb::try_cast(column, integer, false))
+      outputs.push_back(
+          {true, integer.data(), integer.shape(0), nb::borrow(column)});
+    else
+      return false; // 2-D layouts are computed but not cached
+  }
+  return true;
+}
+
+nb::object ResultCache::views(bool tuple, const std::vector<Output> &outputs) {
+  nb::list outs;
+  for (const auto &out : outputs) {
+    if (out.integer)
+      outs.append(IntResult(out.data, {out.size}, out.owner));
+    else
+      outs.append(DoubleResult(out.data, {out.size}, out.owner));
+  }
+  if (tuple) return nb::tuple(outs);
+  return outs[0];
+}
+
+bool ResultCache::matches(const Entry &entry, const CallKey &key,
+                          const std::vector<uint64_t> &hashes,
+                          const std::vector<uint64_t> &checks) {
+  const CallKey &call = entry.call;
+  return call.info == key.info && call.salt == key.salt &&
+         call.appendable == key.appendable &&
+         call.params.size() == key.params.size() &&
+         std::memcmp(call.params.data(), key.params.data(),
+                     key.params.size() * sizeof(double)) == 0 &&
+         entry.input_hashes == hashes && entry.input_checks == checks;
+}
+
+nb::object ResultCache::call(
+    const CallKey &key, const NanInputs &inputs,
+    const std::function<nb::object(const NanInputs &)> &kernel) {
+  size_t size = inputs.empty() ? 0 : inputs[0].shape(0);
+  for (const auto &in : inputs)
+    if (in.shape(0) != size)
+      throw std::runtime_error("Input lengths must match");
+
+  Entry entry{0,
+              0,
+              size,
+              key,
+              std::vector<uint64_t>(inputs.size()),
+              std::vector<uint64_t>(inputs.size()),
+              false,
+              {},
+              0};
+  uint64_t call_hash = hash_call(key);
+  {
+    nb::gil_scoped_release release;
+    entry.key = call_hash;
+    for (size_t j = 0; j < inputs.size(); ++j) {
+      entry.input_hashes[j] =
+          hash_bytes(inputs[j].data(), size * sizeof(double));
+      entry.input_checks[j] =
+          hash_bytes(inputs[j].data(), size * sizeof(double), kCheckSeed);
+      entry.key = combine(entry.key, entry.input_hashes[j]);
+    }
+    if (size >= kHeadBars) {
+      entry.head = call_hash;
+      for (const auto &in : inputs)
+        entry.head = combine(entry.head,
+                             hash_bytes(in.data(), kHeadBars * sizeof(double)));
+    }
+  }
+
+  // The longest cached call whose inputs these extend
+  Entry prefix{0, 0, 0, {}, {}, {}, false, {}, 0};
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto hit = by_key_.find(entry.key);
+    if (hit != by_key_.end() && hit->second->size == size &&
+        matches(*hit->second, key, entry.input_hashes, entry.input_checks)) {
+      lru_.splice(lru_.begin(), lru_, hit->second);
+      ++hits_;
+      return views(hit->second->tuple, hit->second->outputs);
+    }
+    if (entry.head && key.appendable && key.info && key.info->windowed) {
+      auto [first, last] = by_head_.equal_range(entry.head);
+      for (auto it = first; it != last; ++it)
+        if (it->second->size < size && it->second->size > prefix.size)
+          prefix = *it->second;
+    }
+  }
+
+  nb::object result;
+  if (prefix.size) result = append(key, inputs, prefix, kernel);
+  bool tail = result.is_valid();
+  if (!tail) result = kernel(inputs);
+
+  if (!split(result, entry.tuple, entry.outputs)) return result;
+  for (const auto &out : entry.outputs)
+    entry.bytes += out.size * (out.integer ? sizeof(int) : sizeof(double));
+  nb::object out = views(entry.tuple, entry.outputs);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  ++(tail ? tail_hits_ : misses_);
+  if (entry.bytes <= max_bytes_ && !by_key_.count(entry.key))
+    insert(std::move(entry));
+  return out;
+}
+
+nb::object ResultCache::append(
+    const CallKey &key, const NanInputs &inputs, const Entry &prefix,
+    const std::function<nb::object(const NanInputs &)> &kernel) {
+  if (key.params.size() != key.info->params.size()) return nb::object();
+  size_t lookback =
+      static_cast<size_t>(std::max(key.info->lookback(key.params.data()), 0));
+  if (prefix.size <= lookback) return nb::object();
+
+  // The head hash only covers kHeadBars: check the whole prefix, under
+  // both hashes, and the call itself
+  std::vector<uint64_t> hashes(inputs.size()), checks(inputs.size());
+  {
+    nb::gil_scoped_release release;
+    for (size_t j = 0; j < inputs.size(); ++j) {
+      hashes[j] = hash_bytes(inputs[j].data(), prefix.size * sizeof(double));
+      checks[j] = hash_bytes(inputs[j].data(), prefix.size * sizeof(double),
+                             kCheckSeed);
+    }
+  }
+  if (!matches(prefix, key, hashes, checks)) return nb::object();
+
+  // The first tail bar needs `lookback` bars before it
+  size_t size = inputs[0].shape(0), begin = prefix.size - lookback;
+  NanInputs window(inputs.size());
+  for (size_t j = 0; j < inputs.size(); ++j)
+    window[j] = NanGaps::slice(inputs[j], begin, size);
+  bool tuple;
+  std::vector<Output> tail;
+  nb::object tail_result = kernel(window);
+  if (!split(tail_result, tuple, tail) || tuple != prefix.tuple ||
+      tail.size() != prefix.outputs.size())
+    return nb::object();
+
+  nb::list outs;
+  for (size_t j = 0; j < tail.size(); ++j) {
+    const Output &head = prefix.outputs[j];
+    if (tail[j].integer) {
+      int *data = new int[size];
+      nb::capsule owner(data, [](void *p) noexcept { delete[] (int *)p; });
+      auto *src = static_cast<const int *>(tail[j].data);
+      std::copy_n(static_cast<const int *>(head.data), prefix.size, data);
+      std::copy(src + lookback, src + (size - begin), data + prefix.size);
+      outs.append(nb::ndarray<nb::numpy, int, nb::ndim<1>>(data, {size}, owner));
+    } else {
+      auto [data, owner] = alloc_output(size, 0);
+      auto *src = static_cast<const double *>(tail[j].data);
+      std::copy_n(static_cast<const double *>(head.data), prefix.size, data);
+      std::copy(src + lookback, src + (size - begin), data + prefix.size);
+      outs.append(DoubleArrayOUT(data, {size}, owner));
+    }
+  }
+  if (tuple) return nb::tuple(outs);
+  return outs[0];
+}
+
+void ResultCache::insert(Entry entry) {
+  bytes_ += entry.bytes;
+  lru_.push_front(std::move(entry));
+  by_key_[lru_.front().key] = lru_.begin();
+  if (lru_.front().head) by_head_.emplace(lru_.front().head, lru_.begin());
+  evict(max_bytes_);
+}
+
+void ResultCache::evict(size_t max_bytes) {
+  while (bytes_ > max_bytes || (max_bytes == 0 && !lru_.empty())) {
+    auto last = std::prev(lru_.end());
+    by_key_.erase(last->key);
+    auto [first, end] = by_head_.equal_range(last->head);
+    for (auto it = first; it != end; ++it)
+      if (it->second == last) {
+        by_head_.erase(it);
+        break;
+      }
+    bytes_ -= last->bytes;
+    lru_.pop_back();
+  }
+}
+
+nb::object run_py(nb::callable func, NanInputs inputs,
+                  const std::string &nan_policy, nb::args args) {
+  NanPolicy policy = parse_nan_policy(nan_policy);
+  auto kernel = [&](const NanInputs &in) {
+    // Views and packed copies are only used for the duration of the call
+    nb::list call;
+    for (const auto &arr : in)
+      call.append(nb::cast(arr, nb::rv_policy::reference));
+    for (nb::handle arg : args) call.append(arg);
+    return func(*nb::tuple(call));
+  };
+  if (!ResultCache::enabled())
+    return apply_nan_policy(policy, std::move(inputs), kernel);
+
+  std::string name = nb::cast<std::string>(func.attr("__name__"));
+  CallKey key{lookup_function(name), {},
+              hash_bytes(name.data(), name.size(),
+                         static_cast<uint64_t>(policy)),
+              policy == NanPolicy::Propagate};
+  auto salt = [&](nb::handle text) {
+    std::string s = nb::cast<std::string>(text);
+    key.salt = hash_bytes(s.data(), s.size(), key.salt);
+  };
+  for (nb::handle arg : args) {
+    if (nb::isinstance<nb::int_>(arg) || nb::isinstance<nb::float_>(arg)) {
+      key.params.push_back(nb::cast<double>(arg));
+    } else if (nb::isinstance<nb::str>(arg)) {
+      salt(arg);
+    } else if (nb::isinstance<nb::tuple>(arg) ||
+               nb::isinstance<nb::list>(arg)) {
+      for (nb::handle item : arg) {
+        if (!nb::isinstance<nb::str>(item))
+          return apply_nan_policy(policy, std::move(inputs), kernel);
+        salt(item);
+      }
+    } else {
+      // Nothing to key on: computed, not cached
+      return apply_nan_policy(policy, std::move(inputs), kernel);
+    }
+  }
+  return ResultCache::instance().call(key, inputs, [&](const NanInputs &in) {
+    return apply_nan_policy(policy, in, kernel);
+  });
+}
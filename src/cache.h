@@ -0,0 +1,129 @@
+#pragma once
+// Opt-in result cache (pytafast.enable_cache).
+//
+// Results are kept in an LRU bounded by a byte budget, keyed by a 64-bit
+// hash of the function, its parameters and the bytes of every input - so
+// the same request from a second caller (another dashboard widget, a
+// backtest re-run) is a lookup, whatever array object it arrives in.
+//
+// Cached results are handed out as read-only arrays sharing the cached
+// buffer, on the call that fills the entry as well as on later hits.
+//
+// A key match alone is not a hit: the entry's call, input length and the
+// two independent hashes of every input must match as well.
+//
+// Append-only series: when a windowed function (output at bar i depends
+// only on bars [i - lookback, i], see FunctionInfo::windowed) is called on
+// inputs that extend a cached call's inputs, only the new bars are computed,
+// from the last `lookback` cached bars on, and spliced after the cached
+// prefix. Tail values match a full recompute up to rounding in the kernels'
+// running sums.
+#include "nan_policy.h"
+#include "registry.h"
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+// 64-bit hash of `size` bytes (XXH64 construction)
+uint64_t hash_bytes(const void *data, size_t size, uint64_t seed = 0);
+
+// What identifies a call besides its inputs
+struct CallKey {
+  // Null for functions outside the registry: cached, but never tail-computed
+  const FunctionInfo *info;
+  // Numeric parameters in registry order (used for the lookback)
+  std::vector<double> params;
+  // Anything else that changes the result (layout, outputs, nan_policy)
+  uint64_t salt = 0;
+  // False when the kernel does not see the inputs bar for bar (nan_policy)
+  bool appendable = true;
+};
+
+class ResultCache {
+public:
+  static ResultCache &instance();
+
+  static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+  // max_bytes == 0 disables the cache and drops every entry
+  void configure(size_t max_bytes);
+  // Drops every entry and resets the counters
+  void clear();
+  // Budget, usage and hit / tail-hit / miss counts
+  nb::dict info();
+
+  // kernel(inputs) through the cache
+  nb::object call(const CallKey &key, const NanInputs &inputs,
+                  const std::function<nb::object(const NanInputs &)> &kernel);
+
+private:
+  // One 1-D output column of a cached result
+  struct Output {
+    bool integer;
+    const void *data;
+    size_t size;
+    nb::object owner;
+  };
+  struct Entry {
+    uint64_t key;  // call and full inputs
+    uint64_t head; // call and the first kHeadBars of each input; 0 if shorter
+    size_t size;   // input length
+    CallKey call;
+    // Per input: hash_bytes of its bytes, and a second hash of them under
+    // another seed. A hit must match the call and both, not only `key`.
+    std::vector<uint64_t> input_hashes;
+    std::vector<uint64_t> input_checks;
+    bool tuple;
+    std::vector<Output> outputs;
+    size_t bytes;
+  };
+  using EntryList = std::list<Entry>;
+
+  // Inputs at least this long are indexed for prefix (append) lookups
+  static constexpr size_t kHeadBars = 64;
+  // Seed of the second, independent input hash
+  static constexpr uint64_t kCheckSeed = 0x9FB21C651E98DF25ULL;
+
+  static bool split(nb::handle result, bool &tuple,
+                    std::vector<Output> &outputs);
+  static nb::object views(bool tuple, const std::vector<Output> &outputs);
+  // `entry` was computed by `key` on inputs of `size` bars whose first
+  // `size` bars hash to `hashes` and `checks`
+  static bool matches(const Entry &entry, const CallKey &key,
+                      const std::vector<uint64_t> &hashes,
+                      const std::vector<uint64_t> &checks);
+  nb::object append(const CallKey &key, const NanInputs &inputs,
+                    const Entry &prefix,
+                    const std::function<nb::object(const NanInputs &)> &kernel);
+  void insert(Entry entry);
+  void evict(size_t max_bytes);
+
+  static std::atomic<bool> enabled_;
+  std::mutex mutex_;
+  EntryList lru_; // most recently used first
+  std::unordered_map<uint64_t, EntryList::iterator> by_key_;
+  std::unordered_multimap<uint64_t, EntryList::iterator> by_head_;
+  size_t max_bytes_ = 0, bytes_ = 0;
+  uint64_t hits_ = 0, tail_hits_ = 0, misses_ = 0;
+};
+
+// kernel(inputs) through the result cache when it is enabled, under
+// nan_policy either way. `name` is a registry name.
+template <typename Kernel>
+nb::object cached_call(const char *name, std::vector<double> params,
+                       NanPolicy policy, NanInputs inputs, Kernel &&kernel) {
+  if (!ResultCache::enabled())
+    return apply_nan_policy(policy, std::move(inputs), kernel);
+  CallKey key{&find_function(name), std::move(params),
+              static_cast<uint64_t>(policy), policy == NanPolicy::Propagate};
+  return ResultCache::instance().call(key, inputs, [&](const NanInputs &in) {
+    return apply_nan_policy(policy, in, kernel);
+  });
+}
+
+// pytafast_ext.run(func, inputs, nan_policy, *args): func(*inputs, *args)
+// for a Python-level kernel, under nan_policy and through the cache
+nb::object run_py(nb::callable func, NanInputs inputs,
+                  const std::string &nan_policy, nb::args args);
@@ -1,40 +1,129 @@
 #pragma once
 
 #include <algorithm>
+#include <cmath>
+#include <functional>
 #include <limits>
 #include <nanobind/nanobind.h>
 #include <nanobind/ndarray.h>
+#include <nanobind/stl/string.h>
+#include <nanobind/stl/vector.h>
+#include <pytafast/core.h>
 #include <stdexcept>
 #include <string>
 #include <ta_libc.h>
+#include <type_traits>
+#include <vector>
 
 namespace nb = nanobind;
 
+#include "stats.h"
+
 // Type aliases for numpy array I/O
 using DoubleArrayIN =
     nb::ndarray<nb::numpy, const double, nb::c_contig, nb::ndim<1>>;
-using DoubleArrayOUT = nb::ndarray<nb::numpy, double, nb::ndim<1>>;
+template <typename T> using ArrayOUT = nb::ndarray<nb::numpy, T, nb::ndim<1>>;
+using DoubleArrayOUT = ArrayOUT<double>;
+using IntArrayOUT = ArrayOUT<int>;
 
 static const double NaN = std::numeric_limits<double>::quiet_NaN();
 
-// Check TA-Lib return codes
+// Check TA-Lib return codes (pytafast::Error, a RuntimeError in Python)
 inline void check_ta_retcode(TA_RetCode code, const char *func) {
-  if (code != TA_SUCCESS) {
-    throw std::runtime_error(
-        std::string(func) + " failed with TA_RetCode: " + std::to_string(code));
-  }
+  if (code != TA_SUCCESS) pytafast::check_retcode(code, func);
 }
 
-// Helper: allocate a double array, wrap in capsule, fill lookback region with
-// NaN
-struct AllocResult {
-  double *data;
+// Helper: allocate an output array, wrap in capsule, fill the lookback region
+// with NaN (0 for integer outputs)
+template <typename T = double> struct AllocResult {
+  T *data;
   nb::capsule owner;
 };
 
-inline AllocResult alloc_output(size_t size, int lookback) {
-  auto *data = new double[size];
-  nb::capsule owner(data, [](void *p) noexcept { delete[] (double *)p; });
-  std::fill(data, data + lookback, NaN);
+template <typename T = double>
+inline AllocResult<T> alloc_output(size_t size, int lookback) {
+  AllocScope alloc(size, size * sizeof(T));
+  auto *data = new T[size];
+  nb::capsule owner(data, [](void *p) noexcept { delete[] (T *)p; });
+  T fill;
+  if constexpr (std::is_integral_v<T>)
+    fill = 0;
+  else
+    fill = NaN;
+  std::fill(data, data + std::min(static_cast<size_t>(lookback), size), fill);
   return {data, std::move(owner)};
 }
+
+// Multi-output functions allocate all k outputs as one block with a single
+// owner. The layout decides what Python gets back:
+//   "tuple" - k 1-D arrays, each a contiguous row view into one (k, N) block
+//   "kN"    - the (k, N) block itself
+//   "Nk"    - an (N, k) block, one row per bar (computed row-wise, then
+//             interleaved once since TA-Lib only writes contiguous outputs)
+enum class OutputLayout { Tuple, KN, NK };
+
+inline OutputLayout parse_layout(const std::string &layout) {
+  if (layout == "tuple") return OutputLayout::Tuple;
+  if (layout == "kN") return OutputLayout::KN;
+  if (layout == "Nk") return OutputLayout::NK;
+  throw std::invalid_argument("layout must be 'tuple', 'kN' or 'Nk', got '" +
+                              layout + "'");
+}
+
+using DoubleArray2DOUT = nb::ndarray<nb::numpy, double, nb::ndim<2>>;
+
+class MultiOutput {
+public:
+  // One output per entry of `lookbacks`, each NaN-filled up to its lookback
+  MultiOutput(size_t size, std::initializer_list<int> lookbacks,
+              const std::string &layout)
+      : MultiOutput(size, std::vector<int>(lookbacks), parse_layout(layout)) {}
+
+  MultiOutput(size_t size, const std::vector<int> &lookbacks,
+              OutputLayout layout)
+      : k_(lookbacks.size()), size_(size), layout_(layout) {
+    AllocScope alloc(size_, k_ * size_ * sizeof(double));
+    data_ = new double[k_ * size_];
+    owner_ = nb::capsule(data_, [](void *p) noexcept { delete[] (double *)p; });
+    if (layout_ == OutputLayout::NK) scratch_.resize(k_ * size_);
+    for (size_t j = 0; j < k_; ++j)
+      std::fill(row(j),
+                row(j) + std::min(static_cast<size_t>(lookbacks[j]), size_),
+                NaN);
+  }
+
+  // Contiguous buffer for output j, in the order the lookbacks were given
+  double *row(size_t j) {
+    return (layout_ == OutputLayout::NK ? scratch_.data() : data_) + j * size_;
+  }
+
+  // Package the outputs for Python; call once, after computing every row
+  nb::object result() {
+    if (layout_ == OutputLayout::NK) {
+      nb::gil_scoped_release release;
+      for (size_t j = 0; j < k_; ++j) {
+        const double *src = scratch_.data() + j * size_;
+        for (size_t i = 0; i < size_; ++i) data_[i * k_ + j] = src[i];
+      }
+    }
+    switch (layout_) {
+    case OutputLayout::KN:
+      return nb::cast(DoubleArray2DOUT(data_, {k_, size_}, owner_));
+    case OutputLayout::NK:
+      return nb::cast(DoubleArray2DOUT(data_, {size_, k_}, owner_));
+    default: {
+      nb::list rows;
+      for (size_t j = 0; j < k_; ++j)
+        rows.append(DoubleArrayOUT(data_ + j * size_, {size_}, owner_));
+      return nb::tuple(rows);
+    }
+    }
+  }
+
+private:
+  size_t k_, size_;
+  OutputLayout layout_;
+  double *data_;
+  nb::capsule owner_;
+  std::vector<double> scratch_;
+};
@@ -0,0 +1,373 @@
+// pytafast_core: running the functions of the table (registry.cpp) over
+// caller-owned buffers - one series, many series, or bar by bar
+#include <pytafast/core.h>
+#include "fused.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <ta_libc.h>
+#include <thread>
+
+namespace pytafast {
+
+void check_retcode(int code, const char *what) {
+  if (code != TA_SUCCESS)
+    throw Error(std::string(what) + " failed with TA_RetCode: " +
+                    std::to_string(code),
+                code);
+}
+
+namespace {
+
+// Users of the TA-Lib context (initialize() calls not yet matched by
+// shutdown())
+std::mutex context_mutex;
+size_t context_users = 0;
+
+} // namespace
+
+void initialize() {
+  std::lock_guard<std::mutex> lock(context_mutex);
+  if (context_users == 0) check_retcode(TA_Initialize(), "TA_Initialize");
+  ++context_users;
+}
+
+void shutdown() {
+  std::lock_guard<std::mutex> lock(context_mutex);
+  if (context_users == 0) return;
+  if (--context_users == 0) check_retcode(TA_Shutdown(), "TA_Shutdown");
+}
+
+std::vector<double> resolve_params(const FunctionInfo &fn,
+                                   span<const double> params) {
+  if (params.size() > fn.params.size())
+    throw std::invalid_argument(
+        std::string(fn.name) + " takes " + std::to_string(fn.params.size()) +
+        " parameters, got " + std::to_string(params.size()));
+  std::vector<double> values(params.begin(), params.end());
+  for (size_t j = values.size(); j < fn.params.size(); ++j)
+    values.push_back(fn.params[j].default_value);
+  return values;
+}
+
+int lookback(const FunctionInfo &fn, span<const double> params) {
+  return fn.lookback(resolve_params(fn, params).data());
+}
+
+namespace {
+
+const double NaN = std::numeric_limits<double>::quiet_NaN();
+
+void check_arity(const FunctionInfo &fn, size_t inputs, size_t outputs,
+                 bool integer) {
+  if (inputs != fn.inputs.size())
+    throw std::invalid_argument(
+        std::string(fn.name) + " takes " + std::to_string(fn.inputs.size()) +
+        " inputs, got " + std::to_string(inputs));
+  if (outputs != fn.outputs.size())
+    throw std::invalid_argument(
+        std::string(fn.name) + " has " + std::to_string(fn.outputs.size()) +
+        " outputs, got " + std::to_string(outputs));
+  if (integer != fn.integer_output)
+    throw std::invalid_argument(std::string(fn.name) + " has " +
+                                (fn.integer_output ? "int" : "double") +
+                                " outputs");
+}
+
+// Fills the lookback region of each output, then runs `fn` over `size`
+// bars. Arguments are already checked.
+void run(const FunctionInfo &fn, size_t size, const double *const *inputs,
+         const double *params, void *const *outputs) {
+  if (size == 0) return;
+  if (size > static_cast<size_t>(INT_MAX))
+    throw std::invalid_argument("Series longer than INT_MAX bars");
+  const int lookback = std::max(fn.lookback(params), 0);
+  const size_t fill = std::min(static_cast<size_t>(lookback), size);
+  for (size_t k = 0; k < fn.outputs.size(); ++k) {
+    if (fn.integer_output)
+      std::fill_n(static_cast<int *>(outputs[k]), fill, 0);
+    else
+      std::fill_n(static_cast<double *>(outputs[k]), fill, NaN);
+  }
+  check_retcode(fn.compute(static_cast<int>(size), lookback, inputs, params,
+                           outputs),
+                fn.name);
+}
+
+template <typename T>
+void compute_series(const FunctionInfo &fn,
+                    span<const span<const double>> inputs,
+                    span<const double> params, span<const span<T>> outputs) {
+  check_arity(fn, inputs.size(), outputs.size(), std::is_integral_v<T>);
+  const size_t size = inputs.empty() ? 0 : inputs[0].size();
+  std::vector<const double *> in;
+  for (const auto &input : inputs) {
+    if (input.size() != size)
+      throw std::invalid_argument("Input lengths must match");
+    in.push_back(input.data());
+  }
+  std::vector<void *> out;
+  for (const auto &output : outputs) {
+    if (output.size() != size)
+      throw std::invalid_argument("Output lengths must match the inputs");
+    out.push_back(output.data());
+  }
+  std::vector<double> p = resolve_params(fn, params);
+  run(fn, size, in.data(), p.data(), out.data());
+}
+
+template <typename T>
+void compute_rows(const FunctionInfo &fn, size_t count, size_t size,
+                  span<const double *const> inputs, span<const double> params,
+                  span<T *const> outputs, unsigned threads) {
+  check_arity(fn, inputs.size(), outputs.size(), std::is_integral_v<T>);
+  const std::vector<double> p = resolve_params(fn, params);
+  auto series = [&](size_t s) {
+    std::vector<const double *> in;
+    for (const double *input : inputs) in.push_back(input + s * size);
+    std::vector<void *> out;
+    for (T *output : outputs) out.push_back(output + s * size);
+    run(fn, size, in.data(), p.data(), out.data());
+  };
+
+  if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = static_cast<unsigned>(std::min<size_t>(threads, count));
+  if (threads <= 1) {
+    for (size_t s = 0; s < count; ++s) series(s);
+    return;
+  }
+
+  // Series are handed out one at a time, so uneven costs balance out; the
+  // first error stops the remaining series and is rethrown here
+  std::atomic<size_t> next{0};
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  auto worker = [&] {
+    for (size_t s; (s = next.fetch_add(1)) < count;) {
+      try {
+        series(s);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(error_mutex);
+        if (!error) error = std::current_exception();
+        next.store(count);
+      }
+    }
+  };
+  std::vector<std::thread> pool;
+  for (unsigned t = 1; t < threads; ++t) pool.emplace_back(worker);
+  worker();
+  for (auto &thread : pool) thread.join();
+  if (error) std::rethrow_exception(error);
+}
+
+} // namespace
+
+void compute(const FunctionInfo &fn, span<const span<const double>> inputs,
+             span<const double> params, span<const span<double>> outputs) {
+  compute_series(fn, inputs, params, outputs);
+}
+
+void compute(const FunctionInfo &fn, span<const span<const double>> inputs,
+             span<const double> params, span<const span<int>> outputs) {
+  compute_series(fn, inputs, params, outputs);
+}
+
+void compute_many(const FunctionInfo &fn, size_t count, size_t size,
+                  span<const double *const> inputs, span<const double> params,
+                  span<double *const> outputs, unsigned threads) {
+  compute_rows(fn, count, size, inputs, params, outputs, threads);
+}
+
+void compute_many(const FunctionInfo &fn, size_t count, size_t size,
+                  span<const double *const> inputs, span<const double> params,
+                  span<int *const> outputs, unsigned threads) {
+  compute_rows(fn, count, size, inputs, params, outputs, threads);
+}
+
+// ---------------------------------------------------------
+// Stream
+// ---------------------------------------------------------
+
+Stream::Stream(const FunctionInfo &fn, span<const double> params,
+               size_t max_history)
+    : fn_(&fn), params_(resolve_params(fn, params)),
+      lookback_(fn.lookback(params_.data())), inputs_(fn.inputs.size()),
+      in_ptrs_(fn.inputs.size()), out_ptrs_(fn.outputs.size()) {
+  if (lookback_ < 0) check_retcode(TA_BAD_PARAM, fn.name);
+  const size_t window = static_cast<size_t>(lookback_) + 1;
+  if (fn.windowed)
+    history_ = window;
+  else
+    history_ = max_history ? std::max(max_history, window) : 0;
+  if (fn.integer_output)
+    int_out_.resize(fn.outputs.size());
+  else
+    real_out_.resize(fn.outputs.size());
+}
+
+bool Stream::update(span<const double> bar, span<double> out) {
+  if (bar.size() != inputs_.size())
+    throw std::invalid_argument(
+        std::string(fn_->name) + " takes " + std::to_string(inputs_.size()) +
+        " inputs per bar, got " + std::to_string(bar.size()));
+  if (out.size() < out_ptrs_.size())
+    throw std::invalid_argument(
+        std::string(fn_->name) + " has " + std::to_string(out_ptrs_.size()) +
+        " outputs, got room for " + std::to_string(out.size()));
+
+  for (size_t j = 0; j < inputs_.size(); ++j) inputs_[j].push_back(bar[j]);
+  ++bars_;
+  size_t kept = inputs_[0].size() - begin_;
+  if (history_ != 0 && kept > history_) {
+    ++begin_;
+    --kept;
+  }
+  // Drop the bars that fell out of the history once they outnumber the
+  // kept ones, so the buffers stay within twice the history
+  if (begin_ > kept) {
+    for (auto &input : inputs_)
+      input.erase(input.begin(), input.begin() + begin_);
+    begin_ = 0;
+  }
+  if (kept <= static_cast<size_t>(lookback_)) return false;
+
+  for (size_t j = 0; j < inputs_.size(); ++j)
+    in_ptrs_[j] = inputs_[j].data() + begin_;
+  for (size_t k = 0; k < out_ptrs_.size(); ++k) {
+    if (fn_->integer_output) {
+      int_out_[k].resize(kept);
+      out_ptrs_[k] = int_out_[k].data();
+    } else {
+      real_out_[k].resize(kept);
+      out_ptrs_[k] = real_out_[k].data();
+    }
+  }
+  run(*fn_, kept, in_ptrs_.data(), params_.data(), out_ptrs_.data());
+  for (size_t k = 0; k < out_ptrs_.size(); ++k)
+    out[k] = fn_->integer_output ? int_out_[k][kept - 1]
+                                 : real_out_[k][kept - 1];
+  return true;
+}
+
+void Stream::reset() {
+  for (auto &input : inputs_) input.clear();
+  begin_ = 0;
+  bars_ = 0;
+}
+
+// ---------------------------------------------------------
+// HilbertStream
+// ---------------------------------------------------------
+
+static_assert(HilbertStream::kOutputs == HT_NB_OUTPUTS,
+              "HilbertStream::kOutputs must match HtOutput");
+
+HilbertStream::HilbertStream() : state_(new HilbertTransform) {
+  ht_all_lookbacks(lookbacks_);
+  lookback_ = *std::max_element(lookbacks_, lookbacks_ + kOutputs);
+}
+
+HilbertStream::~HilbertStream() = default;
+HilbertStream::HilbertStream(HilbertStream &&) noexcept = default;
+HilbertStream &HilbertStream::operator=(HilbertStream &&) noexcept = default;
+
+bool HilbertStream::update(double value, span<double> out) {
+  if (out.size() < kOutputs)
+    throw std::invalid_argument("HT_ALL has " + std::to_string(kOutputs) +
+                                " outputs, got room for " +
+                                std::to_string(out.size()));
+  double values[HT_NB_OUTPUTS];
+  state_->step(value, values);
+  const size_t today = state_->bars() - 1;
+  for (size_t k = 0; k < kOutputs; ++k)
+    out[k] = today >= static_cast<size_t>(lookbacks_[k]) ? values[k] : NaN;
+  return today >= static_cast<size_t>(lookback_);
+}
+
+void HilbertStream::reset() { state_->reset(); }
+
+size_t HilbertStream::bars() const { return state_->bars(); }
+
+// ---------------------------------------------------------
+// CandleStream
+// ---------------------------------------------------------
+
+CandleStream::CandleStream(span<const std::string> patterns) {
+  init(patterns, nullptr);
+}
+
+CandleStream::CandleStream(span<const std::string> patterns,
+                           double penetration) {
+  init(patterns, &penetration);
+}
+
+void CandleStream::init(span<const std::string> patterns,
+                        const double *penetration) {
+  static const std::string kPattern = "Pattern Recognition";
+  if (patterns.empty()) {
+    for (const FunctionInfo &fn : function_table())
+      if (fn.group == kPattern) patterns_.push_back(&fn);
+  } else {
+    for (const std::string &name : patterns) {
+      const FunctionInfo &fn = find_function(name);
+      if (fn.group != kPattern || fn.inputs.size() != 4 ||
+          !fn.integer_output || fn.outputs.size() != 1)
+        throw std::invalid_argument(std::string(fn.name) +
+                                    " is not a candlestick pattern");
+      patterns_.push_back(&fn);
+    }
+  }
+  for (const FunctionInfo *fn : patterns_) {
+    const bool penetrated = penetration && !fn->params.empty();
+    params_.push_back(resolve_params(
+        *fn, penetrated ? span<const double>(penetration, 1)
+                        : span<const double>()));
+    const int lookback = fn->lookback(params_.back().data());
+    if (lookback < 0) check_retcode(TA_BAD_PARAM, fn->name);
+    lookbacks_.push_back(lookback);
+    capacity_ = std::max(capacity_, static_cast<size_t>(lookback) + 1);
+  }
+  for (auto &column : ring_) column.resize(2 * capacity_);
+  signal_.resize(capacity_);
+}
+
+void CandleStream::update(double open, double high, double low, double close,
+                          span<int> out) {
+  if (out.size() < patterns_.size())
+    throw std::invalid_argument(
+        "CandleStream has " + std::to_string(patterns_.size()) +
+        " patterns, got room for " + std::to_string(out.size()));
+  const double bar[4] = {open, high, low, close};
+  for (int j = 0; j < 4; ++j)
+    ring_[j][head_] = ring_[j][head_ + capacity_] = bar[j];
+  // The kept bars are [end - capacity_, end) in every column
+  const size_t end = head_ + capacity_ + 1;
+  head_ = head_ + 1 == capacity_ ? 0 : head_ + 1;
+  ++bars_;
+
+  for (size_t k = 0; k < patterns_.size(); ++k) {
+    const size_t window = static_cast<size_t>(lookbacks_[k]) + 1;
+    if (bars_ < window) {
+      out[k] = 0;
+      continue;
+    }
+    const double *in[4];
+    for (int j = 0; j < 4; ++j) in[j] = ring_[j].data() + end - window;
+    void *const signal[] = {signal_.data()};
+    check_retcode(patterns_[k]->compute(static_cast<int>(window),
+                                        lookbacks_[k], in,
+                                        params_[k].data(), signal),
+                  patterns_[k]->name);
+    out[k] = signal_[window - 1];
+  }
+}
+
+void CandleStream::reset() {
+  head_ = 0;
+  bars_ = 0;
+}
+
+} // namespace pytafast
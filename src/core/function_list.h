@@ -0,0 +1,173 @@
+#pragma once
+// The function table: every function with a common calling convention,
+// listed once. Each list is an X-macro over its entries; it is expanded into
+// the metadata and compute entries of the core registry (core/registry.cpp)
+// and, in the extension module, into the kernels (functions.cpp), their
+// declarations (functions.h) and the raw and public bindings
+// (pytafast_ext.cpp). Adding a function of one of these shapes is one line
+// here.
+//
+// The lists cover only these shapes. Functions with a signature of their
+// own (several outputs, several parameters, fused kernels: BBANDS, MACD,
+// STOCH, DMI_ALL, HT_ALL, ...) are not generated from anything: each needs
+// its registry entry (core/registry.cpp), its kernel in a group file
+// (overlap.cpp, momentum.cpp, ...), its declaration and m.def in
+// pytafast_ext.cpp, and its wrapper and _ALL_FUNCTIONS entry in
+// pytafast/__init__.py.
+//
+// NAME is the TA-Lib function (TA_NAME, TA_NAME_Lookback) and the Python
+// name, FUNC the C++ kernel, GROUP the registry group and DEF the default
+// of the single parameter (timeperiod or penetration).
+
+// X(NAME, FUNC, GROUP, DEF): inReal, timeperiod
+#define PYTAFAST_SINGLE(X)                                                     \
+  X(SMA, sma, OVERLAP, 30)                                                     \
+  X(EMA, ema, OVERLAP, 30)                                                     \
+  X(DEMA, dema, OVERLAP, 30)                                                   \
+  X(KAMA, kama, OVERLAP, 30)                                                   \
+  X(TEMA, tema, OVERLAP, 30)                                                   \
+  X(TRIMA, trima, OVERLAP, 30)                                                 \
+  X(WMA, wma, OVERLAP, 30)                                                     \
+  X(MIDPOINT, midpoint, OVERLAP, 14)                                           \
+  X(RSI, rsi, MOMENTUM, 14)                                                    \
+  X(MOM, mom, MOMENTUM, 10)                                                    \
+  X(ROC, roc, MOMENTUM, 10)                                                    \
+  X(ROCP, rocp, MOMENTUM, 10)                                                  \
+  X(ROCR, rocr, MOMENTUM, 10)                                                  \
+  X(ROCR100, rocr100, MOMENTUM, 10)                                            \
+  X(CMO, cmo, MOMENTUM, 14)                                                    \
+  X(TRIX, trix, MOMENTUM, 30)                                                  \
+  X(LINEARREG, linearreg, STATISTIC, 14)                                       \
+  X(LINEARREG_ANGLE, linearreg_angle, STATISTIC, 14)                           \
+  X(LINEARREG_INTERCEPT, linearreg_intercept, STATISTIC, 14)                   \
+  X(LINEARREG_SLOPE, linearreg_slope, STATISTIC, 14)                           \
+  X(TSF, tsf, STATISTIC, 14)                                                   \
+  X(AVGDEV, avgdev, STATISTIC, 14)                                             \
+  X(MAX, ta_max, STATISTIC, 30)                                                \
+  X(MIN, ta_min, STATISTIC, 30)                                                \
+  X(SUM, ta_sum, STATISTIC, 30)
+
+// X(NAME, FUNC, GROUP): inReal
+#define PYTAFAST_SINGLE_NP(X)                                                  \
+  X(HT_DCPERIOD, ht_dcperiod, CYCLE)                                           \
+  X(HT_DCPHASE, ht_dcphase, CYCLE)                                             \
+  X(HT_TRENDLINE, ht_trendline, CYCLE)
+
+// X(NAME, FUNC, GROUP): inReal, element-wise
+#define PYTAFAST_MATH(X)                                                       \
+  X(ACOS, ta_acos, MATH_TRANSFORM)                                             \
+  X(ASIN, ta_asin, MATH_TRANSFORM)                                             \
+  X(ATAN, ta_atan, MATH_TRANSFORM)                                             \
+  X(CEIL, ta_ceil, MATH_TRANSFORM)                                             \
+  X(COS, ta_cos, MATH_TRANSFORM)                                               \
+  X(COSH, ta_cosh, MATH_TRANSFORM)                                             \
+  X(EXP, ta_exp, MATH_TRANSFORM)                                               \
+  X(FLOOR, ta_floor, MATH_TRANSFORM)                                           \
+  X(LN, ta_ln, MATH_TRANSFORM)                                                 \
+  X(LOG10, ta_log10, MATH_TRANSFORM)                                           \
+  X(SIN, ta_sin, MATH_TRANSFORM)                                               \
+  X(SINH, ta_sinh, MATH_TRANSFORM)                                             \
+  X(SQRT, ta_sqrt, MATH_TRANSFORM)                                             \
+  X(TAN, ta_tan, MATH_TRANSFORM)                                               \
+  X(TANH, ta_tanh, MATH_TRANSFORM)
+
+// X(NAME, FUNC, GROUP, DEF): inHigh, inLow, timeperiod
+#define PYTAFAST_HL(X)                                                         \
+  X(MIDPRICE, midprice, OVERLAP, 14)                                           \
+  X(MINUS_DM, minus_dm, MOMENTUM, 14)                                          \
+  X(PLUS_DM, plus_dm, MOMENTUM, 14)                                            \
+  X(AROONOSC, aroonosc, MOMENTUM, 14)
+
+// X(NAME, FUNC, GROUP, DEF): inHigh, inLow, inClose, timeperiod
+#define PYTAFAST_HLC(X)                                                        \
+  X(ADX, adx, MOMENTUM, 14)                                                    \
+  X(ADXR, adxr, MOMENTUM, 14)                                                  \
+  X(CCI, cci, MOMENTUM, 14)                                                    \
+  X(DX, dx, MOMENTUM, 14)                                                      \
+  X(MINUS_DI, minus_di, MOMENTUM, 14)                                          \
+  X(PLUS_DI, plus_di, MOMENTUM, 14)                                            \
+  X(WILLR, willr, MOMENTUM, 14)                                                \
+  X(ATR, atr, VOLATILITY, 14)                                                  \
+  X(NATR, natr, VOLATILITY, 14)
+
+// X(NAME, FUNC, GROUP, DEF): inReal0, inReal1, timeperiod
+#define PYTAFAST_DUAL(X)                                                       \
+  X(BETA, beta, STATISTIC, 5)                                                  \
+  X(CORREL, correl, STATISTIC, 30)
+
+// X(NAME, FUNC, GROUP, IN0, IN1): two inputs, public names inReal0 and
+// inReal1; IN0 / IN1 are the raw binding's (TA-Lib's) names
+#define PYTAFAST_DUAL_NP(X)                                                    \
+  X(OBV, obv, VOLUME, inReal, inVolume)                                        \
+  X(MEDPRICE, medprice, PRICE, inHigh, inLow)                                  \
+  X(ADD, add, MATH_OP, inReal0, inReal1)                                       \
+  X(SUB, sub, MATH_OP, inReal0, inReal1)                                       \
+  X(MULT, mult, MATH_OP, inReal0, inReal1)                                     \
+  X(DIV, ta_div, MATH_OP, inReal0, inReal1)
+
+// X(NAME, FUNC): inOpen, inHigh, inLow, inClose -> int32
+#define PYTAFAST_CDL(X)                                                        \
+  X(CDL2CROWS, cdl2crows)                                                      \
+  X(CDL3BLACKCROWS, cdl3blackcrows)                                            \
+  X(CDL3INSIDE, cdl3inside)                                                    \
+  X(CDL3LINESTRIKE, cdl3linestrike)                                            \
+  X(CDL3OUTSIDE, cdl3outside)                                                  \
+  X(CDL3STARSINSOUTH, cdl3starsinsouth)                                        \
+  X(CDL3WHITESOLDIERS, cdl3whitesoldiers)                                      \
+  X(CDLADVANCEBLOCK, cdladvanceblock)                                          \
+  X(CDLBELTHOLD, cdlbelthold)                                                  \
+  X(CDLBREAKAWAY, cdlbreakaway)                                                \
+  X(CDLCLOSINGMARUBOZU, cdlclosingmarubozu)                                    \
+  X(CDLCONCEALBABYSWALL, cdlconcealbabyswall)                                  \
+  X(CDLCOUNTERATTACK, cdlcounterattack)                                        \
+  X(CDLDOJI, cdldoji)                                                          \
+  X(CDLDOJISTAR, cdldojistar)                                                  \
+  X(CDLDRAGONFLYDOJI, cdldragonflydoji)                                        \
+  X(CDLENGULFING, cdlengulfing)                                                \
+  X(CDLGAPSIDESIDEWHITE, cdlgapsidesidewhite)                                  \
+  X(CDLGRAVESTONEDOJI, cdlgravestonedoji)                                      \
+  X(CDLHAMMER, cdlhammer)                                                      \
+  X(CDLHANGINGMAN, cdlhangingman)                                              \
+  X(CDLHARAMI, cdlharami)                                                      \
+  X(CDLHARAMICROSS, cdlharamicross)                                            \
+  X(CDLHIGHWAVE, cdlhighwave)                                                  \
+  X(CDLHIKKAKE, cdlhikkake)                                                    \
+  X(CDLHIKKAKEMOD, cdlhikkakemod)                                              \
+  X(CDLHOMINGPIGEON, cdlhomingpigeon)                                          \
+  X(CDLIDENTICAL3CROWS, cdlidentical3crows)                                    \
+  X(CDLINNECK, cdlinneck)                                                      \
+  X(CDLINVERTEDHAMMER, cdlinvertedhammer)                                      \
+  X(CDLKICKING, cdlkicking)                                                    \
+  X(CDLKICKINGBYLENGTH, cdlkickingbylength)                                    \
+  X(CDLLADDERBOTTOM, cdlladderbottom)                                          \
+  X(CDLLONGLEGGEDDOJI, cdllongleggeddoji)                                      \
+  X(CDLLONGLINE, cdllongline)                                                  \
+  X(CDLMARUBOZU, cdlmarubozu)                                                  \
+  X(CDLMATCHINGLOW, cdlmatchinglow)                                            \
+  X(CDLONNECK, cdlonneck)                                                      \
+  X(CDLPIERCING, cdlpiercing)                                                  \
+  X(CDLRICKSHAWMAN, cdlrickshawman)                                            \
+  X(CDLRISEFALL3METHODS, cdlrisefall3methods)                                  \
+  X(CDLSEPARATINGLINES, cdlseparatinglines)                                    \
+  X(CDLSHOOTINGSTAR, cdlshootingstar)                                          \
+  X(CDLSHORTLINE, cdlshortline)                                                \
+  X(CDLSPINNINGTOP, cdlspinningtop)                                            \
+  X(CDLSTALLEDPATTERN, cdlstalledpattern)                                      \
+  X(CDLSTICKSANDWICH, cdlsticksandwich)                                        \
+  X(CDLTAKURI, cdltakuri)                                                      \
+  X(CDLTASUKIGAP, cdltasukigap)                                                \
+  X(CDLTHRUSTING, cdlthrusting)                                                \
+  X(CDLTRISTAR, cdltristar)                                                    \
+  X(CDLUNIQUE3RIVER, cdlunique3river)                                          \
+  X(CDLUPSIDEGAP2CROWS, cdlupsidegap2crows)                                    \
+  X(CDLXSIDEGAP3METHODS, cdlxsidegap3methods)
+
+// X(NAME, FUNC, DEF): inOpen, inHigh, inLow, inClose, penetration -> int32
+#define PYTAFAST_CDL_PEN(X)                                                    \
+  X(CDLABANDONEDBABY, cdlabandonedbaby, 0.3)                                   \
+  X(CDLDARKCLOUDCOVER, cdldarkcloudcover, 0.5)                                 \
+  X(CDLEVENINGDOJISTAR, cdleveningdojistar, 0.3)                               \
+  X(CDLEVENINGSTAR, cdleveningstar, 0.3)                                       \
+  X(CDLMATHOLD, cdlmathold, 0.5)                                               \
+  X(CDLMORNINGDOJISTAR, cdlmorningdojistar, 0.3)                               \
+  X(CDLMORNINGSTAR, cdlmorningstar, 0.3)
@@ -0,0 +1,548 @@
+#include "fused.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <ta_libc.h>
+#include <vector>
+
+namespace pytafast {
+
+// ---------------------------------------------------------
+// DIRECTIONAL MOVEMENT FAMILY, FUSED (DMI_ALL)
+// One pass over H/L/C that shares the smoothed TR/+DM/-DM state between
+// PLUS_DM, MINUS_DM, PLUS_DI, MINUS_DI, DX, ADX and ADXR. The recurrences
+// follow TA-Lib exactly (plain sum over the first period-1 bars, then Wilder
+// smoothing), so each output matches its standalone TA_XXX counterpart.
+// ---------------------------------------------------------
+static inline bool ta_is_zero(double v) { return -1e-14 < v && v < 1e-14; }
+
+int dmi_all_lookbacks(int period, int lookbacks[DMI_NB_OUTPUTS]) {
+  // Same valid range as TA_ADX/TA_DX (TA_XXX_DM/DI also accept 1, but that
+  // degenerates to the unsmoothed raw values)
+  if (period < 2 || period > 100000) return TA_BAD_PARAM;
+  const int p = period;
+  const int values[DMI_NB_OUTPUTS] = {p - 1, p - 1, p, p, p, 2 * p - 1,
+                                      3 * p - 2};
+  for (int j = 0; j < DMI_NB_OUTPUTS; ++j) lookbacks[j] = values[j];
+  return TA_SUCCESS;
+}
+
+int dmi_all(const double *high, const double *low, const double *close,
+            size_t size, int period, double *const outputs[DMI_NB_OUTPUTS]) {
+  int lookbacks[DMI_NB_OUTPUTS];
+  int retCode = dmi_all_lookbacks(period, lookbacks);
+  if (retCode != TA_SUCCESS || size == 0) return retCode;
+
+  double *outPlusDM = outputs[DMI_PLUS_DM], *outMinusDM = outputs[DMI_MINUS_DM];
+  double *outPlusDI = outputs[DMI_PLUS_DI], *outMinusDI = outputs[DMI_MINUS_DI];
+  double *outDX = outputs[DMI_DX], *outADX = outputs[DMI_ADX];
+  double *outADXR = outputs[DMI_ADXR];
+
+  const size_t p = static_cast<size_t>(period);
+  const size_t adxBeg = 2 * p - 1;
+  const size_t adxrBeg = adxBeg + p - 1;
+
+  double prevHigh = high[0], prevLow = low[0], prevClose = close[0];
+  double plusDM = 0.0, minusDM = 0.0, tr = 0.0;
+  double sumDX = 0.0, adx = 0.0;
+
+  for (size_t today = 1; today < size; ++today) {
+    const double diffP = high[today] - prevHigh;
+    const double diffM = prevLow - low[today];
+    prevHigh = high[today];
+    prevLow = low[today];
+
+    double trueRange = prevHigh - prevLow;
+    double tmp = std::fabs(prevHigh - prevClose);
+    if (tmp > trueRange) trueRange = tmp;
+    tmp = std::fabs(prevLow - prevClose);
+    if (tmp > trueRange) trueRange = tmp;
+    prevClose = close[today];
+
+    if (today >= p) {
+      plusDM -= plusDM / period;
+      minusDM -= minusDM / period;
+      tr = tr - tr / period + trueRange;
+    } else {
+      tr += trueRange;
+    }
+    if (diffM > 0 && diffP < diffM)
+      minusDM += diffM;
+    else if (diffP > 0 && diffP > diffM)
+      plusDM += diffP;
+
+    if (today < p - 1) continue;
+    outPlusDM[today] = plusDM;
+    outMinusDM[today] = minusDM;
+    if (today < p) continue;
+
+    // +DI / -DI / DX
+    bool dxValid = false;
+    double dxRaw = 0.0;
+    if (!ta_is_zero(tr)) {
+      const double minusDI = 100.0 * (minusDM / tr);
+      const double plusDI = 100.0 * (plusDM / tr);
+      outPlusDI[today] = plusDI;
+      outMinusDI[today] = minusDI;
+      const double sumDI = minusDI + plusDI;
+      if (!ta_is_zero(sumDI)) {
+        dxRaw = 100.0 * (std::fabs(minusDI - plusDI) / sumDI);
+        dxValid = true;
+      }
+    } else {
+      outPlusDI[today] = 0.0;
+      outMinusDI[today] = 0.0;
+    }
+    // TA_DX repeats the previous value when either denominator vanishes
+    outDX[today] = dxValid ? dxRaw : (today == p ? 0.0 : outDX[today - 1]);
+
+    // ADX: seeded by the mean of the first `period` DX values, then smoothed;
+    // TA_ADX skips (rather than repeats) bars with an undefined DX
+    if (today <= adxBeg) {
+      if (dxValid) sumDX += dxRaw;
+      if (today < adxBeg) continue;
+      adx = sumDX / period;
+    } else if (dxValid) {
+      adx = (adx * (period - 1) + dxRaw) / period;
+    }
+    outADX[today] = adx;
+
+    if (today >= adxrBeg)
+      outADXR[today] = (adx + outADX[today - (p - 1)]) / 2.0;
+  }
+  return TA_SUCCESS;
+}
+
+// ---------------------------------------------------------
+// STOCHASTIC FAMILY, FUSED (STOCH_ALL)
+// STOCH, STOCHF and WILLR all derive from the same highest-high/lowest-low
+// window, so it is scanned once and %K is smoothed only for the requested
+// outputs. Each output keeps the lookback and values of its standalone
+// function (WILLR uses the fast %K period as its window).
+// ---------------------------------------------------------
+
+namespace {
+
+// Sliding-window extreme over a monotonic deque: amortised O(1) per bar, where
+// TA-Lib rescans the whole window whenever the current extreme drops out.
+template <typename Cmp> class RollingExtreme {
+public:
+  RollingExtreme(const double *data, size_t window)
+      : data_(data), window_(window), idx_(window) {}
+
+  // Push bar t and return the extreme over [t - window + 1, t]
+  double push(size_t t) {
+    if (count_ != 0 && idx_[head_] + window_ <= t) {
+      head_ = wrap(head_ + 1);
+      --count_;
+    }
+    while (count_ != 0 && !cmp_(data_[idx_[wrap(head_ + count_ - 1)]], data_[t]))
+      --count_;
+    idx_[wrap(head_ + count_)] = t;
+    ++count_;
+    return data_[idx_[head_]];
+  }
+
+private:
+  size_t wrap(size_t i) const { return i >= window_ ? i - window_ : i; }
+
+  const double *data_;
+  size_t window_;
+  std::vector<size_t> idx_;
+  size_t head_ = 0;
+  size_t count_ = 0;
+  Cmp cmp_;
+};
+
+} // namespace
+
+int stoch_all_lookbacks(int fastKPeriod, int slowKPeriod, int slowKMAType,
+                        int slowDPeriod, int slowDMAType, int fastDPeriod,
+                        int fastDMAType, int lookbacks[STOCH_NB_OUTPUTS]) {
+  int lbK = fastKPeriod - 1;
+  int lbFastD = TA_MA_Lookback(fastDPeriod, (TA_MAType)fastDMAType);
+  int lbSlowK = TA_MA_Lookback(slowKPeriod, (TA_MAType)slowKMAType);
+  int lbSlowD = TA_MA_Lookback(slowDPeriod, (TA_MAType)slowDMAType);
+  if (fastKPeriod < 1 || fastKPeriod > 100000 || lbFastD < 0 || lbSlowK < 0 ||
+      lbSlowD < 0)
+    return TA_BAD_PARAM;
+  const int values[STOCH_NB_OUTPUTS] = {
+      lbK + lbFastD, lbK + lbFastD, lbK + lbSlowK + lbSlowD,
+      lbK + lbSlowK + lbSlowD, lbK};
+  for (int j = 0; j < STOCH_NB_OUTPUTS; ++j) lookbacks[j] = values[j];
+  return TA_SUCCESS;
+}
+
+int stoch_all(const double *high, const double *low, const double *close,
+              size_t size, int fastKPeriod, int slowKPeriod, int slowKMAType,
+              int slowDPeriod, int slowDMAType, int fastDPeriod,
+              int fastDMAType, double *const outputs[STOCH_NB_OUTPUTS]) {
+  int lookbacks[STOCH_NB_OUTPUTS];
+  int retCode = stoch_all_lookbacks(fastKPeriod, slowKPeriod, slowKMAType,
+                                    slowDPeriod, slowDMAType, fastDPeriod,
+                                    fastDMAType, lookbacks);
+  if (retCode != TA_SUCCESS) return retCode;
+  // Same range as TA_WILLR, which refuses a period of 1
+  if (outputs[STOCH_WILLR] && fastKPeriod < 2) return TA_BAD_PARAM;
+
+  const int lbK = lookbacks[STOCH_WILLR];
+  const int lbFastD = lookbacks[STOCH_FASTD] - lbK;
+  const int lbSlowK = TA_MA_Lookback(slowKPeriod, (TA_MAType)slowKMAType);
+  const int lbSlowD = TA_MA_Lookback(slowDPeriod, (TA_MAType)slowDMAType);
+  if (size <= static_cast<size_t>(lbK)) return TA_SUCCESS;
+
+  const int nbFast = static_cast<int>(size) - lbK;
+  std::vector<double> fastK(nbFast);
+  RollingExtreme<std::greater<double>> highest(high, fastKPeriod);
+  RollingExtreme<std::less<double>> lowest(low, fastKPeriod);
+  for (size_t today = 0; today < size; ++today) {
+    const double hh = highest.push(today);
+    const double ll = lowest.push(today);
+    if (today < static_cast<size_t>(lbK)) continue;
+    double diff = (hh - ll) / 100.0;
+    fastK[today - lbK] = diff != 0.0 ? (close[today] - ll) / diff : 0.0;
+    if (outputs[STOCH_WILLR]) {
+      diff = (hh - ll) / (-100.0);
+      outputs[STOCH_WILLR][today] =
+          diff != 0.0 ? (hh - close[today]) / diff : 0.0;
+    }
+  }
+
+  int outBegIdx = 0, outNBElement = 0;
+  if (outputs[STOCH_FASTD]) {
+    retCode = TA_MA(0, nbFast - 1, fastK.data(), fastDPeriod,
+                    (TA_MAType)fastDMAType, &outBegIdx, &outNBElement,
+                    outputs[STOCH_FASTD] + lbK + lbFastD);
+  }
+  if (outputs[STOCH_FASTK] && nbFast > lbFastD) {
+    std::copy(fastK.begin() + lbFastD, fastK.end(),
+              outputs[STOCH_FASTK] + lbK + lbFastD);
+  }
+  if (retCode == TA_SUCCESS &&
+      (outputs[STOCH_SLOWK] || outputs[STOCH_SLOWD])) {
+    // Same as TA_STOCH: smooth %K, smooth it again for %D, then align slow
+    // %K with the first slow %D value
+    std::vector<double> slowK(nbFast);
+    int nbSlowK = 0;
+    retCode = TA_MA(0, nbFast - 1, fastK.data(), slowKPeriod,
+                    (TA_MAType)slowKMAType, &outBegIdx, &nbSlowK, slowK.data());
+    int lbTotal = lbK + lbSlowK + lbSlowD;
+    if (retCode == TA_SUCCESS && nbSlowK > lbSlowD) {
+      if (outputs[STOCH_SLOWD]) {
+        retCode = TA_MA(0, nbSlowK - 1, slowK.data(), slowDPeriod,
+                        (TA_MAType)slowDMAType, &outBegIdx, &outNBElement,
+                        outputs[STOCH_SLOWD] + lbTotal);
+      }
+      if (outputs[STOCH_SLOWK]) {
+        std::copy(slowK.begin() + lbSlowD, slowK.begin() + nbSlowK,
+                  outputs[STOCH_SLOWK] + lbTotal);
+      }
+    }
+  }
+  return retCode;
+}
+
+// ---------------------------------------------------------
+// PRICE TRANSFORMS AND TRUE RANGE, FUSED (PRICE_ALL)
+// AVGPRICE, MEDPRICE, TYPPRICE, WCLPRICE and TRANGE are elementwise over
+// the same OHLC bars. They run block by block: a block of inputs is read
+// from memory once and stays in L1 while each requested output is written
+// from it, one branch-free loop per output that the compiler vectorizes.
+// The expressions are TA-Lib's, and this file is built without FMA
+// contraction, so the values round as TA-Lib's do (up to TA-Lib's own
+// contraction, if it was built with it).
+// ---------------------------------------------------------
+static constexpr size_t kPriceBlock = 512;
+
+int price_all(const double *open, const double *high, const double *low,
+              const double *close, size_t size,
+              double *const outputs[PRICE_NB_OUTPUTS]) {
+  double *outAvg = outputs[PRICE_AVGPRICE], *outMed = outputs[PRICE_MEDPRICE];
+  double *outTyp = outputs[PRICE_TYPPRICE], *outWcl = outputs[PRICE_WCLPRICE];
+  double *outTR = outputs[PRICE_TRANGE];
+
+  for (size_t begin = 0; begin < size; begin += kPriceBlock) {
+    const size_t end = std::min(begin + kPriceBlock, size);
+    if (outAvg) {
+      for (size_t i = begin; i < end; ++i)
+        outAvg[i] = (high[i] + low[i] + close[i] + open[i]) / 4;
+    }
+    if (outMed) {
+      for (size_t i = begin; i < end; ++i) outMed[i] = (high[i] + low[i]) / 2.0;
+    }
+    if (outTyp) {
+      for (size_t i = begin; i < end; ++i)
+        outTyp[i] = (high[i] + low[i] + close[i]) / 3.0;
+    }
+    if (outWcl) {
+      for (size_t i = begin; i < end; ++i)
+        outWcl[i] = (high[i] + low[i] + (close[i] * 2.0)) / 4.0;
+    }
+    if (outTR) {
+      // max(H - L, |C[-1] - H|, |C[-1] - L|), compared in TA_TRANGE's order
+      for (size_t i = std::max<size_t>(begin, 1); i < end; ++i) {
+        double greatest = high[i] - low[i];
+        const double toHigh = std::fabs(close[i - 1] - high[i]);
+        greatest = toHigh > greatest ? toHigh : greatest;
+        const double toLow = std::fabs(close[i - 1] - low[i]);
+        outTR[i] = toLow > greatest ? toLow : greatest;
+      }
+    }
+  }
+  return TA_SUCCESS;
+}
+
+// ---------------------------------------------------------
+// HILBERT TRANSFORM FAMILY, FUSED (HT_ALL)
+// TA_HT_DCPERIOD, HT_DCPHASE, HT_PHASOR, HT_SINE, HT_TRENDLINE and
+// HT_TRENDMODE each run the same recursion from the first bar: WMA
+// smoothing, detrender, I/Q components and homodyne period. HilbertTransform
+// runs it once and derives every output from it, with TA-Lib's expressions
+// in TA-Lib's order. The recursion feeds each bar's rounding into the next,
+// so step() relies on this file being built without FMA contraction (see
+// CMakeLists.txt): batch and stream then agree bit for bit, and agree with
+// TA-Lib to rounding.
+// ---------------------------------------------------------
+namespace {
+
+const double kRad2Deg = 45.0 / std::atan(1.0);
+const double kDeg2Rad = 1.0 / kRad2Deg;
+const double kDeg2RadBy360 = std::atan(1.0) * 8.0;
+
+// sin / cos of i * 2pi / n for 0 <= i < n <= 50, the weights of the
+// dominant cycle phase: computed once instead of at every bar. n is at
+// most 50 since the smoothed period is clamped to [6, 50].
+struct PhaseWeights {
+  static constexpr int kMaxPeriod = 50;
+  double sin[kMaxPeriod * (kMaxPeriod + 1) / 2];
+  double cos[kMaxPeriod * (kMaxPeriod + 1) / 2];
+
+  PhaseWeights() {
+    for (int n = 1; n <= kMaxPeriod; ++n) {
+      for (int i = 0; i < n; ++i) {
+        const double angle = ((double)i * kDeg2RadBy360) / (double)n;
+        sin[offset(n) + i] = std::sin(angle);
+        cos[offset(n) + i] = std::cos(angle);
+      }
+    }
+  }
+  static int offset(int n) { return n * (n - 1) / 2; }
+};
+
+const PhaseWeights &phase_weights() {
+  static const PhaseWeights weights;
+  return weights;
+}
+
+} // namespace
+
+void ht_all_lookbacks(int lookbacks[HT_NB_OUTPUTS]) {
+  lookbacks[HT_DCPERIOD_OUT] = TA_HT_DCPERIOD_Lookback();
+  lookbacks[HT_DCPHASE_OUT] = TA_HT_DCPHASE_Lookback();
+  lookbacks[HT_INPHASE] = lookbacks[HT_QUADRATURE] = TA_HT_PHASOR_Lookback();
+  lookbacks[HT_SINE_OUT] = lookbacks[HT_LEADSINE] = TA_HT_SINE_Lookback();
+  lookbacks[HT_TRENDLINE_OUT] = TA_HT_TRENDLINE_Lookback();
+  lookbacks[HT_TRENDMODE_OUT] = TA_HT_TRENDMODE_Lookback();
+}
+
+void HilbertTransform::Hilbert::transform(double input, bool isEven, int idx,
+                                          double adjustment) {
+  const double a = 0.0962, b = 0.5769;
+  double *buffer = isEven ? even : odd;
+  double &prev = isEven ? prevEven : prevOdd;
+  double &prevInput = isEven ? prevInputEven : prevInputOdd;
+  const double hilbertTempReal = a * input;
+  value = -buffer[idx];
+  buffer[idx] = hilbertTempReal;
+  value += hilbertTempReal;
+  value -= prev;
+  prev = b * prevInput;
+  value += prev;
+  prevInput = input;
+  value *= adjustment;
+}
+
+void HilbertTransform::reset() {
+  today_ = 0;
+  std::fill(std::begin(price_), std::end(price_), 0.0);
+  std::fill(std::begin(smoothPrice_), std::end(smoothPrice_), 0.0);
+  priceIdx_ = smoothPriceIdx_ = kWindow - 1;
+  periodWMASub_ = periodWMASum_ = trailingWMAValue_ = 0.0;
+  detrender_ = q1_ = jI_ = jQ_ = Hilbert{};
+  hilbertIdx_ = 0;
+  i1ForOddPrev2_ = i1ForOddPrev3_ = i1ForEvenPrev2_ = i1ForEvenPrev3_ = 0.0;
+  prevI2_ = prevQ2_ = re_ = im_ = period_ = smoothPeriod_ = 0.0;
+  dcPhase_ = sine_ = leadSine_ = iTrend1_ = iTrend2_ = iTrend3_ = 0.0;
+  daysInTrend_ = 0;
+}
+
+void HilbertTransform::step(double value, double outputs[HT_NB_OUTPUTS]) {
+  const size_t today = today_++;
+  priceIdx_ = priceIdx_ == kWindow - 1 ? 0 : priceIdx_ + 1;
+  price_[priceIdx_] = value;
+
+  // 4-3-2-1 WMA of the price: the first 3 bars seed it, bars 3-11 warm up
+  // the smoother and the transform starts at bar 12 (TA-Lib's
+  // INIT_PRICE_WMA / DO_PRICE_WMA)
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  if (today < 3) {
+    periodWMASub_ += value;
+    periodWMASum_ += value * (double)(today + 1);
+    std::fill(outputs, outputs + HT_NB_OUTPUTS, nan);
+    return;
+  }
+  periodWMASub_ += value;
+  periodWMASub_ -= trailingWMAValue_;
+  periodWMASum_ += value * 4.0;
+  trailingWMAValue_ = price_[(priceIdx_ + kWindow - 3) % kWindow];
+  const double smoothedValue = periodWMASum_ * 0.1;
+  periodWMASum_ -= periodWMASub_;
+  if (today < 12) {
+    std::fill(outputs, outputs + HT_NB_OUTPUTS, nan);
+    return;
+  }
+
+  const double adjustedPrevPeriod = (0.075 * period_) + 0.54;
+  smoothPriceIdx_ = smoothPriceIdx_ == kWindow - 1 ? 0 : smoothPriceIdx_ + 1;
+  smoothPrice_[smoothPriceIdx_] = smoothedValue;
+
+  double q2, i2;
+  if ((today % 2) == 0) {
+    detrender_.transform(smoothedValue, true, hilbertIdx_, adjustedPrevPeriod);
+    q1_.transform(detrender_.value, true, hilbertIdx_, adjustedPrevPeriod);
+    outputs[HT_INPHASE] = i1ForEvenPrev3_;
+    outputs[HT_QUADRATURE] = q1_.value;
+    jI_.transform(i1ForEvenPrev3_, true, hilbertIdx_, adjustedPrevPeriod);
+    jQ_.transform(q1_.value, true, hilbertIdx_, adjustedPrevPeriod);
+    if (++hilbertIdx_ == 3) hilbertIdx_ = 0;
+    q2 = (0.2 * (q1_.value + jI_.value)) + (0.8 * prevQ2_);
+    i2 = (0.2 * (i1ForEvenPrev3_ - jQ_.value)) + (0.8 * prevI2_);
+    i1ForOddPrev3_ = i1ForOddPrev2_;
+    i1ForOddPrev2_ = detrender_.value;
+  } else {
+    detrender_.transform(smoothedValue, false, hilbertIdx_,
+                         adjustedPrevPeriod);
+    q1_.transform(detrender_.value, false, hilbertIdx_, adjustedPrevPeriod);
+    outputs[HT_INPHASE] = i1ForOddPrev3_;
+    outputs[HT_QUADRATURE] = q1_.value;
+    jI_.transform(i1ForOddPrev3_, false, hilbertIdx_, adjustedPrevPeriod);
+    jQ_.transform(q1_.value, false, hilbertIdx_, adjustedPrevPeriod);
+    q2 = (0.2 * (q1_.value + jI_.value)) + (0.8 * prevQ2_);
+    i2 = (0.2 * (i1ForOddPrev3_ - jQ_.value)) + (0.8 * prevI2_);
+    i1ForEvenPrev3_ = i1ForEvenPrev2_;
+    i1ForEvenPrev2_ = detrender_.value;
+  }
+
+  // Homodyne discriminator
+  re_ = (0.2 * ((i2 * prevI2_) + (q2 * prevQ2_))) + (0.8 * re_);
+  im_ = (0.2 * ((i2 * prevQ2_) - (q2 * prevI2_))) + (0.8 * im_);
+  prevQ2_ = q2;
+  prevI2_ = i2;
+  double tempReal = period_;
+  if ((im_ != 0.0) && (re_ != 0.0))
+    period_ = 360.0 / (std::atan(im_ / re_) * kRad2Deg);
+  double tempReal2 = 1.5 * tempReal;
+  if (period_ > tempReal2) period_ = tempReal2;
+  tempReal2 = 0.67 * tempReal;
+  if (period_ < tempReal2) period_ = tempReal2;
+  if (period_ < 6)
+    period_ = 6;
+  else if (period_ > 50)
+    period_ = 50;
+  period_ = (0.2 * period_) + (0.8 * tempReal);
+  smoothPeriod_ = (0.33 * period_) + (0.67 * smoothPeriod_);
+  outputs[HT_DCPERIOD_OUT] = smoothPeriod_;
+
+  // Dominant cycle phase over the last DCPeriodInt smoothed prices
+  const int dcPeriodInt = (int)(smoothPeriod_ + 0.5);
+  const double prevDCPhase = dcPhase_;
+  double realPart = 0.0, imagPart = 0.0;
+  int idx = smoothPriceIdx_;
+  if (dcPeriodInt > 0) {
+    const PhaseWeights &weights = phase_weights();
+    const double *sinW = weights.sin + PhaseWeights::offset(dcPeriodInt);
+    const double *cosW = weights.cos + PhaseWeights::offset(dcPeriodInt);
+    for (int i = 0; i < dcPeriodInt; ++i) {
+      realPart += sinW[i] * smoothPrice_[idx];
+      imagPart += cosW[i] * smoothPrice_[idx];
+      idx = idx == 0 ? kWindow - 1 : idx - 1;
+    }
+  }
+  tempReal = std::fabs(imagPart);
+  if (tempReal > 0.0)
+    dcPhase_ = std::atan(realPart / imagPart) * kRad2Deg;
+  else if (tempReal <= 0.01) {
+    if (realPart < 0.0)
+      dcPhase_ -= 90.0;
+    else if (realPart > 0.0)
+      dcPhase_ += 90.0;
+  }
+  dcPhase_ += 90.0;
+  // Lag of the WMA smoother
+  dcPhase_ += 360.0 / smoothPeriod_;
+  if (imagPart < 0.0) dcPhase_ += 180.0;
+  if (dcPhase_ > 315.0) dcPhase_ -= 360.0;
+  outputs[HT_DCPHASE_OUT] = dcPhase_;
+
+  const double prevSine = sine_, prevLeadSine = leadSine_;
+  sine_ = std::sin(dcPhase_ * kDeg2Rad);
+  leadSine_ = std::sin((dcPhase_ + 45) * kDeg2Rad);
+  outputs[HT_SINE_OUT] = sine_;
+  outputs[HT_LEADSINE] = leadSine_;
+
+  // Instantaneous trendline: mean of the last DCPeriodInt prices, then a
+  // 4-3-2-1 WMA of those means. Bars before the first one count as 0.
+  tempReal = 0.0;
+  idx = priceIdx_;
+  for (int i = 0; i < dcPeriodInt; ++i) {
+    tempReal += price_[idx];
+    idx = idx == 0 ? kWindow - 1 : idx - 1;
+  }
+  if (dcPeriodInt > 0) tempReal = tempReal / (double)dcPeriodInt;
+  const double trendline =
+      (4.0 * tempReal + 3.0 * iTrend1_ + 2.0 * iTrend2_ + iTrend3_) / 10.0;
+  iTrend3_ = iTrend2_;
+  iTrend2_ = iTrend1_;
+  iTrend1_ = tempReal;
+  outputs[HT_TRENDLINE_OUT] = trendline;
+
+  // Trend unless the sine crossed its lead lately, or the phase advances
+  // at the cycle's rate - and always when price strays from the trendline
+  int trend = 1;
+  if (((sine_ > leadSine_) && (prevSine <= prevLeadSine)) ||
+      ((sine_ < leadSine_) && (prevSine >= prevLeadSine))) {
+    daysInTrend_ = 0;
+    trend = 0;
+  }
+  daysInTrend_++;
+  if (daysInTrend_ < (0.5 * smoothPeriod_)) trend = 0;
+  tempReal = dcPhase_ - prevDCPhase;
+  if ((smoothPeriod_ != 0.0) && (tempReal > (0.67 * 360.0 / smoothPeriod_)) &&
+      (tempReal < (1.5 * 360.0 / smoothPeriod_)))
+    trend = 0;
+  tempReal = smoothPrice_[smoothPriceIdx_];
+  if ((trendline != 0.0) &&
+      (std::fabs((tempReal - trendline) / trendline) >= 0.015))
+    trend = 1;
+  outputs[HT_TRENDMODE_OUT] = trend;
+}
+
+int ht_all(const double *real, size_t size,
+           double *const outputs[HT_NB_OUTPUTS]) {
+  int lookbacks[HT_NB_OUTPUTS];
+  ht_all_lookbacks(lookbacks);
+  HilbertTransform hilbert;
+  double values[HT_NB_OUTPUTS];
+  for (size_t today = 0; today < size; ++today) {
+    hilbert.step(real[today], values);
+    for (int k = 0; k < HT_NB_OUTPUTS; ++k) {
+      if (outputs[k] && today >= static_cast<size_t>(lookbacks[k]))
+        outputs[k][today] = values[k];
+    }
+  }
+  return TA_SUCCESS;
+}
+
+} // namespace pytafast
@@ -0,0 +1,107 @@
+#pragma once
+// Fused kernels: several related TA-Lib outputs from one pass over the
+// data (DMI_ALL, STOCH_ALL, PRICE_ALL, HT_ALL). Each output matches its
+// standalone TA-Lib function, lookback included.
+//
+// The kernels write every output from its own lookback on, at the bar's
+// index, and leave the bars before it untouched. All return a TA_RetCode.
+#include <cstddef>
+
+namespace pytafast {
+
+enum DmiOutput {
+  DMI_PLUS_DM, DMI_MINUS_DM, DMI_PLUS_DI, DMI_MINUS_DI, DMI_DX, DMI_ADX,
+  DMI_ADXR, DMI_NB_OUTPUTS
+};
+
+// Lookback of each DmiOutput for `period`
+int dmi_all_lookbacks(int period, int lookbacks[DMI_NB_OUTPUTS]);
+
+// Outputs in DmiOutput order, each with room for `size` values
+int dmi_all(const double *high, const double *low, const double *close,
+            size_t size, int period, double *const outputs[DMI_NB_OUTPUTS]);
+
+enum StochOutput {
+  STOCH_FASTK, STOCH_FASTD, STOCH_SLOWK, STOCH_SLOWD, STOCH_WILLR,
+  STOCH_NB_OUTPUTS
+};
+
+// Lookback of each StochOutput for the STOCH_ALL parameters
+int stoch_all_lookbacks(int fastKPeriod, int slowKPeriod, int slowKMAType,
+                        int slowDPeriod, int slowDMAType, int fastDPeriod,
+                        int fastDMAType, int lookbacks[STOCH_NB_OUTPUTS]);
+
+// Outputs in StochOutput order; null ones are not computed. WILLR, like
+// TA_WILLR, needs fastKPeriod >= 2.
+int stoch_all(const double *high, const double *low, const double *close,
+              size_t size, int fastKPeriod, int slowKPeriod, int slowKMAType,
+              int slowDPeriod, int slowDMAType, int fastDPeriod,
+              int fastDMAType, double *const outputs[STOCH_NB_OUTPUTS]);
+
+enum PriceOutput {
+  PRICE_AVGPRICE, PRICE_MEDPRICE, PRICE_TYPPRICE, PRICE_WCLPRICE,
+  PRICE_TRANGE, PRICE_NB_OUTPUTS
+};
+
+// Lookback of a PriceOutput: TRANGE needs the previous close
+constexpr int price_all_lookback(PriceOutput kind) {
+  return kind == PRICE_TRANGE ? 1 : 0;
+}
+
+// Outputs in PriceOutput order; null ones are not computed
+int price_all(const double *open, const double *high, const double *low,
+              const double *close, size_t size,
+              double *const outputs[PRICE_NB_OUTPUTS]);
+
+enum HtOutput {
+  HT_DCPERIOD_OUT, HT_DCPHASE_OUT, HT_INPHASE, HT_QUADRATURE, HT_SINE_OUT,
+  HT_LEADSINE, HT_TRENDLINE_OUT, HT_TRENDMODE_OUT, HT_NB_OUTPUTS
+};
+
+// Lookback of each HtOutput: that of its standalone TA_HT_* function
+void ht_all_lookbacks(int lookbacks[HT_NB_OUTPUTS]);
+
+// The Hilbert transform every TA_HT_* function runs from the first bar of
+// the series: WMA price smoother, detrender, in-phase/quadrature
+// components, homodyne period, dominant cycle phase and trendline. One
+// step per bar; each bar's outputs are those of the standalone functions
+// at that bar (trend mode as 0.0 / 1.0); NaN while the smoother warms up
+// over the first 12 bars.
+class HilbertTransform {
+public:
+  HilbertTransform() { reset(); }
+
+  void step(double value, double outputs[HT_NB_OUTPUTS]);
+  void reset();
+  // Bars stepped through since construction or the last reset
+  size_t bars() const { return today_; }
+
+private:
+  static constexpr int kWindow = 50; // longest dominant cycle
+
+  // Circular buffers of the odd- and even-bar Hilbert transforms of one
+  // series (TA-Lib's HILBERT_VARIABLES)
+  struct Hilbert {
+    double odd[3], even[3];
+    double value, prevOdd, prevEven, prevInputOdd, prevInputEven;
+    void transform(double input, bool isEven, int idx, double adjustment);
+  };
+
+  size_t today_;
+  // Last kWindow prices and smoothed prices, newest at *Idx_
+  double price_[kWindow], smoothPrice_[kWindow];
+  int priceIdx_, smoothPriceIdx_;
+  double periodWMASub_, periodWMASum_, trailingWMAValue_;
+  Hilbert detrender_, q1_, jI_, jQ_;
+  int hilbertIdx_;
+  double i1ForOddPrev2_, i1ForOddPrev3_, i1ForEvenPrev2_, i1ForEvenPrev3_;
+  double prevI2_, prevQ2_, re_, im_, period_, smoothPeriod_;
+  double dcPhase_, sine_, leadSine_, iTrend1_, iTrend2_, iTrend3_;
+  int daysInTrend_;
+};
+
+// Outputs in HtOutput order; null ones are not written
+int ht_all(const double *real, size_t size,
+           double *const outputs[HT_NB_OUTPUTS]);
+
+} // namespace pytafast
@@ -0,0 +1,140 @@
+// Native indicator plugins (include/pytafast/plugin.h): loading a library
+// and registering its function table next to the TA-Lib functions
+#include <pytafast/core.h>
+#include <pytafast/plugin.h>
+#include <cctype>
+#include <map>
+#include <mutex>
+#include <set>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+namespace pytafast {
+namespace {
+
+#ifdef _WIN32
+using Library = HMODULE;
+
+Library open_library(const std::string &path) {
+  Library library = LoadLibraryA(path.c_str());
+  if (!library)
+    throw std::invalid_argument("cannot load plugin '" + path + "' (error " +
+                                std::to_string(GetLastError()) + ")");
+  return library;
+}
+
+void *find_symbol(Library library, const char *name) {
+  return reinterpret_cast<void *>(GetProcAddress(library, name));
+}
+
+void close_library(Library library) { FreeLibrary(library); }
+#else
+using Library = void *;
+
+Library open_library(const std::string &path) {
+  Library library = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+  if (!library)
+    throw std::invalid_argument("cannot load plugin '" + path +
+                                "': " + dlerror());
+  return library;
+}
+
+void *find_symbol(Library library, const char *name) {
+  return dlsym(library, name);
+}
+
+void close_library(Library library) { dlclose(library); }
+#endif
+
+ParamType param_type(const pytafast_function &f, const pytafast_param &p) {
+  switch (p.type) {
+  case PYTAFAST_PARAM_INT:
+    return ParamType::Int;
+  case PYTAFAST_PARAM_REAL:
+    return ParamType::Real;
+  case PYTAFAST_PARAM_MATYPE:
+    return ParamType::MAType;
+  }
+  throw std::invalid_argument(std::string(f.name) + ": parameter '" +
+                              p.name + "' has an unknown type " +
+                              std::to_string(p.type));
+}
+
+// The table entry for `f`, checked but not registered yet
+FunctionInfo function_info(const pytafast_function &f) {
+  if (!f.name || !*f.name)
+    throw std::invalid_argument("plugin function without a name");
+  if (f.n_inputs <= 0 || f.n_outputs <= 0 || f.n_params < 0 || !f.inputs ||
+      !f.outputs || (f.n_params > 0 && !f.params) || !f.lookback ||
+      !f.compute)
+    throw std::invalid_argument(
+        std::string(f.name) + ": a plugin function needs inputs, outputs, "
+                              "a lookback and a compute function");
+  FunctionInfo fn{f.name,
+                  f.group ? f.group : "Custom",
+                  {f.inputs, f.inputs + f.n_inputs},
+                  {f.outputs, f.outputs + f.n_outputs},
+                  f.integer_output != 0,
+                  {},
+                  f.lookback,
+                  f.compute,
+                  f.windowed != 0};
+  for (int j = 0; j < f.n_params; ++j)
+    fn.params.push_back(
+        {f.params[j].name, param_type(f, f.params[j]),
+         f.params[j].default_value});
+  return fn;
+}
+
+} // namespace
+
+std::vector<const FunctionInfo *> load_plugin(const std::string &path) {
+  static std::mutex mutex;
+  static std::map<Library, std::vector<const FunctionInfo *>> loaded;
+  std::lock_guard<std::mutex> lock(mutex);
+
+  Library library = open_library(path);
+  auto it = loaded.find(library);
+  if (it != loaded.end()) return it->second;
+
+  // Nothing is registered until the whole table checks out, so a bad
+  // plugin can be unloaded again
+  std::vector<FunctionInfo> functions;
+  try {
+    auto entry = reinterpret_cast<pytafast_plugin_entry_fn>(
+        find_symbol(library, PYTAFAST_PLUGIN_ENTRY));
+    if (!entry)
+      throw std::invalid_argument("'" + path + "' does not export " +
+                                  PYTAFAST_PLUGIN_ENTRY);
+    const pytafast_plugin *plugin = entry();
+    if (!plugin || plugin->abi_version != PYTAFAST_PLUGIN_ABI)
+      throw std::invalid_argument(
+          "'" + path + "' was built for plugin ABI " +
+          (plugin ? std::to_string(plugin->abi_version) : "?") +
+          ", expected " + std::to_string(PYTAFAST_PLUGIN_ABI));
+    std::set<std::string> names;
+    for (int i = 0; i < plugin->n_functions; ++i) {
+      FunctionInfo fn = function_info(plugin->functions[i]);
+      std::string upper = fn.name;
+      for (char &c : upper) c = static_cast<char>(std::toupper(c));
+      if (lookup_function(fn.name) || !names.insert(upper).second)
+        throw std::invalid_argument("function '" + std::string(fn.name) +
+                                    "' is already registered");
+      functions.push_back(std::move(fn));
+    }
+  } catch (...) {
+    close_library(library);
+    throw;
+  }
+
+  std::vector<const FunctionInfo *> registered;
+  for (auto &fn : functions)
+    registered.push_back(&register_function(std::move(fn)));
+  loaded[library] = registered;
+  return registered;
+}
+
+} // namespace pytafast
@@ -0,0 +1,452 @@
+// Function metadata registry: one table describing every public function -
+// its inputs and outputs under their public names, its parameters with
+// defaults, its TA-Lib lookback and how to run it over raw buffers.
+// Exposed to Python as pytafast.lookback / function_info / function_names
+// (../registry.cpp). Functions registered at run time (plugins) are kept
+// beside the table and found by the same lookups.
+//
+// The table describes the functions; it does not generate their bindings.
+// Only the functions of function_list.h come from one line each. Every
+// other entry below has its binding in pytafast_ext.cpp (and its group
+// file) and its Python wrapper in pytafast/__init__.py written out by hand;
+// test_registry_covers_public_api checks that the three agree on names.
+#include "function_list.h"
+#include "fused.h"
+#include <pytafast/core.h>
+#include <algorithm>
+#include <cctype>
+#include <deque>
+#include <mutex>
+#include <ta_libc.h>
+#include <unordered_map>
+
+namespace pytafast {
+namespace {
+
+// Parameter values as the TA-Lib functions take them
+#define P_INT(k) static_cast<int>(p[k])
+#define P_MA(k) static_cast<TA_MAType>(static_cast<int>(p[k]))
+#define LB(EXPR)                                                               \
+  [](const double *p) -> int {                                                 \
+    (void)p;                                                                   \
+    return EXPR;                                                               \
+  }
+// A ComputeFn around one call: in[j] is input j, R(k) / I(k) float / integer
+// output k from the first bar past the lookback, b and n the TA-Lib
+// outBegIdx and outNBElement
+#define RUN(CALL)                                                              \
+  [](int size, int lookback, const double *const *in, const double *p,         \
+     void *const *out) -> int {                                                \
+    (void)in, (void)p, (void)lookback;                                         \
+    int b = 0, n = 0;                                                          \
+    return CALL;                                                               \
+  }
+#define R(k) (static_cast<double *>(out[k]) + lookback)
+#define I(k) (static_cast<int *>(out[k]) + lookback)
+
+constexpr const char *OVERLAP = "Overlap Studies";
+constexpr const char *MOMENTUM = "Momentum Indicators";
+constexpr const char *VOLATILITY = "Volatility Indicators";
+constexpr const char *VOLUME = "Volume Indicators";
+constexpr const char *PRICE = "Price Transform";
+constexpr const char *STATISTIC = "Statistic Functions";
+constexpr const char *MATH_OP = "Math Operators";
+constexpr const char *MATH_TRANSFORM = "Math Transform";
+constexpr const char *CYCLE = "Cycle Indicators";
+constexpr const char *PATTERN = "Pattern Recognition";
+
+ParamInfo period(const char *name, double def) {
+  return {name, ParamType::Int, def};
+}
+ParamInfo real(const char *name, double def) {
+  return {name, ParamType::Real, def};
+}
+ParamInfo matype(const char *name) { return {name, ParamType::MAType, 0}; }
+
+// The fused kernels write each output from its own lookback at the bar's
+// index, so they get the outputs at bar 0
+int run_dmi_all(int size, int, const double *const *in, const double *p,
+                void *const *out) {
+  double *outputs[DMI_NB_OUTPUTS];
+  for (int k = 0; k < DMI_NB_OUTPUTS; ++k)
+    outputs[k] = static_cast<double *>(out[k]);
+  return dmi_all(in[0], in[1], in[2], size, P_INT(0), outputs);
+}
+
+int run_stoch_all(int size, int, const double *const *in, const double *p,
+                  void *const *out) {
+  double *outputs[STOCH_NB_OUTPUTS];
+  for (int k = 0; k < STOCH_NB_OUTPUTS; ++k)
+    outputs[k] = static_cast<double *>(out[k]);
+  return stoch_all(in[0], in[1], in[2], size, P_INT(0), P_INT(1), P_INT(2),
+                   P_INT(3), P_INT(4), P_INT(5), P_INT(6), outputs);
+}
+
+int run_price_all(int size, int, const double *const *in, const double *,
+                  void *const *out) {
+  double *outputs[PRICE_NB_OUTPUTS];
+  for (int k = 0; k < PRICE_NB_OUTPUTS; ++k)
+    outputs[k] = static_cast<double *>(out[k]);
+  return price_all(in[0], in[1], in[2], in[3], size, outputs);
+}
+
+int run_ht_all(int size, int, const double *const *in, const double *,
+               void *const *out) {
+  double *outputs[HT_NB_OUTPUTS];
+  for (int k = 0; k < HT_NB_OUTPUTS; ++k)
+    outputs[k] = static_cast<double *>(out[k]);
+  return ht_all(in[0], size, outputs);
+}
+
+// Indexes before the lookback are -1, as in Python
+int run_minmaxindex(int size, int lookback, const double *const *in,
+                    const double *p, void *const *out) {
+  for (int k = 0; k < 2; ++k) {
+    int *idx = static_cast<int *>(out[k]);
+    std::fill(idx, idx + std::min(lookback, size), -1);
+  }
+  int b = 0, n = 0;
+  return TA_MINMAXINDEX(0, size - 1, in[0], P_INT(0), &b, &n, I(0), I(1));
+}
+
+// Entries for the function table's calling conventions (function_list.h)
+#define SINGLE(NAME, FUNC, GROUP, DEF)                                         \
+  {#NAME, GROUP, {"inReal"}, {"real"}, false, {period("timeperiod", DEF)},     \
+   LB(TA_##NAME##_Lookback(P_INT(0))),                                         \
+   RUN(TA_##NAME(0, size - 1, in[0], P_INT(0), &b, &n, R(0)))},
+#define SINGLE_NP(NAME, FUNC, GROUP)                                           \
+  {#NAME, GROUP, {"inReal"}, {"real"}, false, {}, LB(TA_##NAME##_Lookback()),  \
+   RUN(TA_##NAME(0, size - 1, in[0], &b, &n, R(0)))},
+#define HL(NAME, FUNC, GROUP, DEF)                                             \
+  {#NAME, GROUP, {"inHigh", "inLow"}, {"real"}, false,                         \
+   {period("timeperiod", DEF)}, LB(TA_##NAME##_Lookback(P_INT(0))),            \
+   RUN(TA_##NAME(0, size - 1, in[0], in[1], P_INT(0), &b, &n, R(0)))},
+#define HLC(NAME, FUNC, GROUP, DEF)                                            \
+  {#NAME, GROUP, {"inHigh", "inLow", "inClose"}, {"real"}, false,              \
+   {period("timeperiod", DEF)}, LB(TA_##NAME##_Lookback(P_INT(0))),            \
+   RUN(TA_##NAME(0, size - 1, in[0], in[1], in[2], P_INT(0), &b, &n, R(0)))},
+#define DUAL(NAME, FUNC, GROUP, DEF)                                           \
+  {#NAME, GROUP, {"inReal0", "inReal1"}, {"real"}, false,                      \
+   {period("timeperiod", DEF)}, LB(TA_##NAME##_Lookback(P_INT(0))),            \
+   RUN(TA_##NAME(0, size - 1, in[0], in[1], P_INT(0), &b, &n, R(0)))},
+#define DUAL_NP(NAME, FUNC, GROUP, IN0, IN1)                                   \
+  {#NAME, GROUP, {"inReal0", "inReal1"}, {"real"}, false, {},                  \
+   LB(TA_##NAME##_Lookback()),                                                 \
+   RUN(TA_##NAME(0, size - 1, in[0], in[1], &b, &n, R(0)))},
+#define CDL(NAME, FUNC)                                                        \
+  {#NAME, PATTERN, {"inOpen", "inHigh", "inLow", "inClose"}, {"integer"},      \
+   true, {}, LB(TA_##NAME##_Lookback()),                                       \
+   RUN(TA_##NAME(0, size - 1, in[0], in[1], in[2], in[3], &b, &n, I(0)))},
+#define CDL_PEN(NAME, FUNC, DEF)                                               \
+  {#NAME, PATTERN, {"inOpen", "inHigh", "inLow", "inClose"}, {"integer"},      \
+   true, {real("penetration", DEF)}, LB(TA_##NAME##_Lookback(p[0])),           \
+   RUN(TA_##NAME(0, size - 1, in[0], in[1], in[2], in[3], p[0], &b, &n,       \
+                 I(0)))},
+
+std::vector<FunctionInfo> build_table() {
+  return {
+      // --- The function table ---
+      PYTAFAST_SINGLE(SINGLE)
+      PYTAFAST_SINGLE_NP(SINGLE_NP)
+      PYTAFAST_MATH(SINGLE_NP)
+      PYTAFAST_HL(HL)
+      PYTAFAST_HLC(HLC)
+      PYTAFAST_DUAL(DUAL)
+      PYTAFAST_DUAL_NP(DUAL_NP)
+      PYTAFAST_CDL(CDL)
+      PYTAFAST_CDL_PEN(CDL_PEN)
+
+      // --- Overlap Studies ---
+      {"MA", OVERLAP, {"inReal"}, {"real"}, false,
+       {period("timeperiod", 30), matype("matype")},
+       LB(TA_MA_Lookback(P_INT(0), P_MA(1))),
+       RUN(TA_MA(0, size - 1, in[0], P_INT(0), P_MA(1), &b, &n, R(0)))},
+      {"T3", OVERLAP, {"inReal"}, {"real"}, false,
+       {period("timeperiod", 5), real("vfactor", 0.7)},
+       LB(TA_T3_Lookback(P_INT(0), p[1])),
+       RUN(TA_T3(0, size - 1, in[0], P_INT(0), p[1], &b, &n, R(0)))},
+      {"BBANDS", OVERLAP, {"inReal"},
+       {"upperband", "middleband", "lowerband"}, false,
+       {period("timeperiod", 5), real("nbdevup", 2.0), real("nbdevdn", 2.0),
+        matype("matype")},
+       LB(TA_BBANDS_Lookback(P_INT(0), p[1], p[2], P_MA(3))),
+       RUN(TA_BBANDS(0, size - 1, in[0], P_INT(0), p[1], p[2], P_MA(3), &b,
+                     &n, R(0), R(1), R(2)))},
+      {"SAR", OVERLAP, {"inHigh", "inLow"}, {"real"}, false,
+       {real("acceleration", 0.02), real("maximum", 0.2)},
+       LB(TA_SAR_Lookback(p[0], p[1])),
+       RUN(TA_SAR(0, size - 1, in[0], in[1], p[0], p[1], &b, &n, R(0)))},
+
+      // --- Momentum Indicators ---
+      {"APO", MOMENTUM, {"inReal"}, {"real"}, false,
+       {period("fastperiod", 12), period("slowperiod", 26), matype("matype")},
+       LB(TA_APO_Lookback(P_INT(0), P_INT(1), P_MA(2))),
+       RUN(TA_APO(0, size - 1, in[0], P_INT(0), P_INT(1), P_MA(2), &b, &n,
+                  R(0)))},
+      {"PPO", MOMENTUM, {"inReal"}, {"real"}, false,
+       {period("fastperiod", 12), period("slowperiod", 26), matype("matype")},
+       LB(TA_PPO_Lookback(P_INT(0), P_INT(1), P_MA(2))),
+       RUN(TA_PPO(0, size - 1, in[0], P_INT(0), P_INT(1), P_MA(2), &b, &n,
+                  R(0)))},
+      {"MACD", MOMENTUM, {"inReal"}, {"macd", "macdsignal", "macdhist"}, false,
+       {period("fastperiod", 12), period("slowperiod", 26),
+        period("signalperiod", 9)},
+       LB(TA_MACD_Lookback(P_INT(0), P_INT(1), P_INT(2))),
+       RUN(TA_MACD(0, size - 1, in[0], P_INT(0), P_INT(1), P_INT(2), &b, &n,
+                   R(0), R(1), R(2)))},
+      {"MACDEXT", MOMENTUM, {"inReal"}, {"macd", "macdsignal", "macdhist"},
+       false,
+       {period("fastperiod", 12), matype("fastmatype"),
+        period("slowperiod", 26), matype("slowmatype"),
+        period("signalperiod", 9), matype("signalmatype")},
+       LB(TA_MACDEXT_Lookback(P_INT(0), P_MA(1), P_INT(2), P_MA(3), P_INT(4),
+                              P_MA(5))),
+       RUN(TA_MACDEXT(0, size - 1, in[0], P_INT(0), P_MA(1), P_INT(2),
+                      P_MA(3), P_INT(4), P_MA(5), &b, &n, R(0), R(1),
+                      R(2)))},
+      {"MACDFIX", MOMENTUM, {"inReal"}, {"macd", "macdsignal", "macdhist"},
+       false, {period("signalperiod", 9)}, LB(TA_MACDFIX_Lookback(P_INT(0))),
+       RUN(TA_MACDFIX(0, size - 1, in[0], P_INT(0), &b, &n, R(0), R(1),
+                      R(2)))},
+      {"STOCH", MOMENTUM, {"inHigh", "inLow", "inClose"}, {"slowk", "slowd"},
+       false,
+       {period("fastk_period", 5), period("slowk_period", 3),
+        matype("slowk_matype"), period("slowd_period", 3),
+        matype("slowd_matype")},
+       LB(TA_STOCH_Lookback(P_INT(0), P_INT(1), P_MA(2), P_INT(3), P_MA(4))),
+       RUN(TA_STOCH(0, size - 1, in[0], in[1], in[2], P_INT(0), P_INT(1),
+                    P_MA(2), P_INT(3), P_MA(4), &b, &n, R(0), R(1)))},
+      {"STOCHF", MOMENTUM, {"inHigh", "inLow", "inClose"}, {"fastk", "fastd"},
+       false,
+       {period("fastk_period", 5), period("fastd_period", 3),
+        matype("fastd_matype")},
+       LB(TA_STOCHF_Lookback(P_INT(0), P_INT(1), P_MA(2))),
+       RUN(TA_STOCHF(0, size - 1, in[0], in[1], in[2], P_INT(0), P_INT(1),
+                     P_MA(2), &b, &n, R(0), R(1)))},
+      {"STOCHRSI", MOMENTUM, {"inReal"}, {"fastk", "fastd"}, false,
+       {period("timeperiod", 14), period("fastk_period", 5),
+        period("fastd_period", 3), matype("fastd_matype")},
+       LB(TA_STOCHRSI_Lookback(P_INT(0), P_INT(1), P_INT(2), P_MA(3))),
+       RUN(TA_STOCHRSI(0, size - 1, in[0], P_INT(0), P_INT(1), P_INT(2),
+                       P_MA(3), &b, &n, R(0), R(1)))},
+      // Every output it can produce; `outputs=` picks a subset in any order
+      {"STOCH_ALL", MOMENTUM, {"inHigh", "inLow", "inClose"},
+       {"fastk", "fastd", "slowk", "slowd", "willr"}, false,
+       {period("fastk_period", 5), period("slowk_period", 3),
+        matype("slowk_matype"), period("slowd_period", 3),
+        matype("slowd_matype"), period("fastd_period", 3),
+        matype("fastd_matype")},
+       LB(std::max({TA_STOCH_Lookback(P_INT(0), P_INT(1), P_MA(2), P_INT(3),
+                                      P_MA(4)),
+                    TA_STOCHF_Lookback(P_INT(0), P_INT(5), P_MA(6)),
+                    TA_WILLR_Lookback(P_INT(0))})),
+       run_stoch_all},
+      {"AROON", MOMENTUM, {"inHigh", "inLow"}, {"aroondown", "aroonup"}, false,
+       {period("timeperiod", 14)}, LB(TA_AROON_Lookback(P_INT(0))),
+       RUN(TA_AROON(0, size - 1, in[0], in[1], P_INT(0), &b, &n, R(0),
+                    R(1)))},
+      {"MFI", MOMENTUM, {"inHigh", "inLow", "inClose", "inVolume"}, {"real"},
+       false, {period("timeperiod", 14)}, LB(TA_MFI_Lookback(P_INT(0))),
+       RUN(TA_MFI(0, size - 1, in[0], in[1], in[2], in[3], P_INT(0), &b, &n,
+                  R(0)))},
+      {"ULTOSC", MOMENTUM, {"inHigh", "inLow", "inClose"}, {"real"}, false,
+       {period("timeperiod1", 7), period("timeperiod2", 14),
+        period("timeperiod3", 28)},
+       LB(TA_ULTOSC_Lookback(P_INT(0), P_INT(1), P_INT(2))),
+       RUN(TA_ULTOSC(0, size - 1, in[0], in[1], in[2], P_INT(0), P_INT(1),
+                     P_INT(2), &b, &n, R(0)))},
+      {"BOP", MOMENTUM, {"inOpen", "inHigh", "inLow", "inClose"}, {"real"},
+       false, {}, LB(TA_BOP_Lookback()),
+       RUN(TA_BOP(0, size - 1, in[0], in[1], in[2], in[3], &b, &n, R(0)))},
+      {"DMI_ALL", MOMENTUM, {"inHigh", "inLow", "inClose"},
+       {"plus_dm", "minus_dm", "plus_di", "minus_di", "dx", "adx", "adxr"},
+       false, {period("timeperiod", 14)}, LB(TA_ADXR_Lookback(P_INT(0))),
+       run_dmi_all},
+
+      // --- Volatility Indicators ---
+      {"TRANGE", VOLATILITY, {"inHigh", "inLow", "inClose"}, {"real"}, false,
+       {}, LB(TA_TRANGE_Lookback()),
+       RUN(TA_TRANGE(0, size - 1, in[0], in[1], in[2], &b, &n, R(0)))},
+
+      // --- Volume Indicators ---
+      {"AD", VOLUME, {"inHigh", "inLow", "inClose", "inVolume"}, {"real"},
+       false, {}, LB(TA_AD_Lookback()),
+       RUN(TA_AD(0, size - 1, in[0], in[1], in[2], in[3], &b, &n, R(0)))},
+      {"ADOSC", VOLUME, {"inHigh", "inLow", "inClose", "inVolume"}, {"real"},
+       false, {period("fastperiod", 3), period("slowperiod", 10)},
+       LB(TA_ADOSC_Lookback(P_INT(0), P_INT(1))),
+       RUN(TA_ADOSC(0, size - 1, in[0], in[1], in[2], in[3], P_INT(0),
+                    P_INT(1), &b, &n, R(0)))},
+
+      // --- Price Transform ---
+      {"AVGPRICE", PRICE, {"inOpen", "inHigh", "inLow", "inClose"}, {"real"},
+       false, {}, LB(TA_AVGPRICE_Lookback()),
+       RUN(TA_AVGPRICE(0, size - 1, in[0], in[1], in[2], in[3], &b, &n,
+                       R(0)))},
+      {"TYPPRICE", PRICE, {"inHigh", "inLow", "inClose"}, {"real"}, false, {},
+       LB(TA_TYPPRICE_Lookback()),
+       RUN(TA_TYPPRICE(0, size - 1, in[0], in[1], in[2], &b, &n, R(0)))},
+      {"WCLPRICE", PRICE, {"inHigh", "inLow", "inClose"}, {"real"}, false, {},
+       LB(TA_WCLPRICE_Lookback()),
+       RUN(TA_WCLPRICE(0, size - 1, in[0], in[1], in[2], &b, &n, R(0)))},
+      // Every output it can produce; `outputs=` picks a subset in any order
+      {"PRICE_ALL", PRICE, {"inOpen", "inHigh", "inLow", "inClose"},
+       {"avgprice", "medprice", "typprice", "wclprice", "trange"}, false, {},
+       LB(TA_TRANGE_Lookback()), run_price_all},
+
+      // --- Statistic Functions ---
+      {"STDDEV", STATISTIC, {"inReal"}, {"real"}, false,
+       {period("timeperiod", 5), real("nbdev", 1.0)},
+       LB(TA_STDDEV_Lookback(P_INT(0), p[1])),
+       RUN(TA_STDDEV(0, size - 1, in[0], P_INT(0), p[1], &b, &n, R(0)))},
+      {"VAR", STATISTIC, {"inReal"}, {"real"}, false,
+       {period("timeperiod", 5), real("nbdev", 1.0)},
+       LB(TA_VAR_Lookback(P_INT(0), p[1])),
+       RUN(TA_VAR(0, size - 1, in[0], P_INT(0), p[1], &b, &n, R(0)))},
+      {"MINMAX", STATISTIC, {"inReal"}, {"min", "max"}, false,
+       {period("timeperiod", 30)}, LB(TA_MINMAX_Lookback(P_INT(0))),
+       RUN(TA_MINMAX(0, size - 1, in[0], P_INT(0), &b, &n, R(0), R(1)))},
+      {"MINMAXINDEX", STATISTIC, {"inReal"}, {"minidx", "maxidx"}, true,
+       {period("timeperiod", 30)}, LB(TA_MINMAXINDEX_Lookback(P_INT(0))),
+       run_minmaxindex},
+
+      // --- Cycle Indicators ---
+      {"HT_TRENDMODE", CYCLE, {"inReal"}, {"integer"}, true, {},
+       LB(TA_HT_TRENDMODE_Lookback()),
+       RUN(TA_HT_TRENDMODE(0, size - 1, in[0], &b, &n, I(0)))},
+      {"HT_PHASOR", CYCLE, {"inReal"}, {"inphase", "quadrature"}, false, {},
+       LB(TA_HT_PHASOR_Lookback()),
+       RUN(TA_HT_PHASOR(0, size - 1, in[0], &b, &n, R(0), R(1)))},
+      {"HT_SINE", CYCLE, {"inReal"}, {"sine", "leadsine"}, false, {},
+       LB(TA_HT_SINE_Lookback()),
+       RUN(TA_HT_SINE(0, size - 1, in[0], &b, &n, R(0), R(1)))},
+      // HT_DCPERIOD, HT_DCPHASE, HT_PHASOR, HT_SINE, HT_TRENDLINE and
+      // HT_TRENDMODE from one Hilbert transform; trendmode as 0.0 / 1.0
+      {"HT_ALL", CYCLE, {"inReal"},
+       {"dcperiod", "dcphase", "inphase", "quadrature", "sine", "leadsine",
+        "trendline", "trendmode"},
+       false, {}, LB(TA_HT_TRENDMODE_Lookback()), run_ht_all},
+  };
+}
+
+#undef SINGLE
+#undef SINGLE_NP
+#undef HL
+#undef HLC
+#undef DUAL
+#undef DUAL_NP
+#undef CDL
+#undef CDL_PEN
+#undef RUN
+#undef R
+#undef I
+#undef LB
+#undef P_INT
+#undef P_MA
+
+// Windowed functions (see FunctionInfo::windowed). Recursive indicators
+// (EMA, RSI, ATR, ...), cumulative ones (AD, OBV), MINMAXINDEX (absolute
+// positions) and functions whose state depends on a matype are not.
+constexpr const char *WINDOWED[] = {
+    "SMA", "WMA", "TRIMA", "MIDPOINT", "MIDPRICE", "MOM", "ROC", "ROCP", "ROCR",
+    "ROCR100", "WILLR", "CCI", "MFI", "ULTOSC", "AROON", "AROONOSC", "BOP",
+    "TRANGE", "AVGPRICE", "MEDPRICE", "TYPPRICE", "WCLPRICE", "PRICE_ALL",
+    "STDDEV", "VAR", "BETA", "CORREL", "LINEARREG", "LINEARREG_ANGLE",
+    "LINEARREG_INTERCEPT", "LINEARREG_SLOPE", "TSF", "AVGDEV", "MAX", "MIN",
+    "SUM", "MINMAX", "ADD", "SUB", "MULT", "DIV", "ACOS", "ASIN", "ATAN",
+    "CEIL", "COS", "COSH", "EXP", "FLOOR", "LN", "LOG10", "SIN", "SINH", "SQRT",
+    "TAN", "TANH",
+};
+
+} // namespace
+
+const std::vector<FunctionInfo> &function_table() {
+  static const std::vector<FunctionInfo> table = [] {
+    std::vector<FunctionInfo> table = build_table();
+    for (auto &fn : table)
+      for (const char *name : WINDOWED)
+        fn.windowed |= std::string(name) == fn.name;
+    return table;
+  }();
+  return table;
+}
+
+namespace {
+
+std::string upper_case(std::string name) {
+  for (char &c : name) c = static_cast<char>(std::toupper(c));
+  return name;
+}
+
+// Functions added by register_function / load_plugin. A deque, so the
+// references handed out stay valid as it grows.
+struct Registered {
+  std::mutex mutex;
+  std::deque<FunctionInfo> functions;
+  std::unordered_map<std::string, const FunctionInfo *> index; // upper case
+};
+
+Registered &registered() {
+  static Registered registered;
+  return registered;
+}
+
+} // namespace
+
+const FunctionInfo *lookup_function(const std::string &name) {
+  // Cached calls look their function up on every call
+  static const auto index = [] {
+    std::unordered_map<std::string, const FunctionInfo *> index;
+    for (const auto &fn : function_table()) index[fn.name] = &fn;
+    return index;
+  }();
+  auto it = index.find(name);
+  if (it != index.end()) return it->second;
+  std::string upper = upper_case(name);
+  it = index.find(upper);
+  if (it != index.end()) return it->second;
+
+  Registered &r = registered();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  it = r.index.find(upper);
+  return it == r.index.end() ? nullptr : it->second;
+}
+
+const FunctionInfo &find_function(const std::string &name) {
+  if (const FunctionInfo *fn = lookup_function(name)) return *fn;
+  throw std::invalid_argument("unknown function '" + name + "'");
+}
+
+const FunctionInfo &register_function(FunctionInfo fn) {
+  std::string name = fn.name ? fn.name : "";
+  if (name.empty())
+    throw std::invalid_argument("a registered function needs a name");
+  if (fn.inputs.empty() || fn.outputs.empty() || !fn.lookback || !fn.compute)
+    throw std::invalid_argument(
+        name + ": a registered function needs inputs, outputs, a lookback "
+               "and a compute function");
+  if (!fn.group) fn.group = "Custom";
+
+  std::string upper = upper_case(name);
+  Registered &r = registered();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  bool builtin = false;
+  for (const auto &table_fn : function_table())
+    builtin |= upper == table_fn.name;
+  if (builtin || r.index.count(upper))
+    throw std::invalid_argument("function '" + name +
+                                "' is already registered");
+  r.functions.push_back(std::move(fn));
+  r.index[upper] = &r.functions.back();
+  return r.functions.back();
+}
+
+std::vector<const FunctionInfo *> registered_functions() {
+  Registered &r = registered();
+  std::lock_guard<std::mutex> lock(r.mutex);
+  std::vector<const FunctionInfo *> functions;
+  for (const auto &fn : r.functions) functions.push_back(&fn);
+  return functions;
+}
+
+} // namespace pytafast
@@ -0,0 +1,355 @@
+#pragma once
+// Python-facing dispatch for the public API (pytafast_ext.api).
+//
+// Every function is registered as two overloads under the public argument
+// names. The first binds float64 C-contiguous numpy arrays straight to the
+// kernel, so the common call goes vectorcall -> C++ with no Python frame.
+// The second accepts anything else (pandas Series, Arrow arrays, DLPack
+// tensors, lists, other dtypes, strided views), converts it with
+// to_double_array and hands a Series back with the caller's index when the
+// index source was one. Only the second takes the keyword-only nan_policy,
+// so passing it skips the first at overload resolution. Both go through the
+// result cache (cache.h) when it is enabled; the first only checks a flag
+// otherwise. Calls are counted under `name` in PYTAFAST_STATS builds.
+#include "arrow.h"
+#include "cache.h"
+#include "common.h"
+#include "nan_policy.h"
+
+// Cached for the life of the process (deliberately never released)
+inline nb::handle numpy_attr(const char *name) {
+  nb::object attr = nb::module_::import_("numpy").attr(name);
+  return attr.release();
+}
+
+// pandas is never imported from here: if the user has not imported it,
+// nothing they pass can be a Series
+inline nb::handle pandas_series_type() {
+  static nb::handle series;
+  if (!series.is_valid()) {
+    nb::dict modules =
+        nb::borrow<nb::dict>(nb::module_::import_("sys").attr("modules"));
+    if (!modules.contains("pandas")) return nb::handle();
+    nb::object type = modules["pandas"].attr("Series");
+    series = type.release();
+  }
+  return series;
+}
+
+inline bool is_pandas_series(nb::handle obj) {
+  nb::handle series = pandas_series_type();
+  return series.is_valid() &&
+         PyObject_IsInstance(obj.ptr(), series.ptr()) == 1;
+}
+
+// Any 1-D input as a float64 C-contiguous array, without copying when the
+// source allows it:
+//   - numpy / DLPack / buffer-protocol objects already float64 and contiguous
+//   - Arrow arrays and streams (pyarrow, Polars, ...) via the C Data Interface
+// pandas and everything else go through np.ascontiguousarray(obj, float64).
+inline DoubleArrayIN to_double_array(nb::handle obj) {
+  DoubleArrayIN arr;
+  if (nb::try_cast(obj, arr, false)) return arr;
+  if (!is_pandas_series(obj)) {
+    if (nb::hasattr(obj, "__arrow_c_array__")) return import_arrow_array(obj);
+    if (nb::hasattr(obj, "__arrow_c_stream__"))
+      return import_arrow_stream(obj);
+  }
+  static nb::handle ascontiguousarray = numpy_attr("ascontiguousarray");
+  static nb::handle float64 = numpy_attr("float64");
+  return nb::cast<DoubleArrayIN>(
+      ascontiguousarray(obj, nb::arg("dtype") = float64));
+}
+
+// Conversion state for one call on the slow path
+class SeriesArgs {
+public:
+  // `source` is the input whose pandas index (if any) the result inherits
+  explicit SeriesArgs(nb::handle source) {
+    if (is_pandas_series(source)) index_ = source.attr("index");
+  }
+
+  DoubleArrayIN operator()(nb::handle obj) { return to_double_array(obj); }
+
+  template <typename Out> nb::object wrap(Out &&out, const char *name) {
+    nb::object result = nb::cast(std::forward<Out>(out));
+    if (!index_.is_valid()) return result;
+    return pandas_series_type()(result, nb::arg("index") = index_,
+                                nb::arg("name") = name);
+  }
+
+private:
+  nb::object index_;
+};
+
+// One template per calling convention, mirroring the old Python factories.
+// `name` must outlive the module (pass a literal); it also names the Series.
+
+#define NAN_POLICY_ARG nb::kw_only(), nb::arg("nan_policy") = "propagate"
+
+template <auto Fn>
+void def_single(nb::module_ &m, const char *name, const char *doc,
+                int timeperiod) {
+  m.def(
+      name,
+      [name](DoubleArrayIN inReal, int timeperiod) -> nb::object {
+        PYTAFAST_CALL_SCOPE(name);
+        if (!ResultCache::enabled()) return nb::cast(Fn(inReal, timeperiod));
+        return cached_call(name, {double(timeperiod)}, NanPolicy::Propagate,
+                           {inReal}, [&](const NanInputs &in) {
+                             return Fn(in[0], timeperiod);
+                           });
+      },
+      nb::arg("inReal").noconvert(), nb::arg("timeperiod") = timeperiod, doc);
+  m.def(
+      name,
+      [name](nb::handle inReal, int timeperiod, const std::string &nan_policy) {
+        PYTAFAST_CALL_SCOPE(name);
+        SeriesArgs args(inReal);
+        return args.wrap(cached_call(name, {double(timeperiod)},
+                                     parse_nan_policy(nan_policy),
+                                     {args(inReal)},
+                                     [&](const NanInputs &in) {
+                                       return Fn(in[0], timeperiod);
+                                     }),
+                         name);
+      },
+      nb::arg("inReal"), nb::arg("timeperiod") = timeperiod, NAN_POLICY_ARG);
+}
+
+template <auto Fn>
+void def_single_no_params(nb::module_ &m, const char *name, const char *doc) {
+  m.def(
+      name,
+      [name](DoubleArrayIN inReal) -> nb::object {
+        PYTAFAST_CALL_SCOPE(name);
+        if (!ResultCache::enabled()) return nb::cast(Fn(inReal));
+        return cached_call(name, {}, NanPolicy::Propagate, {inReal},
+                           [](const NanInputs &in) { return Fn(in[0]); });
+      },
+      nb::arg("inReal").noconvert(), doc);
+  m.def(
+      name,
+      [name](nb::handle inReal, const std::string &nan_policy) {
+        PYTAFAST_CALL_SCOPE(name);
+        SeriesArgs args(inReal);
+        return args.wrap(
+            cached_call(name, {}, parse_nan_policy(nan_policy), {args(inReal)},
+                        [](const NanInputs &in) { return Fn(in[0]); }),
+            name);
+      },
+      nb::arg("inReal"), NAN_POLICY_ARG);
+}
+
+template <auto Fn>
+void def_hl(nb::module_ &m, const char *name, const char *doc,
+            int timeperiod) {
+  m.def(
+      name,
+      [name](DoubleArrayIN inHigh, DoubleArrayIN inLow,
+             int timeperiod) -> nb::object {
+        PYTAFAST_CALL_SCOPE(name);
+        if (!ResultCache::enabled())
+          return nb::cast(Fn(inHigh, inLow, timeperiod));
+        return cached_call(name, {double(timeperiod)}, NanPolicy::Propagate,
+                           {inHigh, inLow}, [&](const NanInputs &in) {
+                             return Fn(in[0], in[1], timeperiod);
+                           });
+      },
+      nb::arg("inHigh").noconvert(), nb::arg("inLow").noconvert(),
+      nb::arg("timeperiod") = timeperiod, doc);
+  m.def(
+      name,
+      [name](nb::handle inHigh, nb::handle inLow, int timeperiod,
+             const std::string &nan_policy) {
+        PYTAFAST_CALL_SCOPE(name);
+        SeriesArgs args(inHigh);
+        return args.wrap(cached_call(name, {double(timeperiod)},
+                                     parse_nan_policy(nan_policy),
+                                     {args(inHigh), args(inLow)},
+                                     [&](const NanInputs &in) {
+                                       return Fn(in[0], in[1], timeperiod);
+                                     }),
+                         name);
+      },
+      nb::arg("inHigh"), nb::arg("inLow"), nb::arg("timeperiod") = timeperiod,
+      NAN_POLICY_ARG);
+}
+
+template <auto Fn>
+void def_hlc(nb::module_ &m, const char *name, const char *doc,
+             int timeperiod) {
+  m.def(
+      name,
+      [name](DoubleArrayIN inHigh, DoubleArrayIN inLow, DoubleArrayIN inClose,
+             int timeperiod) -> nb::object {
+        PYTAFAST_CALL_SCOPE(name);
+        if (!ResultCache::enabled())
+          return nb::cast(Fn(inHigh, inLow, inClose, timeperiod));
+        return cached_call(name, {double(timeperiod)}, NanPolicy::Propagate,
+                           {inHigh, inLow, inClose}, [&](const NanInputs &in) {
+                             return Fn(in[0], in[1], in[2], timeperiod);
+                           });
+      },
+      nb::arg("inHigh").noconvert(), nb::arg("inLow").noconvert(),
+      nb::arg("inClose").noconvert(), nb::arg("timeperiod") = timeperiod, doc);
+  m.def(
+      name,
+      [name](nb::handle inHigh, nb::handle inLow, nb::handle inClose,
+             int timeperiod, const std::string &nan_policy) {
+        PYTAFAST_CALL_SCOPE(name);
+        SeriesArgs args(inClose);
+        return args.wrap(
+            cached_call(name, {double(timeperiod)},
+                        parse_nan_policy(nan_policy),
+                        {args(inHigh), args(inLow), args(inClose)},
+                        [&](const NanInputs &in) {
+                          return Fn(in[0], in[1], in[2], timeperiod);
+                        }),
+            name);
+      },
+      nb::arg("inHigh"), nb::arg("inLow"), nb::arg("inClose"),
+      nb::arg("timeperiod") = timeperiod, NAN_POLICY_ARG);
+}
+
+template <auto Fn>
+void def_dual(nb::module_ &m, const char *name, const char *doc,
+              int timeperiod) {
+  m.def(
+      name,
+      [name](DoubleArrayIN inReal0, DoubleArrayIN inReal1,
+             int timeperiod) -> nb::object {
+        PYTAFAST_CALL_SCOPE(name);
+        if (!ResultCache::enabled())
+          return nb::cast(Fn(inReal0, inReal1, timeperiod));
+        return cached_call(name, {double(timeperiod)}, NanPolicy::Propagate,
+                           {inReal0, inReal1}, [&](const NanInputs &in) {
+                             return Fn(in[0], in[1], timeperiod);
+                           });
+      },
+      nb::arg("inReal0").noconvert(), nb::arg("inReal1").noconvert(),
+      nb::arg("timeperiod") = timeperiod, doc);
+  m.def(
+      name,
+      [name](nb::handle inReal0, nb::handle inReal1, int timeperiod,
+             const std::string &nan_policy) {
+        PYTAFAST_CALL_SCOPE(name);
+        SeriesArgs args(inReal0);
+        return args.wrap(cached_call(name, {double(timeperiod)},
+                                     parse_nan_policy(nan_policy),
+                                     {args(inReal0), args(inReal1)},
+                                     [&](const NanInputs &in) {
+                                       return Fn(in[0], in[1], timeperiod);
+                                     }),
+                         name);
+      },
+      nb::arg("inReal0"), nb::arg("inReal1"),
+      nb::arg("timeperiod") = timeperiod, NAN_POLICY_ARG);
+}
+
+template <auto Fn>
+void def_dual_no_params(nb::module_ &m, const char *name, const char *doc) {
+  m.def(
+      name,
+      [name](DoubleArrayIN inReal0, DoubleArrayIN inReal1) -> nb::object {
+        PYTAFAST_CALL_SCOPE(name);
+        if (!ResultCache::enabled()) return nb::cast(Fn(inReal0, inReal1));
+        return cached_call(
+            name, {}, NanPolicy::Propagate, {inReal0, inReal1},
+            [](const NanInputs &in) { return Fn(in[0], in[1]); });
+      },
+      nb::arg("inReal0").noconvert(), nb::arg("inReal1").noconvert(), doc);
+  m.def(
+      name,
+      [name](nb::handle inReal0, nb::handle inReal1,
+             const std::string &nan_policy) {
+        PYTAFAST_CALL_SCOPE(name);
+        SeriesArgs args(inReal0);
+        return args.wrap(cached_call(name, {}, parse_nan_policy(nan_policy),
+                                     {args(inReal0), args(inReal1)},
+                                     [](const NanInputs &in) {
+                                       return Fn(in[0], in[1]);
+                                     }),
+                         name);
+      },
+      nb::arg("inReal0"), nb::arg("inReal1"), NAN_POLICY_ARG);
+}
+
+template <auto Fn>
+void def_cdl(nb::module_ &m, const char *name, const char *doc) {
+  m.def(
+      name,
+      [name](DoubleArrayIN inOpen, DoubleArrayIN inHigh, DoubleArrayIN inLow,
+             DoubleArrayIN inClose) -> nb::object {
+        PYTAFAST_CALL_SCOPE(name);
+        if (!ResultCache::enabled())
+          return nb::cast(Fn(inOpen, inHigh, inLow, inClose));
+        return cached_call(name, {}, NanPolicy::Propagate,
+                           {inOpen, inHigh, inLow, inClose},
+                           [](const NanInputs &in) {
+                             return Fn(in[0], in[1], in[2], in[3]);
+                           });
+      },
+      nb::arg("inOpen").noconvert(), nb::arg("inHigh").noconvert(),
+      nb::arg("inLow").noconvert(), nb::arg("inClose").noconvert(), doc);
+  m.def(
+      name,
+      [name](nb::handle inOpen, nb::handle inHigh, nb::handle inLow,
+             nb::handle inClose, const std::string &nan_policy) {
+        PYTAFAST_CALL_SCOPE(name);
+        SeriesArgs args(inClose);
+        return args.wrap(
+            cached_call(
+                name, {}, parse_nan_policy(nan_policy),
+                {args(inOpen), args(inHigh), args(inLow), args(inClose)},
+                [](const NanInputs &in) {
+                  return Fn(in[0], in[1], in[2], in[3]);
+                }),
+            name);
+      },
+      nb::arg("inOpen"), nb::arg("inHigh"), nb::arg("inLow"),
+      nb::arg("inClose"), NAN_POLICY_ARG);
+}
+
+template <auto Fn>
+void def_cdl_pen(nb::module_ &m, const char *name, const char *doc,
+                 double penetration) {
+  m.def(
+      name,
+      [name](DoubleArrayIN inOpen, DoubleArrayIN inHigh, DoubleArrayIN inLow,
+             DoubleArrayIN inClose, double penetration) -> nb::object {
+        PYTAFAST_CALL_SCOPE(name);
+        if (!ResultCache::enabled())
+          return nb::cast(Fn(inOpen, inHigh, inLow, inClose, penetration));
+        return cached_call(name, {penetration}, NanPolicy::Propagate,
+                           {inOpen, inHigh, inLow, inClose},
+                           [&](const NanInputs &in) {
+                             return Fn(in[0], in[1], in[2], in[3],
+                                       penetration);
+                           });
+      },
+      nb::arg("inOpen").noconvert(), nb::arg("inHigh").noconvert(),
+      nb::arg("inLow").noconvert(), nb::arg("inClose").noconvert(),
+      nb::arg("penetration") = penetration, doc);
+  m.def(
+      name,
+      [name](nb::handle inOpen, nb::handle inHigh, nb::handle inLow,
+             nb::handle inClose, double penetration,
+             const std::string &nan_policy) {
+        PYTAFAST_CALL_SCOPE(name);
+        SeriesArgs args(inClose);
+        return args.wrap(
+            cached_call(
+                name, {penetration}, parse_nan_policy(nan_policy),
+                {args(inOpen), args(inHigh), args(inLow), args(inClose)},
+                [&](const NanInputs &in) {
+                  return Fn(in[0], in[1], in[2], in[3], penetration);
+                }),
+            name);
+      },
+      nb::arg("inOpen"), nb::arg("inHigh"), nb::arg("inLow"),
+      nb::arg("inClose"), nb::arg("penetration") = penetration,
+      NAN_POLICY_ARG);
+}
+
+#undef NAN_POLICY_ARG
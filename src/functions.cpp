@@ -0,0 +1,69 @@
+// Kernels for every function in the table (functions.h): one TA-Lib call
+// each through ta_call (kernel.h), which does the length check, allocation,
+// GIL release and return-code check
+#include "functions.h"
+#include "kernel.h"
+
+#define KERNEL_1(NAME, FUNC, GROUP, DEF)                                       \
+  DoubleArrayOUT FUNC(DoubleArrayIN inReal, int optInTimePeriod) {             \
+    return ta_call("TA_" #NAME, TA_##NAME,                                     \
+                   TA_##NAME##_Lookback(optInTimePeriod), std::tie(inReal),    \
+                   optInTimePeriod);                                           \
+  }
+#define KERNEL_1_NP(NAME, FUNC, GROUP)                                         \
+  DoubleArrayOUT FUNC(DoubleArrayIN inReal) {                                  \
+    return ta_call("TA_" #NAME, TA_##NAME, TA_##NAME##_Lookback(),             \
+                   std::tie(inReal));                                          \
+  }
+#define KERNEL_2(NAME, FUNC, GROUP, DEF)                                       \
+  DoubleArrayOUT FUNC(DoubleArrayIN in0, DoubleArrayIN in1,                    \
+                      int optInTimePeriod) {                                   \
+    return ta_call("TA_" #NAME, TA_##NAME,                                     \
+                   TA_##NAME##_Lookback(optInTimePeriod), std::tie(in0, in1),  \
+                   optInTimePeriod);                                           \
+  }
+#define KERNEL_2_NP(NAME, FUNC, GROUP, IN0, IN1)                               \
+  DoubleArrayOUT FUNC(DoubleArrayIN in0, DoubleArrayIN in1) {                  \
+    return ta_call("TA_" #NAME, TA_##NAME, TA_##NAME##_Lookback(),             \
+                   std::tie(in0, in1));                                        \
+  }
+#define KERNEL_3(NAME, FUNC, GROUP, DEF)                                       \
+  DoubleArrayOUT FUNC(DoubleArrayIN inHigh, DoubleArrayIN inLow,               \
+                      DoubleArrayIN inClose, int optInTimePeriod) {            \
+    return ta_call("TA_" #NAME, TA_##NAME,                                     \
+                   TA_##NAME##_Lookback(optInTimePeriod),                      \
+                   std::tie(inHigh, inLow, inClose), optInTimePeriod);         \
+  }
+#define KERNEL_CDL(NAME, FUNC)                                                 \
+  IntArrayOUT FUNC(DoubleArrayIN inOpen, DoubleArrayIN inHigh,                 \
+                   DoubleArrayIN inLow, DoubleArrayIN inClose) {               \
+    return ta_call<int>("TA_" #NAME, TA_##NAME, TA_##NAME##_Lookback(),        \
+                        std::tie(inOpen, inHigh, inLow, inClose));             \
+  }
+#define KERNEL_CDL_PEN(NAME, FUNC, DEF)                                        \
+  IntArrayOUT FUNC(DoubleArrayIN inOpen, DoubleArrayIN inHigh,                 \
+                   DoubleArrayIN inLow, DoubleArrayIN inClose,                 \
+                   double optInPenetration) {                                  \
+    return ta_call<int>("TA_" #NAME, TA_##NAME,                                \
+                        TA_##NAME##_Lookback(optInPenetration),                \
+                        std::tie(inOpen, inHigh, inLow, inClose),              \
+                        optInPenetration);                                     \
+  }
+
+PYTAFAST_SINGLE(KERNEL_1)
+PYTAFAST_SINGLE_NP(KERNEL_1_NP)
+PYTAFAST_MATH(KERNEL_1_NP)
+PYTAFAST_HL(KERNEL_2)
+PYTAFAST_HLC(KERNEL_3)
+PYTAFAST_DUAL(KERNEL_2)
+PYTAFAST_DUAL_NP(KERNEL_2_NP)
+PYTAFAST_CDL(KERNEL_CDL)
+PYTAFAST_CDL_PEN(KERNEL_CDL_PEN)
+
+#undef KERNEL_1
+#undef KERNEL_1_NP
+#undef KERNEL_2
+#undef KERNEL_2_NP
+#undef KERNEL_3
+#undef KERNEL_CDL
+#undef KERNEL_CDL_PEN
@@ -0,0 +1,38 @@
+#pragma once
+// Kernels for the function table (core/function_list.h), defined in
+// functions.cpp on the kernel.h helpers
+#include "common.h"
+#include "core/function_list.h"
+
+// Kernel declarations
+#define PYTAFAST_DECLARE_1(NAME, FUNC, ...)                                    \
+  DoubleArrayOUT FUNC(DoubleArrayIN, int);
+#define PYTAFAST_DECLARE_1_NP(NAME, FUNC, ...)                                 \
+  DoubleArrayOUT FUNC(DoubleArrayIN);
+#define PYTAFAST_DECLARE_2(NAME, FUNC, ...)                                    \
+  DoubleArrayOUT FUNC(DoubleArrayIN, DoubleArrayIN, int);
+#define PYTAFAST_DECLARE_2_NP(NAME, FUNC, ...)                                 \
+  DoubleArrayOUT FUNC(DoubleArrayIN, DoubleArrayIN);
+#define PYTAFAST_DECLARE_3(NAME, FUNC, ...)                                    \
+  DoubleArrayOUT FUNC(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN, int);
+#define PYTAFAST_DECLARE_CDL(NAME, FUNC)                                       \
+  IntArrayOUT FUNC(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN, DoubleArrayIN);
+#define PYTAFAST_DECLARE_CDL_PEN(NAME, FUNC, DEF)                              \
+  IntArrayOUT FUNC(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN, DoubleArrayIN, \
+                   double);
+PYTAFAST_SINGLE(PYTAFAST_DECLARE_1)
+PYTAFAST_SINGLE_NP(PYTAFAST_DECLARE_1_NP)
+PYTAFAST_MATH(PYTAFAST_DECLARE_1_NP)
+PYTAFAST_HL(PYTAFAST_DECLARE_2)
+PYTAFAST_HLC(PYTAFAST_DECLARE_3)
+PYTAFAST_DUAL(PYTAFAST_DECLARE_2)
+PYTAFAST_DUAL_NP(PYTAFAST_DECLARE_2_NP)
+PYTAFAST_CDL(PYTAFAST_DECLARE_CDL)
+PYTAFAST_CDL_PEN(PYTAFAST_DECLARE_CDL_PEN)
+#undef PYTAFAST_DECLARE_1
+#undef PYTAFAST_DECLARE_1_NP
+#undef PYTAFAST_DECLARE_2
+#undef PYTAFAST_DECLARE_2_NP
+#undef PYTAFAST_DECLARE_3
+#undef PYTAFAST_DECLARE_CDL
+#undef PYTAFAST_DECLARE_CDL_PEN
@@ -0,0 +1,88 @@
+#pragma once
+// The call sequence every TA-Lib binding shares, written once:
+//   - all inputs must have the same length ("Input lengths must match");
+//     empty inputs give empty outputs
+//   - outputs are allocated with the lookback region filled (common.h)
+//   - TA-Lib runs over the whole range inside a ComputeScope (GIL released,
+//     counted and traced)
+//   - the return code is checked
+// ta_call covers TA-Lib functions with one output, ta_call_multi those with
+// several (returned through MultiOutput in the requested layout). Both call
+//   fn(0, size - 1, inputs..., params..., &outBegIdx, &outNBElement, outs...)
+// so a binding is just the TA-Lib function, its lookback and its arguments.
+#include "common.h"
+#include <array>
+#include <tuple>
+
+// Common length of the inputs
+template <typename... Rest>
+size_t input_length(const DoubleArrayIN &first, const Rest &...rest) {
+  size_t size = first.shape(0);
+  if (((rest.shape(0) != size) || ...))
+    throw std::runtime_error("Input lengths must match");
+  return size;
+}
+
+// One output of `size` bars; `call(&outBegIdx, &outNBElement, out)` runs
+// TA-Lib with `out` just past the lookback region
+template <typename T = double, typename Call>
+ArrayOUT<T> ta_output(const char *name, size_t size, int lookback,
+                      Call &&call) {
+  if (size == 0) return ArrayOUT<T>(nullptr, {0}, nb::handle());
+  auto [outData, owner] = alloc_output<T>(size, lookback);
+  int outBegIdx = 0, outNBElement = 0;
+  TA_RetCode retCode;
+  {
+    ComputeScope compute;
+    retCode = call(&outBegIdx, &outNBElement, outData + lookback);
+  }
+  check_ta_retcode(retCode, name);
+  return ArrayOUT<T>(outData, {size}, owner);
+}
+
+// `inputs` is std::tie(inReal, ...); T is the output type
+template <typename T = double, typename Fn, typename... In, typename... Params>
+ArrayOUT<T> ta_call(const char *name, Fn fn, int lookback,
+                    const std::tuple<In &...> &inputs, Params... params) {
+  size_t size = std::apply(
+      [](const auto &...in) { return input_length(in...); }, inputs);
+  return ta_output<T>(
+      name, size, lookback, [&](int *outBegIdx, int *outNBElement, T *out) {
+        return std::apply(
+            [&](const auto &...in) {
+              return fn(0, static_cast<int>(size) - 1, in.data()..., params...,
+                        outBegIdx, outNBElement, out);
+            },
+            inputs);
+      });
+}
+
+// K outputs sharing one lookback
+template <size_t K, typename Fn, typename... In, typename... Params>
+nb::object ta_call_multi(const char *name, Fn fn, int lookback,
+                         const std::string &layout,
+                         const std::tuple<In &...> &inputs, Params... params) {
+  size_t size = std::apply(
+      [](const auto &...in) { return input_length(in...); }, inputs);
+  MultiOutput out(size, std::vector<int>(K, lookback), parse_layout(layout));
+  if (size == 0) return out.result();
+  std::array<double *, K> rows;
+  for (size_t j = 0; j < K; ++j) rows[j] = out.row(j) + lookback;
+  int outBegIdx = 0, outNBElement = 0;
+  TA_RetCode retCode;
+  {
+    ComputeScope compute;
+    retCode = std::apply(
+        [&](const auto &...in) {
+          return std::apply(
+              [&](auto *...row) {
+                return fn(0, static_cast<int>(size) - 1, in.data()...,
+                          params..., &outBegIdx, &outNBElement, row...);
+              },
+              rows);
+        },
+        inputs);
+  }
+  check_ta_retcode(retCode, name);
+  return out.result();
+}
@@ -1,360 +1,97 @@
-// Momentum Indicators: RSI, MACD, MACDEXT, MACDFIX, ROC, ROCP, ROCR, ROCR100,
-// STOCH, STOCHF, STOCHRSI, MOM, CMO, APO, PPO, TRIX, AROON, AROONOSC,
-// ADX, ADXR, DX, MINUS_DI, MINUS_DM, PLUS_DI, PLUS_DM, WILLR, MFI,
-// CCI, ULTOSC, BOP
-#include "common.h"
-
-// ---------------------------------------------------------
-// RELATIVE STRENGTH INDEX
-// ---------------------------------------------------------
-DoubleArrayOUT rsi(DoubleArrayIN inReal, int optInTimePeriod = 14) {
-  if (inReal.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-
-  size_t size = inReal.shape(0);
-  int lookback = TA_RSI_Lookback(optInTimePeriod);
-  auto [outData, owner] = alloc_output(size, lookback);
-
-  int outBegIdx = 0;
-  int outNBElement = 0;
-
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode = TA_RSI(0, size - 1, inReal.data(), optInTimePeriod, &outBegIdx,
-                     &outNBElement, outData + lookback);
-  }
-  check_ta_retcode(retCode, "TA_RSI");
-
-  return DoubleArrayOUT(outData, {size}, owner);
-}
+// Momentum Indicators: MACD, MACDEXT, MACDFIX, STOCH, STOCHF, STOCHRSI, APO,
+// PPO, AROON, MFI, ULTOSC, BOP, DMI_ALL, STOCH_ALL
+// (RSI, MOM, ROC*, CMO, TRIX, AROONOSC, ADX, ADXR, CCI, DX, MINUS_DI,
+// MINUS_DM, PLUS_DI, PLUS_DM, WILLR are in the function table,
+// core/function_list.h)
+#include "core/fused.h"
+#include "kernel.h"
 
 // ---------------------------------------------------------
 // MACD
 // ---------------------------------------------------------
-nb::tuple macd(DoubleArrayIN inReal, int optInFastPeriod = 12,
-               int optInSlowPeriod = 26, int optInSignalPeriod = 9) {
-  if (inReal.size() == 0) {
-    return nb::make_tuple(DoubleArrayOUT(nullptr, {0}, nb::handle()),
-                          DoubleArrayOUT(nullptr, {0}, nb::handle()),
-                          DoubleArrayOUT(nullptr, {0}, nb::handle()));
-  }
-
-  size_t size = inReal.shape(0);
+nb::object macd(DoubleArrayIN inReal, int optInFastPeriod = 12,
+                int optInSlowPeriod = 26, int optInSignalPeriod = 9,
+                const std::string &layout = "tuple") {
   int lookback =
       TA_MACD_Lookback(optInFastPeriod, optInSlowPeriod, optInSignalPeriod);
-
-  auto [outMACD, owner1] = alloc_output(size, lookback);
-  auto [outSignal, owner2] = alloc_output(size, lookback);
-  auto [outHist, owner3] = alloc_output(size, lookback);
-
-  int outBegIdx = 0;
-  int outNBElement = 0;
-
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode =
-        TA_MACD(0, size - 1, inReal.data(), optInFastPeriod, optInSlowPeriod,
-                optInSignalPeriod, &outBegIdx, &outNBElement,
-                outMACD + lookback, outSignal + lookback, outHist + lookback);
-  }
-  check_ta_retcode(retCode, "TA_MACD");
-
-  return nb::make_tuple(DoubleArrayOUT(outMACD, {size}, owner1),
-                        DoubleArrayOUT(outSignal, {size}, owner2),
-                        DoubleArrayOUT(outHist, {size}, owner3));
+  return ta_call_multi<3>("TA_MACD", TA_MACD, lookback, layout,
+                          std::tie(inReal), optInFastPeriod, optInSlowPeriod,
+                          optInSignalPeriod);
 }
 
 // ---------------------------------------------------------
 // MACD WITH CONTROLLABLE MA TYPE (MACDEXT)
 // ---------------------------------------------------------
-nb::tuple macdext(DoubleArrayIN inReal, int optInFastPeriod = 12,
-                  int optInFastMAType = 0, int optInSlowPeriod = 26,
-                  int optInSlowMAType = 0, int optInSignalPeriod = 9,
-                  int optInSignalMAType = 0) {
-  if (inReal.size() == 0) {
-    auto empty = DoubleArrayOUT(nullptr, {0}, nb::handle());
-    return nb::make_tuple(empty, empty, empty);
-  }
-  size_t size = inReal.shape(0);
+nb::object macdext(DoubleArrayIN inReal, int optInFastPeriod = 12,
+                   int optInFastMAType = 0, int optInSlowPeriod = 26,
+                   int optInSlowMAType = 0, int optInSignalPeriod = 9,
+                   int optInSignalMAType = 0,
+                   const std::string &layout = "tuple") {
   int lookback =
       TA_MACDEXT_Lookback(optInFastPeriod, (TA_MAType)optInFastMAType,
                           optInSlowPeriod, (TA_MAType)optInSlowMAType,
                           optInSignalPeriod, (TA_MAType)optInSignalMAType);
-  auto [outMACD, ownerM] = alloc_output(size, lookback);
-  auto [outSignal, ownerS] = alloc_output(size, lookback);
-  auto [outHist, ownerH] = alloc_output(size, lookback);
-  int outBegIdx = 0, outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode = TA_MACDEXT(
-        0, size - 1, inReal.data(), optInFastPeriod, (TA_MAType)optInFastMAType,
-        optInSlowPeriod, (TA_MAType)optInSlowMAType, optInSignalPeriod,
-        (TA_MAType)optInSignalMAType, &outBegIdx, &outNBElement,
-        outMACD + lookback, outSignal + lookback, outHist + lookback);
-  }
-  check_ta_retcode(retCode, "TA_MACDEXT");
-  return nb::make_tuple(DoubleArrayOUT(outMACD, {size}, ownerM),
-                        DoubleArrayOUT(outSignal, {size}, ownerS),
-                        DoubleArrayOUT(outHist, {size}, ownerH));
+  return ta_call_multi<3>("TA_MACDEXT", TA_MACDEXT, lookback, layout,
+                          std::tie(inReal), optInFastPeriod,
+                          (TA_MAType)optInFastMAType, optInSlowPeriod,
+                          (TA_MAType)optInSlowMAType, optInSignalPeriod,
+                          (TA_MAType)optInSignalMAType);
 }
 
 // ---------------------------------------------------------
 // MACD FIX 12/26 (MACDFIX)
 // ---------------------------------------------------------
-nb::tuple macdfix(DoubleArrayIN inReal, int optInSignalPeriod = 9) {
-  if (inReal.size() == 0) {
-    auto empty = DoubleArrayOUT(nullptr, {0}, nb::handle());
-    return nb::make_tuple(empty, empty, empty);
-  }
-  size_t size = inReal.shape(0);
-  int lookback = TA_MACDFIX_Lookback(optInSignalPeriod);
-  auto [outMACD, ownerM] = alloc_output(size, lookback);
-  auto [outSignal, ownerS] = alloc_output(size, lookback);
-  auto [outHist, ownerH] = alloc_output(size, lookback);
-  int outBegIdx = 0, outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode = TA_MACDFIX(0, size - 1, inReal.data(), optInSignalPeriod,
-                         &outBegIdx, &outNBElement, outMACD + lookback,
-                         outSignal + lookback, outHist + lookback);
-  }
-  check_ta_retcode(retCode, "TA_MACDFIX");
-  return nb::make_tuple(DoubleArrayOUT(outMACD, {size}, ownerM),
-                        DoubleArrayOUT(outSignal, {size}, ownerS),
-                        DoubleArrayOUT(outHist, {size}, ownerH));
-}
-
-// ---------------------------------------------------------
-// RATE OF CHANGE (ROC)
-// ---------------------------------------------------------
-DoubleArrayOUT roc(DoubleArrayIN inReal, int optInTimePeriod = 10) {
-  if (inReal.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  size_t size = inReal.shape(0);
-  int lookback = TA_ROC_Lookback(optInTimePeriod);
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0;
-  int outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode = TA_ROC(0, size - 1, inReal.data(), optInTimePeriod, &outBegIdx,
-                     &outNBElement, outData + lookback);
-  }
-  check_ta_retcode(retCode, "TA_ROC");
-  return DoubleArrayOUT(outData, {size}, owner);
-}
-
-// ---------------------------------------------------------
-// RATE OF CHANGE PERCENTAGE (ROCP)
-// ---------------------------------------------------------
-DoubleArrayOUT rocp(DoubleArrayIN inReal, int optInTimePeriod = 10) {
-  if (inReal.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  size_t size = inReal.shape(0);
-  int lookback = TA_ROCP_Lookback(optInTimePeriod);
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0, outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode = TA_ROCP(0, size - 1, inReal.data(), optInTimePeriod, &outBegIdx,
-                      &outNBElement, outData + lookback);
-  }
-  check_ta_retcode(retCode, "TA_ROCP");
-  return DoubleArrayOUT(outData, {size}, owner);
-}
-
-// ---------------------------------------------------------
-// RATE OF CHANGE RATIO (ROCR)
-// ---------------------------------------------------------
-DoubleArrayOUT rocr(DoubleArrayIN inReal, int optInTimePeriod = 10) {
-  if (inReal.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  size_t size = inReal.shape(0);
-  int lookback = TA_ROCR_Lookback(optInTimePeriod);
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0, outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode = TA_ROCR(0, size - 1, inReal.data(), optInTimePeriod, &outBegIdx,
-                      &outNBElement, outData + lookback);
-  }
-  check_ta_retcode(retCode, "TA_ROCR");
-  return DoubleArrayOUT(outData, {size}, owner);
-}
-
-// ---------------------------------------------------------
-// RATE OF CHANGE RATIO 100 SCALE (ROCR100)
-// ---------------------------------------------------------
-DoubleArrayOUT rocr100(DoubleArrayIN inReal, int optInTimePeriod = 10) {
-  if (inReal.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  size_t size = inReal.shape(0);
-  int lookback = TA_ROCR100_Lookback(optInTimePeriod);
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0, outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode = TA_ROCR100(0, size - 1, inReal.data(), optInTimePeriod,
-                         &outBegIdx, &outNBElement, outData + lookback);
-  }
-  check_ta_retcode(retCode, "TA_ROCR100");
-  return DoubleArrayOUT(outData, {size}, owner);
+nb::object macdfix(DoubleArrayIN inReal, int optInSignalPeriod = 9,
+                   const std::string &layout = "tuple") {
+  return ta_call_multi<3>("TA_MACDFIX", TA_MACDFIX,
+                          TA_MACDFIX_Lookback(optInSignalPeriod), layout,
+                          std::tie(inReal), optInSignalPeriod);
 }
 
 // ---------------------------------------------------------
 // STOCHASTIC (STOCH)
 // ---------------------------------------------------------
-nb::tuple stoch(DoubleArrayIN inHigh, DoubleArrayIN inLow,
-                DoubleArrayIN inClose, int optInFastK_Period = 5,
-                int optInSlowK_Period = 3, int optInSlowK_MAType = 0,
-                int optInSlowD_Period = 3, int optInSlowD_MAType = 0) {
-  if (inHigh.size() == 0 || inLow.size() == 0 || inClose.size() == 0) {
-    return nb::make_tuple(DoubleArrayOUT(nullptr, {0}, nb::handle()),
-                          DoubleArrayOUT(nullptr, {0}, nb::handle()));
-  }
-  if (inHigh.shape(0) != inLow.shape(0) || inHigh.shape(0) != inClose.shape(0))
-    throw std::runtime_error("Input lengths must match");
-
-  size_t size = inHigh.shape(0);
+nb::object stoch(DoubleArrayIN inHigh, DoubleArrayIN inLow,
+                 DoubleArrayIN inClose, int optInFastK_Period = 5,
+                 int optInSlowK_Period = 3, int optInSlowK_MAType = 0,
+                 int optInSlowD_Period = 3, int optInSlowD_MAType = 0,
+                 const std::string &layout = "tuple") {
   int lookback = TA_STOCH_Lookback(
       optInFastK_Period, optInSlowK_Period, (TA_MAType)optInSlowK_MAType,
       optInSlowD_Period, (TA_MAType)optInSlowD_MAType);
-
-  auto [outSlowK, owner1] = alloc_output(size, lookback);
-  auto [outSlowD, owner2] = alloc_output(size, lookback);
-
-  int outBegIdx = 0;
-  int outNBElement = 0;
-
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode = TA_STOCH(0, size - 1, inHigh.data(), inLow.data(), inClose.data(),
-                       optInFastK_Period, optInSlowK_Period,
-                       (TA_MAType)optInSlowK_MAType, optInSlowD_Period,
-                       (TA_MAType)optInSlowD_MAType, &outBegIdx, &outNBElement,
-                       outSlowK + lookback, outSlowD + lookback);
-  }
-  check_ta_retcode(retCode, "TA_STOCH");
-
-  return nb::make_tuple(DoubleArrayOUT(outSlowK, {size}, owner1),
-                        DoubleArrayOUT(outSlowD, {size}, owner2));
+  return ta_call_multi<2>("TA_STOCH", TA_STOCH, lookback, layout,
+                          std::tie(inHigh, inLow, inClose), optInFastK_Period,
+                          optInSlowK_Period, (TA_MAType)optInSlowK_MAType,
+                          optInSlowD_Period, (TA_MAType)optInSlowD_MAType);
 }
 
 // ---------------------------------------------------------
 // STOCHASTIC FAST (STOCHF)
 // ---------------------------------------------------------
-nb::tuple stochf(DoubleArrayIN inHigh, DoubleArrayIN inLow,
-                 DoubleArrayIN inClose, int optInFastK_Period = 5,
-                 int optInFastD_Period = 3, int optInFastD_MAType = 0) {
-  if (inHigh.size() == 0 || inLow.size() == 0 || inClose.size() == 0) {
-    auto empty = DoubleArrayOUT(nullptr, {0}, nb::handle());
-    return nb::make_tuple(empty, empty);
-  }
-  size_t size = inHigh.shape(0);
+nb::object stochf(DoubleArrayIN inHigh, DoubleArrayIN inLow,
+                  DoubleArrayIN inClose, int optInFastK_Period = 5,
+                  int optInFastD_Period = 3, int optInFastD_MAType = 0,
+                  const std::string &layout = "tuple") {
   int lookback = TA_STOCHF_Lookback(optInFastK_Period, optInFastD_Period,
                                     (TA_MAType)optInFastD_MAType);
-  auto [outFastK, ownerK] = alloc_output(size, lookback);
-  auto [outFastD, ownerD] = alloc_output(size, lookback);
-  int outBegIdx = 0, outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode = TA_STOCHF(0, size - 1, inHigh.data(), inLow.data(),
-                        inClose.data(), optInFastK_Period, optInFastD_Period,
-                        (TA_MAType)optInFastD_MAType, &outBegIdx, &outNBElement,
-                        outFastK + lookback, outFastD + lookback);
-  }
-  check_ta_retcode(retCode, "TA_STOCHF");
-  return nb::make_tuple(DoubleArrayOUT(outFastK, {size}, ownerK),
-                        DoubleArrayOUT(outFastD, {size}, ownerD));
+  return ta_call_multi<2>("TA_STOCHF", TA_STOCHF, lookback, layout,
+                          std::tie(inHigh, inLow, inClose), optInFastK_Period,
+                          optInFastD_Period, (TA_MAType)optInFastD_MAType);
 }
 
 // ---------------------------------------------------------
 // STOCHASTIC RSI (STOCHRSI)
 // ---------------------------------------------------------
-nb::tuple stochrsi(DoubleArrayIN inReal, int optInTimePeriod = 14,
-                   int optInFastK_Period = 5, int optInFastD_Period = 3,
-                   int optInFastD_MAType = 0) {
-  if (inReal.size() == 0) {
-    auto empty = DoubleArrayOUT(nullptr, {0}, nb::handle());
-    return nb::make_tuple(empty, empty);
-  }
-  size_t size = inReal.shape(0);
+nb::object stochrsi(DoubleArrayIN inReal, int optInTimePeriod = 14,
+                    int optInFastK_Period = 5, int optInFastD_Period = 3,
+                    int optInFastD_MAType = 0,
+                    const std::string &layout = "tuple") {
   int lookback =
       TA_STOCHRSI_Lookback(optInTimePeriod, optInFastK_Period,
                            optInFastD_Period, (TA_MAType)optInFastD_MAType);
-  auto [outFastK, ownerK] = alloc_output(size, lookback);
-  auto [outFastD, ownerD] = alloc_output(size, lookback);
-  int outBegIdx = 0, outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode = TA_STOCHRSI(
-        0, size - 1, inReal.data(), optInTimePeriod, optInFastK_Period,
-        optInFastD_Period, (TA_MAType)optInFastD_MAType, &outBegIdx,
-        &outNBElement, outFastK + lookback, outFastD + lookback);
-  }
-  check_ta_retcode(retCode, "TA_STOCHRSI");
-  return nb::make_tuple(DoubleArrayOUT(outFastK, {size}, ownerK),
-                        DoubleArrayOUT(outFastD, {size}, ownerD));
-}
-
-// ---------------------------------------------------------
-// MOMENTUM (MOM)
-// ---------------------------------------------------------
-DoubleArrayOUT mom(DoubleArrayIN inReal, int optInTimePeriod = 10) {
-  if (inReal.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  size_t size = inReal.shape(0);
-  int lookback = TA_MOM_Lookback(optInTimePeriod);
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0;
-  int outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode = TA_MOM(0, size - 1, inReal.data(), optInTimePeriod, &outBegIdx,
-                     &outNBElement, outData + lookback);
-  }
-  check_ta_retcode(retCode, "TA_MOM");
-  return DoubleArrayOUT(outData, {size}, owner);
-}
-
-// ---------------------------------------------------------
-// CHANDE MOMENTUM OSCILLATOR (CMO)
-// ---------------------------------------------------------
-DoubleArrayOUT cmo(DoubleArrayIN inReal, int optInTimePeriod = 14) {
-  if (inReal.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  size_t size = inReal.shape(0);
-  int lookback = TA_CMO_Lookback(optInTimePeriod);
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0;
-  int outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode = TA_CMO(0, size - 1, inReal.data(), optInTimePeriod, &outBegIdx,
-                     &outNBElement, outData + lookback);
-  }
-  check_ta_retcode(retCode, "TA_CMO");
-  return DoubleArrayOUT(outData, {size}, owner);
+  return ta_call_multi<2>("TA_STOCHRSI", TA_STOCHRSI, lookback, layout,
+                          std::tie(inReal), optInTimePeriod, optInFastK_Period,
+                          optInFastD_Period, (TA_MAType)optInFastD_MAType);
 }
 
 // ---------------------------------------------------------
@@ -362,24 +99,11 @@ DoubleArrayOUT cmo(DoubleArrayIN inReal, int optInTimePeriod = 14) {
 // ---------------------------------------------------------
 DoubleArrayOUT apo(DoubleArrayIN inReal, int optInFastPeriod = 12,
                    int optInSlowPeriod = 26, int optInMAType = 0) {
-  if (inReal.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  size_t size = inReal.shape(0);
-  int lookback =
-      TA_APO_Lookback(optInFastPeriod, optInSlowPeriod, (TA_MAType)optInMAType);
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0;
-  int outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode = TA_APO(0, size - 1, inReal.data(), optInFastPeriod,
-                     optInSlowPeriod, (TA_MAType)optInMAType, &outBegIdx,
-                     &outNBElement, outData + lookback);
-  }
-  check_ta_retcode(retCode, "TA_APO");
-  return DoubleArrayOUT(outData, {size}, owner);
+  return ta_call("TA_APO", TA_APO,
+                 TA_APO_Lookback(optInFastPeriod, optInSlowPeriod,
+                                 (TA_MAType)optInMAType),
+                 std::tie(inReal), optInFastPeriod, optInSlowPeriod,
+                 (TA_MAType)optInMAType);
 }
 
 // ---------------------------------------------------------
@@ -387,418 +111,147 @@ DoubleArrayOUT apo(DoubleArrayIN inReal, int optInFastPeriod = 12,
 // ---------------------------------------------------------
 DoubleArrayOUT ppo(DoubleArrayIN inReal, int optInFastPeriod = 12,
                    int optInSlowPeriod = 26, int optInMAType = 0) {
-  if (inReal.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  size_t size = inReal.shape(0);
-  int lookback =
-      TA_PPO_Lookback(optInFastPeriod, optInSlowPeriod, (TA_MAType)optInMAType);
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0;
-  int outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode = TA_PPO(0, size - 1, inReal.data(), optInFastPeriod,
-                     optInSlowPeriod, (TA_MAType)optInMAType, &outBegIdx,
-                     &outNBElement, outData + lookback);
-  }
-  check_ta_retcode(retCode, "TA_PPO");
-  return DoubleArrayOUT(outData, {size}, owner);
-}
-
-// ---------------------------------------------------------
-// 1-DAY RATE-OF-CHANGE (TRIX)
-// ---------------------------------------------------------
-DoubleArrayOUT trix(DoubleArrayIN inReal, int optInTimePeriod = 30) {
-  if (inReal.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  size_t size = inReal.shape(0);
-  int lookback = TA_TRIX_Lookback(optInTimePeriod);
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0;
-  int outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode = TA_TRIX(0, size - 1, inReal.data(), optInTimePeriod, &outBegIdx,
-                      &outNBElement, outData + lookback);
-  }
-  check_ta_retcode(retCode, "TA_TRIX");
-  return DoubleArrayOUT(outData, {size}, owner);
+  return ta_call("TA_PPO", TA_PPO,
+                 TA_PPO_Lookback(optInFastPeriod, optInSlowPeriod,
+                                 (TA_MAType)optInMAType),
+                 std::tie(inReal), optInFastPeriod, optInSlowPeriod,
+                 (TA_MAType)optInMAType);
 }
 
 // ---------------------------------------------------------
 // AROON (AROON)
 // ---------------------------------------------------------
-nb::tuple aroon(DoubleArrayIN inHigh, DoubleArrayIN inLow,
-                int optInTimePeriod = 14) {
-  if (inHigh.size() == 0 || inLow.size() == 0) {
-    return nb::make_tuple(DoubleArrayOUT(nullptr, {0}, nb::handle()),
-                          DoubleArrayOUT(nullptr, {0}, nb::handle()));
-  }
-  if (inHigh.shape(0) != inLow.shape(0))
-    throw std::runtime_error("Input lengths must match");
-  size_t size = inHigh.shape(0);
-  int lookback = TA_AROON_Lookback(optInTimePeriod);
-  auto [outDown, owner1] = alloc_output(size, lookback);
-  auto [outUp, owner2] = alloc_output(size, lookback);
-  int outBegIdx = 0;
-  int outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode = TA_AROON(0, size - 1, inHigh.data(), inLow.data(),
-                       optInTimePeriod, &outBegIdx, &outNBElement,
-                       outDown + lookback, outUp + lookback);
-  }
-  check_ta_retcode(retCode, "TA_AROON");
-  return nb::make_tuple(DoubleArrayOUT(outDown, {size}, owner1),
-                        DoubleArrayOUT(outUp, {size}, owner2));
-}
-
-// ---------------------------------------------------------
-// AROON OSCILLATOR (AROONOSC)
-// ---------------------------------------------------------
-DoubleArrayOUT aroonosc(DoubleArrayIN inHigh, DoubleArrayIN inLow,
-                        int optInTimePeriod = 14) {
-  if (inHigh.size() == 0 || inLow.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  if (inHigh.shape(0) != inLow.shape(0))
-    throw std::runtime_error("Input lengths must match");
-  size_t size = inHigh.shape(0);
-  int lookback = TA_AROONOSC_Lookback(optInTimePeriod);
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0;
-  int outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode =
-        TA_AROONOSC(0, size - 1, inHigh.data(), inLow.data(), optInTimePeriod,
-                    &outBegIdx, &outNBElement, outData + lookback);
-  }
-  check_ta_retcode(retCode, "TA_AROONOSC");
-  return DoubleArrayOUT(outData, {size}, owner);
-}
-
-// ---------------------------------------------------------
-// AVERAGE DIRECTIONAL MOVEMENT INDEX (ADX)
-// ---------------------------------------------------------
-DoubleArrayOUT adx(DoubleArrayIN inHigh, DoubleArrayIN inLow,
-                   DoubleArrayIN inClose, int optInTimePeriod = 14) {
-  if (inHigh.size() == 0 || inLow.size() == 0 || inClose.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  if (inHigh.shape(0) != inLow.shape(0) || inHigh.shape(0) != inClose.shape(0))
-    throw std::runtime_error("Input lengths must match");
-  size_t size = inHigh.shape(0);
-  int lookback = TA_ADX_Lookback(optInTimePeriod);
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0;
-  int outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode =
-        TA_ADX(0, size - 1, inHigh.data(), inLow.data(), inClose.data(),
-               optInTimePeriod, &outBegIdx, &outNBElement, outData + lookback);
-  }
-  check_ta_retcode(retCode, "TA_ADX");
-  return DoubleArrayOUT(outData, {size}, owner);
+nb::object aroon(DoubleArrayIN inHigh, DoubleArrayIN inLow,
+                 int optInTimePeriod = 14, const std::string &layout = "tuple") {
+  return ta_call_multi<2>("TA_AROON", TA_AROON,
+                          TA_AROON_Lookback(optInTimePeriod), layout,
+                          std::tie(inHigh, inLow), optInTimePeriod);
 }
 
 // ---------------------------------------------------------
-// AVERAGE DIRECTIONAL MOVEMENT INDEX RATING (ADXR)
-// ---------------------------------------------------------
-DoubleArrayOUT adxr(DoubleArrayIN inHigh, DoubleArrayIN inLow,
-                    DoubleArrayIN inClose, int optInTimePeriod = 14) {
-  if (inHigh.size() == 0 || inLow.size() == 0 || inClose.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  if (inHigh.shape(0) != inLow.shape(0) || inHigh.shape(0) != inClose.shape(0))
-    throw std::runtime_error("Input lengths must match");
-  size_t size = inHigh.shape(0);
-  int lookback = TA_ADXR_Lookback(optInTimePeriod);
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0, outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode =
-        TA_ADXR(0, size - 1, inHigh.data(), inLow.data(), inClose.data(),
-                optInTimePeriod, &outBegIdx, &outNBElement, outData + lookback);
-  }
-  check_ta_retcode(retCode, "TA_ADXR");
-  return DoubleArrayOUT(outData, {size}, owner);
-}
-
-// ---------------------------------------------------------
-// DIRECTIONAL MOVEMENT INDEX (DX)
-// ---------------------------------------------------------
-DoubleArrayOUT dx(DoubleArrayIN inHigh, DoubleArrayIN inLow,
-                  DoubleArrayIN inClose, int optInTimePeriod = 14) {
-  if (inHigh.size() == 0 || inLow.size() == 0 || inClose.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  if (inHigh.shape(0) != inLow.shape(0) || inHigh.shape(0) != inClose.shape(0))
-    throw std::runtime_error("Input lengths must match");
-  size_t size = inHigh.shape(0);
-  int lookback = TA_DX_Lookback(optInTimePeriod);
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0;
-  int outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode =
-        TA_DX(0, size - 1, inHigh.data(), inLow.data(), inClose.data(),
-              optInTimePeriod, &outBegIdx, &outNBElement, outData + lookback);
-  }
-  check_ta_retcode(retCode, "TA_DX");
-  return DoubleArrayOUT(outData, {size}, owner);
-}
-
-// ---------------------------------------------------------
-// MINUS DIRECTIONAL INDICATOR (MINUS_DI)
-// ---------------------------------------------------------
-DoubleArrayOUT minus_di(DoubleArrayIN inHigh, DoubleArrayIN inLow,
-                        DoubleArrayIN inClose, int optInTimePeriod = 14) {
-  if (inHigh.size() == 0 || inLow.size() == 0 || inClose.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  if (inHigh.shape(0) != inLow.shape(0) || inHigh.shape(0) != inClose.shape(0))
-    throw std::runtime_error("Input lengths must match");
-  size_t size = inHigh.shape(0);
-  int lookback = TA_MINUS_DI_Lookback(optInTimePeriod);
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0;
-  int outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode = TA_MINUS_DI(0, size - 1, inHigh.data(), inLow.data(),
-                          inClose.data(), optInTimePeriod, &outBegIdx,
-                          &outNBElement, outData + lookback);
-  }
-  check_ta_retcode(retCode, "TA_MINUS_DI");
-  return DoubleArrayOUT(outData, {size}, owner);
-}
-
-// ---------------------------------------------------------
-// MINUS DIRECTIONAL MOVEMENT (MINUS_DM)
+// MONEY FLOW INDEX (MFI)
 // ---------------------------------------------------------
-DoubleArrayOUT minus_dm(DoubleArrayIN inHigh, DoubleArrayIN inLow,
-                        int optInTimePeriod = 14) {
-  if (inHigh.size() == 0 || inLow.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  if (inHigh.shape(0) != inLow.shape(0))
-    throw std::runtime_error("Input lengths must match");
-  size_t size = inHigh.shape(0);
-  int lookback = TA_MINUS_DM_Lookback(optInTimePeriod);
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0;
-  int outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode =
-        TA_MINUS_DM(0, size - 1, inHigh.data(), inLow.data(), optInTimePeriod,
-                    &outBegIdx, &outNBElement, outData + lookback);
-  }
-  check_ta_retcode(retCode, "TA_MINUS_DM");
-  return DoubleArrayOUT(outData, {size}, owner);
+DoubleArrayOUT mfi(DoubleArrayIN inHigh, DoubleArrayIN inLow,
+                   DoubleArrayIN inClose, DoubleArrayIN inVolume,
+                   int optInTimePeriod = 14) {
+  return ta_call("TA_MFI", TA_MFI, TA_MFI_Lookback(optInTimePeriod),
+                 std::tie(inHigh, inLow, inClose, inVolume), optInTimePeriod);
 }
 
 // ---------------------------------------------------------
-// PLUS DIRECTIONAL INDICATOR (PLUS_DI)
+// ULTIMATE OSCILLATOR (ULTOSC)
 // ---------------------------------------------------------
-DoubleArrayOUT plus_di(DoubleArrayIN inHigh, DoubleArrayIN inLow,
-                       DoubleArrayIN inClose, int optInTimePeriod = 14) {
-  if (inHigh.size() == 0 || inLow.size() == 0 || inClose.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  if (inHigh.shape(0) != inLow.shape(0) || inHigh.shape(0) != inClose.shape(0))
-    throw std::runtime_error("Input lengths must match");
-  size_t size = inHigh.shape(0);
-  int lookback = TA_PLUS_DI_Lookback(optInTimePeriod);
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0;
-  int outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode = TA_PLUS_DI(0, size - 1, inHigh.data(), inLow.data(),
-                         inClose.data(), optInTimePeriod, &outBegIdx,
-                         &outNBElement, outData + lookback);
-  }
-  check_ta_retcode(retCode, "TA_PLUS_DI");
-  return DoubleArrayOUT(outData, {size}, owner);
+DoubleArrayOUT ultosc(DoubleArrayIN inHigh, DoubleArrayIN inLow,
+                      DoubleArrayIN inClose, int optInTimePeriod1 = 7,
+                      int optInTimePeriod2 = 14, int optInTimePeriod3 = 28) {
+  return ta_call(
+      "TA_ULTOSC", TA_ULTOSC,
+      TA_ULTOSC_Lookback(optInTimePeriod1, optInTimePeriod2, optInTimePeriod3),
+      std::tie(inHigh, inLow, inClose), optInTimePeriod1, optInTimePeriod2,
+      optInTimePeriod3);
 }
 
 // ---------------------------------------------------------
-// PLUS DIRECTIONAL MOVEMENT (PLUS_DM)
+// BALANCE OF POWER (BOP)
 // ---------------------------------------------------------
-DoubleArrayOUT plus_dm(DoubleArrayIN inHigh, DoubleArrayIN inLow,
-                       int optInTimePeriod = 14) {
-  if (inHigh.size() == 0 || inLow.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  if (inHigh.shape(0) != inLow.shape(0))
-    throw std::runtime_error("Input lengths must match");
-  size_t size = inHigh.shape(0);
-  int lookback = TA_PLUS_DM_Lookback(optInTimePeriod);
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0;
-  int outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode =
-        TA_PLUS_DM(0, size - 1, inHigh.data(), inLow.data(), optInTimePeriod,
-                   &outBegIdx, &outNBElement, outData + lookback);
-  }
-  check_ta_retcode(retCode, "TA_PLUS_DM");
-  return DoubleArrayOUT(outData, {size}, owner);
+DoubleArrayOUT bop(DoubleArrayIN inOpen, DoubleArrayIN inHigh,
+                   DoubleArrayIN inLow, DoubleArrayIN inClose) {
+  return ta_call("TA_BOP", TA_BOP, TA_BOP_Lookback(),
+                 std::tie(inOpen, inHigh, inLow, inClose));
 }
 
 // ---------------------------------------------------------
-// WILLIAMS %R (WILLR)
-// ---------------------------------------------------------
-DoubleArrayOUT willr(DoubleArrayIN inHigh, DoubleArrayIN inLow,
-                     DoubleArrayIN inClose, int optInTimePeriod = 14) {
-  if (inHigh.size() == 0 || inLow.size() == 0 || inClose.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  if (inHigh.shape(0) != inLow.shape(0) || inHigh.shape(0) != inClose.shape(0))
-    throw std::runtime_error("Input lengths must match");
-  size_t size = inHigh.shape(0);
-  int lookback = TA_WILLR_Lookback(optInTimePeriod);
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0;
-  int outNBElement = 0;
-  TA_RetCode retCode;
+// DIRECTIONAL MOVEMENT FAMILY, FUSED (DMI_ALL)
+// One shared pass in pytafast_core (core/fused.cpp)
+// ---------------------------------------------------------
+nb::object dmi_all(DoubleArrayIN inHigh, DoubleArrayIN inLow,
+                   DoubleArrayIN inClose, int optInTimePeriod = 14,
+                   const std::string &layout = "tuple") {
+  size_t size = input_length(inHigh, inLow, inClose);
+  if (size == 0) return MultiOutput(0, {0, 0, 0, 0, 0, 0, 0}, layout).result();
+  int lookbacks[pytafast::DMI_NB_OUTPUTS];
+  check_ta_retcode(
+      (TA_RetCode)pytafast::dmi_all_lookbacks(optInTimePeriod, lookbacks),
+      "DMI_ALL");
+
+  MultiOutput out(size,
+                  std::vector<int>(lookbacks, lookbacks + pytafast::DMI_NB_OUTPUTS),
+                  parse_layout(layout));
+  double *rows[pytafast::DMI_NB_OUTPUTS];
+  for (int j = 0; j < pytafast::DMI_NB_OUTPUTS; ++j) rows[j] = out.row(j);
+  int retCode;
   {
-    nb::gil_scoped_release release;
-    retCode = TA_WILLR(0, size - 1, inHigh.data(), inLow.data(), inClose.data(),
-                       optInTimePeriod, &outBegIdx, &outNBElement,
-                       outData + lookback);
+    ComputeScope compute;
+    retCode = pytafast::dmi_all(inHigh.data(), inLow.data(), inClose.data(),
+                                size, optInTimePeriod, rows);
   }
-  check_ta_retcode(retCode, "TA_WILLR");
-  return DoubleArrayOUT(outData, {size}, owner);
+  check_ta_retcode((TA_RetCode)retCode, "DMI_ALL");
+  return out.result();
 }
 
 // ---------------------------------------------------------
-// MONEY FLOW INDEX (MFI)
+// STOCHASTIC FAMILY, FUSED (STOCH_ALL)
+// One highest-high/lowest-low scan in pytafast_core (core/fused.cpp) for
+// any subset of the outputs, in any order
 // ---------------------------------------------------------
-DoubleArrayOUT mfi(DoubleArrayIN inHigh, DoubleArrayIN inLow,
-                   DoubleArrayIN inClose, DoubleArrayIN inVolume,
-                   int optInTimePeriod = 14) {
-  if (inHigh.size() == 0 || inLow.size() == 0 || inClose.size() == 0 ||
-      inVolume.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  if (inHigh.shape(0) != inLow.shape(0) ||
-      inHigh.shape(0) != inClose.shape(0) ||
-      inHigh.shape(0) != inVolume.shape(0))
-    throw std::runtime_error("Input lengths must match");
-  size_t size = inHigh.shape(0);
-  int lookback = TA_MFI_Lookback(optInTimePeriod);
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0;
-  int outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode = TA_MFI(0, size - 1, inHigh.data(), inLow.data(), inClose.data(),
-                     inVolume.data(), optInTimePeriod, &outBegIdx,
-                     &outNBElement, outData + lookback);
-  }
-  check_ta_retcode(retCode, "TA_MFI");
-  return DoubleArrayOUT(outData, {size}, owner);
-}
+using pytafast::StochOutput;
 
-// ---------------------------------------------------------
-// COMMODITY CHANNEL INDEX (CCI)
-// ---------------------------------------------------------
-DoubleArrayOUT cci(DoubleArrayIN inHigh, DoubleArrayIN inLow,
-                   DoubleArrayIN inClose, int optInTimePeriod = 14) {
-  if (inHigh.size() == 0 || inLow.size() == 0 || inClose.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  if (inHigh.shape(0) != inLow.shape(0) || inHigh.shape(0) != inClose.shape(0))
-    throw std::runtime_error("Input lengths must match");
-  size_t size = inHigh.shape(0);
-  int lookback = TA_CCI_Lookback(optInTimePeriod);
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0;
-  int outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode =
-        TA_CCI(0, size - 1, inHigh.data(), inLow.data(), inClose.data(),
-               optInTimePeriod, &outBegIdx, &outNBElement, outData + lookback);
-  }
-  check_ta_retcode(retCode, "TA_CCI");
-  return DoubleArrayOUT(outData, {size}, owner);
+static StochOutput parse_stoch_output(const std::string &name) {
+  if (name == "fastk") return pytafast::STOCH_FASTK;
+  if (name == "fastd") return pytafast::STOCH_FASTD;
+  if (name == "slowk") return pytafast::STOCH_SLOWK;
+  if (name == "slowd") return pytafast::STOCH_SLOWD;
+  if (name == "willr") return pytafast::STOCH_WILLR;
+  throw std::invalid_argument("STOCH_ALL: unknown output '" + name +
+                              "' (expected fastk, fastd, slowk, slowd or willr)");
 }
 
-// ---------------------------------------------------------
-// ULTIMATE OSCILLATOR (ULTOSC)
-// ---------------------------------------------------------
-DoubleArrayOUT ultosc(DoubleArrayIN inHigh, DoubleArrayIN inLow,
-                      DoubleArrayIN inClose, int optInTimePeriod1 = 7,
-                      int optInTimePeriod2 = 14, int optInTimePeriod3 = 28) {
-  if (inHigh.size() == 0 || inLow.size() == 0 || inClose.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  if (inHigh.shape(0) != inLow.shape(0) || inHigh.shape(0) != inClose.shape(0))
-    throw std::runtime_error("Input lengths must match");
-  size_t size = inHigh.shape(0);
-  int lookback =
-      TA_ULTOSC_Lookback(optInTimePeriod1, optInTimePeriod2, optInTimePeriod3);
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0;
-  int outNBElement = 0;
-  TA_RetCode retCode;
+nb::object stoch_all(DoubleArrayIN inHigh, DoubleArrayIN inLow,
+                     DoubleArrayIN inClose,
+                     const std::vector<std::string> &outputs,
+                     int optInFastK_Period = 5, int optInSlowK_Period = 3,
+                     int optInSlowK_MAType = 0, int optInSlowD_Period = 3,
+                     int optInSlowD_MAType = 0, int optInFastD_Period = 3,
+                     int optInFastD_MAType = 0,
+                     const std::string &layout = "tuple") {
+  std::vector<StochOutput> kinds;
+  for (const auto &name : outputs) kinds.push_back(parse_stoch_output(name));
+
+  size_t size = input_length(inHigh, inLow, inClose);
+  if (size == 0) {
+    return MultiOutput(0, std::vector<int>(kinds.size(), 0),
+                       parse_layout(layout))
+        .result();
+  }
+
+  int lookbacks[pytafast::STOCH_NB_OUTPUTS];
+  check_ta_retcode(
+      (TA_RetCode)pytafast::stoch_all_lookbacks(
+          optInFastK_Period, optInSlowK_Period, optInSlowK_MAType,
+          optInSlowD_Period, optInSlowD_MAType, optInFastD_Period,
+          optInFastD_MAType, lookbacks),
+      "STOCH_ALL");
+  std::vector<int> rowLookbacks;
+  for (StochOutput kind : kinds) rowLookbacks.push_back(lookbacks[kind]);
+  MultiOutput out(size, rowLookbacks, parse_layout(layout));
+
+  // Each kind is computed into the first row that requested it
+  double *outData[pytafast::STOCH_NB_OUTPUTS] = {};
+  for (size_t j = kinds.size(); j-- > 0;) outData[kinds[j]] = out.row(j);
+
+  int retCode;
   {
-    nb::gil_scoped_release release;
-    retCode =
-        TA_ULTOSC(0, size - 1, inHigh.data(), inLow.data(), inClose.data(),
-                  optInTimePeriod1, optInTimePeriod2, optInTimePeriod3,
-                  &outBegIdx, &outNBElement, outData + lookback);
+    ComputeScope compute;
+    retCode = pytafast::stoch_all(
+        inHigh.data(), inLow.data(), inClose.data(), size, optInFastK_Period,
+        optInSlowK_Period, optInSlowK_MAType, optInSlowD_Period,
+        optInSlowD_MAType, optInFastD_Period, optInFastD_MAType, outData);
   }
-  check_ta_retcode(retCode, "TA_ULTOSC");
-  return DoubleArrayOUT(outData, {size}, owner);
-}
+  check_ta_retcode((TA_RetCode)retCode, "STOCH_ALL");
 
-// ---------------------------------------------------------
-// BALANCE OF POWER (BOP)
-// ---------------------------------------------------------
-DoubleArrayOUT bop(DoubleArrayIN inOpen, DoubleArrayIN inHigh,
-                   DoubleArrayIN inLow, DoubleArrayIN inClose) {
-  if (inOpen.size() == 0 || inHigh.size() == 0 || inLow.size() == 0 ||
-      inClose.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  if (inOpen.shape(0) != inHigh.shape(0) || inOpen.shape(0) != inLow.shape(0) ||
-      inOpen.shape(0) != inClose.shape(0))
-    throw std::runtime_error("Input lengths must match");
-  size_t size = inOpen.shape(0);
-  int lookback = TA_BOP_Lookback();
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0, outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode =
-        TA_BOP(0, size - 1, inOpen.data(), inHigh.data(), inLow.data(),
-               inClose.data(), &outBegIdx, &outNBElement, outData + lookback);
+  for (size_t j = 0; j < kinds.size(); ++j) {
+    if (outData[kinds[j]] != out.row(j))
+      std::copy(outData[kinds[j]], outData[kinds[j]] + size, out.row(j));
   }
-  check_ta_retcode(retCode, "TA_BOP");
-  return DoubleArrayOUT(outData, {size}, owner);
+  return out.result();
 }
@@ -0,0 +1,127 @@
+#include "nan_policy.h"
+
+namespace {
+
+using DoubleResult =
+    nb::ndarray<nb::numpy, const double, nb::c_contig, nb::ndim<1>>;
+using IntResult = nb::ndarray<nb::numpy, const int, nb::c_contig, nb::ndim<1>>;
+
+template <typename T> std::pair<T *, nb::capsule> alloc_gap_column(size_t n) {
+  T *data = new T[n];
+  std::fill(data, data + n, std::is_integral_v<T> ? T(0) : T(NaN));
+  nb::capsule owner(data, [](void *p) noexcept { delete[] (T *)p; });
+  return {data, std::move(owner)};
+}
+
+// Copy `src` (runs [first, last) back to back) to the runs' positions
+template <typename T>
+void unpack(const T *src, T *dst,
+            const std::vector<std::pair<size_t, size_t>> &runs, size_t first,
+            size_t last) {
+  for (size_t r = first; r < last; ++r) {
+    auto [begin, end] = runs[r];
+    std::copy(src, src + (end - begin), dst + begin);
+    src += end - begin;
+  }
+}
+
+} // namespace
+
+NanPolicy parse_nan_policy(const std::string &policy) {
+  if (policy == "propagate") return NanPolicy::Propagate;
+  if (policy == "skip") return NanPolicy::Skip;
+  if (policy == "restart") return NanPolicy::Restart;
+  throw std::invalid_argument(
+      "nan_policy must be 'propagate', 'skip' or 'restart', got '" + policy +
+      "'");
+}
+
+NanGaps::NanGaps(const NanInputs &inputs) {
+  if (inputs.empty()) return;
+  size_ = inputs[0].shape(0);
+  for (const auto &in : inputs)
+    if (in.shape(0) != size_)
+      throw std::runtime_error("Input lengths must match");
+
+  nb::gil_scoped_release release;
+  size_t begin = 0;
+  bool in_run = false;
+  for (size_t i = 0; i < size_; ++i) {
+    bool valid = true;
+    for (const auto &in : inputs) valid &= !std::isnan(in.data()[i]);
+    if (valid && !in_run) begin = i;
+    if (!valid && in_run) runs_.emplace_back(begin, i);
+    in_run = valid;
+    valid_ += valid;
+  }
+  if (in_run) runs_.emplace_back(begin, size_);
+}
+
+DoubleArrayIN NanGaps::pack(const DoubleArrayIN &in) const {
+  auto [data, owner] = alloc_output(valid_, 0);
+  {
+    nb::gil_scoped_release release;
+    double *out = data;
+    for (auto [begin, end] : runs_)
+      out = std::copy(in.data() + begin, in.data() + end, out);
+  }
+  return DoubleArrayIN(data, {valid_}, owner);
+}
+
+DoubleArrayIN NanGaps::slice(const DoubleArrayIN &in, size_t begin,
+                             size_t end) {
+  // Only lives for the duration of one kernel call on `in`
+  return DoubleArrayIN(in.data() + begin, {end - begin}, nb::handle());
+}
+
+void GapResult::write(nb::handle result, size_t first, size_t last) {
+  if (nb::isinstance<nb::tuple>(result)) {
+    tuple_ = true;
+    nb::tuple outs = nb::borrow<nb::tuple>(result);
+    for (size_t j = 0; j < outs.size(); ++j)
+      write_column(j, outs[j], first, last);
+  } else {
+    write_column(0, result, first, last);
+  }
+}
+
+void GapResult::write_column(size_t j, nb::handle array, size_t first,
+                             size_t last) {
+  const auto &runs = gaps_.runs();
+  DoubleResult real;
+  IntResult integer;
+  if (nb::try_cast(array, real, false)) {
+    if (j == columns_.size()) {
+      auto [data, owner] = alloc_gap_column<double>(gaps_.size());
+      columns_.push_back({false, data, std::move(owner)});
+    }
+    nb::gil_scoped_release release;
+    unpack(real.data(), static_cast<double *>(columns_[j].data), runs, first,
+           last);
+  } else if (nb::try_cast(array, integer, false)) {
+    if (j == columns_.size()) {
+      auto [data, owner] = alloc_gap_column<int>(gaps_.size());
+      columns_.push_back({true, data, std::move(owner)});
+    }
+    nb::gil_scoped_release release;
+    unpack(integer.data(), static_cast<int *>(columns_[j].data), runs, first,
+           last);
+  } else {
+    throw std::invalid_argument(
+        "nan_policy='skip' and 'restart' need 1-D results; use "
+        "layout='tuple' for multi-output functions");
+  }
+}
+
+nb::object GapResult::result() const {
+  nb::list outs;
+  for (const auto &column : columns_) {
+    if (column.integer)
+      outs.append(nb::ndarray<nb::numpy, int, nb::ndim<1>>(
+          column.data, {gaps_.size()}, column.owner));
+    else
+      outs.append(DoubleArrayOUT(column.data, {gaps_.size()}, column.owner));
+  }
+  if (tuple_) return nb::tuple(outs);
+  return outs[0];
+}
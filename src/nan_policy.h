@@ -0,0 +1,109 @@
+#pragma once
+// NaN-gap handling (nan_policy=...).
+//
+// A gap is a bar where any input is NaN, e.g. a trading halt. TA-Lib carries
+// the NaN through its recursive state, so by default every output after the
+// first gap is NaN too. The other policies run the kernel on the valid bars
+// only and write the results back at their original positions in one pass:
+//   "propagate" - TA-Lib as-is (default)
+//   "skip"      - one run over all valid bars packed together, as if the
+//                 gap bars were not there
+//   "restart"   - each run of consecutive valid bars on its own, each with
+//                 its own lookback
+// Gap bars are NaN in float outputs and 0 in integer outputs.
+#include "common.h"
+#include <type_traits>
+#include <utility>
+
+enum class NanPolicy { Propagate, Skip, Restart };
+
+NanPolicy parse_nan_policy(const std::string &policy);
+
+using NanInputs = std::vector<DoubleArrayIN>;
+
+// Runs of valid bars across a set of equal-length inputs
+class NanGaps {
+public:
+  explicit NanGaps(const NanInputs &inputs);
+
+  size_t size() const { return size_; }
+  size_t valid() const { return valid_; }
+  // [begin, end) of each run of valid bars, in order
+  const std::vector<std::pair<size_t, size_t>> &runs() const { return runs_; }
+
+  // The valid bars of `in` packed into a new array
+  DoubleArrayIN pack(const DoubleArrayIN &in) const;
+  // Bars [begin, end) of `in`, viewed in place
+  static DoubleArrayIN slice(const DoubleArrayIN &in, size_t begin,
+                             size_t end);
+
+private:
+  size_t size_ = 0, valid_ = 0;
+  std::vector<std::pair<size_t, size_t>> runs_;
+};
+
+// Full-length outputs that per-run kernel results are written into. Accepts
+// what the kernels return: a 1-D float64 or int32 array, or a tuple of them
+// (multi-output functions with layout="tuple").
+class GapResult {
+public:
+  explicit GapResult(const NanGaps &gaps) : gaps_(gaps) {}
+
+  // `result` covers runs [first, last) back to back
+  void write(nb::handle result, size_t first, size_t last);
+  nb::object result() const;
+
+private:
+  struct Column {
+    bool integer;
+    void *data;
+    nb::capsule owner;
+  };
+
+  void write_column(size_t j, nb::handle array, size_t first, size_t last);
+
+  const NanGaps &gaps_;
+  bool tuple_ = false;
+  std::vector<Column> columns_;
+};
+
+template <typename R> nb::object as_object(R &&result) {
+  if constexpr (std::is_base_of_v<nb::handle, std::decay_t<R>>)
+    return std::forward<R>(result);
+  else
+    return nb::cast(std::forward<R>(result));
+}
+
+// Calls `kernel(const NanInputs &)` under `policy`: once on `inputs` for
+// "propagate" or when there is nothing to do, else on the packed valid bars
+// ("skip") or once per run ("restart")
+template <typename Kernel>
+nb::object apply_nan_policy(NanPolicy policy, NanInputs inputs,
+                            Kernel &&kernel) {
+  if (policy == NanPolicy::Propagate) return as_object(kernel(inputs));
+  NanGaps gaps(inputs);
+  if (gaps.valid() == gaps.size() || gaps.valid() == 0)
+    return as_object(kernel(inputs));
+
+  GapResult out(gaps);
+  const auto &runs = gaps.runs();
+  if (policy == NanPolicy::Skip) {
+    for (auto &in : inputs) in = gaps.pack(in);
+    out.write(as_object(kernel(inputs)), 0, runs.size());
+  } else {
+    NanInputs slices(inputs.size());
+    for (size_t r = 0; r < runs.size(); ++r) {
+      for (size_t j = 0; j < inputs.size(); ++j)
+        slices[j] = NanGaps::slice(inputs[j], runs[r].first, runs[r].second);
+      out.write(as_object(kernel(slices)), r, r + 1);
+    }
+  }
+  return out.result();
+}
+
+template <typename Kernel>
+nb::object apply_nan_policy(const std::string &policy, NanInputs inputs,
+                            Kernel &&kernel) {
+  return apply_nan_policy(parse_nan_policy(policy), std::move(inputs),
+                          std::forward<Kernel>(kernel));
+}
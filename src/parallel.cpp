@@ -0,0 +1,57 @@
+#include "parallel.h"
+
+namespace {
+
+template <typename T>
+nb::object compute_rows(const FunctionInfo &fn, size_t count, size_t size,
+                        const std::vector<const double *> &in,
+                        const std::vector<double> &params, unsigned threads) {
+  using ArrayOUT2D = nb::ndarray<nb::numpy, T, nb::ndim<2>>;
+  const size_t n_outputs = fn.outputs.size();
+  std::vector<T *> out;
+  std::vector<nb::capsule> owners;
+  {
+    AllocScope alloc(count * size * n_outputs,
+                     count * size * n_outputs * sizeof(T));
+    for (size_t k = 0; k < n_outputs; ++k) {
+      T *data = new T[count * size];
+      owners.emplace_back(data, [](void *p) noexcept { delete[] (T *)p; });
+      out.push_back(data);
+    }
+  }
+  {
+    ComputeScope compute;
+    pytafast::compute_many(fn, count, size, in, params, out, threads);
+  }
+  if (n_outputs == 1)
+    return nb::cast(ArrayOUT2D(out[0], {count, size}, owners[0]));
+  nb::list results;
+  for (size_t k = 0; k < n_outputs; ++k)
+    results.append(ArrayOUT2D(out[k], {count, size}, owners[k]));
+  return nb::tuple(results);
+}
+
+} // namespace
+
+nb::object compute_many_py(const std::string &name,
+                           const std::vector<DoubleArray2DIN> &inputs,
+                           const std::vector<double> &params,
+                           unsigned threads) {
+  const FunctionInfo &fn = find_function(name);
+  TraceScope trace(fn.name);
+  if (inputs.size() != fn.inputs.size())
+    throw nb::type_error((std::string(fn.name) + " takes " +
+                          std::to_string(fn.inputs.size()) + " input arrays")
+                             .c_str());
+  const size_t count = inputs.empty() ? 0 : inputs[0].shape(0);
+  const size_t size = inputs.empty() ? 0 : inputs[0].shape(1);
+  std::vector<const double *> in;
+  for (const auto &input : inputs) {
+    if (input.shape(0) != count || input.shape(1) != size)
+      throw std::runtime_error("Input shapes must match");
+    in.push_back(input.data());
+  }
+  if (fn.integer_output)
+    return compute_rows<int>(fn, count, size, in, params, threads);
+  return compute_rows<double>(fn, count, size, in, params, threads);
+}
@@ -0,0 +1,17 @@
+#pragma once
+// Many series in one call for pytafast.parallel.ThreadEngine: the rows are
+// spread over threads by pytafast_core (pytafast::compute_many) while the
+// GIL stays released, so they run in parallel inside one interpreter.
+#include "registry.h"
+
+using DoubleArray2DIN =
+    nb::ndarray<nb::numpy, const double, nb::c_contig, nb::ndim<2>>;
+
+// `name` over every row of the (count, size) inputs, params in registry
+// order (trailing ones may be left out), on `threads` threads (0: one per
+// hardware thread). One (count, size) array per output: a tuple when there
+// are several
+nb::object compute_many_py(const std::string &name,
+                           const std::vector<DoubleArray2DIN> &inputs,
+                           const std::vector<double> &params,
+                           unsigned threads);
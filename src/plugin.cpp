@@ -0,0 +1,107 @@
+#include "plugin.h"
+
+namespace {
+
+// kernel(*inputs, *params[, layout]) for a registered function: inputs are
+// float64 arrays, params numbers in registry order (trailing ones may be
+// left out), layout as for the TA-Lib multi-output functions
+nb::object call_registered(const FunctionInfo &fn, nb::args args) {
+  const size_t n_inputs = fn.inputs.size(), n_outputs = fn.outputs.size();
+  if (args.size() < n_inputs)
+    throw nb::type_error((std::string(fn.name) + " takes " +
+                          std::to_string(n_inputs) + " input arrays")
+                             .c_str());
+  std::vector<DoubleArrayIN> inputs;
+  for (size_t j = 0; j < n_inputs; ++j)
+    inputs.push_back(nb::cast<DoubleArrayIN>(args[j]));
+  std::string layout = "tuple";
+  std::vector<double> params;
+  for (size_t j = n_inputs; j < args.size(); ++j) {
+    if (nb::isinstance<nb::str>(args[j]))
+      layout = nb::cast<std::string>(args[j]);
+    else
+      params.push_back(nb::cast<double>(args[j]));
+  }
+  params = pytafast::resolve_params(fn, params);
+
+  const size_t size = inputs[0].shape(0);
+  std::vector<pytafast::span<const double>> in;
+  for (const auto &input : inputs) {
+    if (input.shape(0) != size)
+      throw std::runtime_error("Input lengths must match");
+    in.emplace_back(input.data(), size);
+  }
+  const int lookback = std::max(fn.lookback(params.data()), 0);
+
+  if (fn.integer_output) {
+    if (n_outputs > 1 && parse_layout(layout) != OutputLayout::Tuple)
+      throw std::invalid_argument(std::string(fn.name) +
+                                  ": integer outputs need layout='tuple'");
+    std::vector<AllocResult<int>> outputs;
+    std::vector<pytafast::span<int>> out;
+    for (size_t k = 0; k < n_outputs; ++k) {
+      outputs.push_back(alloc_output<int>(size, lookback));
+      out.emplace_back(outputs.back().data, size);
+    }
+    {
+      ComputeScope compute;
+      pytafast::compute(fn, in, params, out);
+    }
+    if (n_outputs == 1)
+      return nb::cast(IntArrayOUT(outputs[0].data, {size}, outputs[0].owner));
+    nb::list results;
+    for (auto &output : outputs)
+      results.append(IntArrayOUT(output.data, {size}, output.owner));
+    return nb::tuple(results);
+  }
+
+  if (n_outputs == 1) {
+    auto [data, owner] = alloc_output(size, lookback);
+    pytafast::span<double> out[] = {{data, size}};
+    {
+      ComputeScope compute;
+      pytafast::compute(fn, in, params, out);
+    }
+    return nb::cast(DoubleArrayOUT(data, {size}, owner));
+  }
+  MultiOutput result(size, std::vector<int>(n_outputs, lookback),
+                     parse_layout(layout));
+  std::vector<pytafast::span<double>> out;
+  for (size_t k = 0; k < n_outputs; ++k) out.emplace_back(result.row(k), size);
+  {
+    ComputeScope compute;
+    pytafast::compute(fn, in, params, out);
+  }
+  return result.result();
+}
+
+// A registered function's kernel, with its calls traced and counted under
+// its name (which lives as long as the process: plugins stay loaded)
+struct Kernel {
+  const FunctionInfo *fn;
+#ifdef PYTAFAST_STATS
+  FunctionStats *stats = &function_stats(fn->name);
+#endif
+
+  nb::object operator()(nb::args args) const {
+    TraceScope trace(fn->name);
+#ifdef PYTAFAST_STATS
+    CallScope call(*stats);
+#endif
+    return call_registered(*fn, args);
+  }
+};
+
+} // namespace
+
+nb::dict load_plugin_py(const std::string &path) {
+  std::vector<const FunctionInfo *> functions;
+  {
+    nb::gil_scoped_release release;
+    functions = pytafast::load_plugin(path);
+  }
+  nb::dict kernels;
+  for (const FunctionInfo *fn : functions)
+    kernels[fn->name] = nb::cpp_function(Kernel{fn}, nb::name(fn->name));
+  return kernels;
+}
@@ -0,0 +1,12 @@
+#pragma once
+// Native indicator plugins for Python (pytafast.load_plugin).
+//
+// pytafast_core loads the library and registers its functions
+// (core/plugin.cpp). Each registered function gets a raw kernel called like
+// the pytafast_ext.<NAME> bindings, kernel(*inputs, *params[, layout]), so
+// the Python wrappers give it the same pandas, nan_policy, cache and layout
+// handling as the TA-Lib functions.
+#include "registry.h"
+
+// Loads the plugin at `path`: {name: kernel} for each of its functions
+nb::dict load_plugin_py(const std::string &path);
@@ -0,0 +1,510 @@
+// pytafast_polars - the native Polars expression plugin behind
+// pytafast.polars (pl.col("close").ta.rsi(14).over("symbol")).
+//
+// Polars loads this library itself (polars.plugins.register_plugin_function)
+// and calls _polars_plugin_ta from its own thread pool, once per batch or per
+// group under .over(), without the GIL. Inputs arrive as Arrow arrays through
+// polars-ffi's SeriesExport; a float64 chunk without nulls goes to
+// pytafast::compute in place. The outputs are allocated here and handed to
+// Polars as Arrow arrays that own them, so nothing is copied on the way out.
+//
+// The keyword arguments are the dict pytafast.polars builds, pickled by
+// Polars:
+//   {"function": "RSI", "params": [14.0], "outputs": [], "plugin": ""}
+// params holds every parameter of the function in order, outputs the
+// outputs to return as a struct (empty: the only output, as a plain
+// column) and plugin the library of a function from pytafast.load_plugin.
+// NaN outputs, the lookback region included, are null; null inputs are NaN.
+#include "arrow_abi.h"
+#include <pytafast/core.h>
+
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#define PYTAFAST_POLARS_EXPORT extern "C" __declspec(dllexport)
+#else
+#define PYTAFAST_POLARS_EXPORT extern "C" __attribute__((visibility("default")))
+#endif
+
+// polars-ffi (version 0): a Series as its field and one ArrowArray per chunk
+struct SeriesExport {
+  ArrowSchema *field;
+  ArrowArray **arrays;
+  size_t len;
+  void (*release)(SeriesExport *);
+  void *private_data;
+};
+
+struct CallerContext {
+  uint64_t bitflags;
+};
+
+namespace {
+
+using pytafast::FunctionInfo;
+
+thread_local std::string last_error;
+
+void ensure_initialized() {
+  // Polars never unloads a plugin, so the context is never shut down
+  static const bool initialized = (pytafast::initialize(), true);
+  (void)initialized;
+}
+
+// --- Keyword arguments ---
+
+// The subset of the pickle format (protocol 2 to 5) that a dict of strings,
+// numbers and lists of them is written with
+class Unpickler {
+public:
+  struct Value {
+    enum Kind { None, Number, Text, List, Dict, Mark } kind = None;
+    double number = 0;
+    std::string text;
+    // List items, or dict keys and values in turn
+    std::vector<std::shared_ptr<Value>> items;
+  };
+  using ValuePtr = std::shared_ptr<Value>;
+
+  Unpickler(const uint8_t *data, size_t size) : p_(data), end_(data + size) {}
+
+  ValuePtr load() {
+    for (;;) {
+      const uint8_t op = byte();
+      switch (op) {
+      case 0x80: byte(); break;  // PROTO
+      case 0x95: bytes(8); break; // FRAME
+      case '.': return pop();     // STOP
+      case '(': push(Value::Mark); break;
+      case '}': push(Value::Dict); break;
+      case ']': push(Value::List); break;
+      case 'N': push(Value::None); break;
+      case 0x88: number(1); break; // NEWTRUE
+      case 0x89: number(0); break; // NEWFALSE
+      case 'K': number(byte()); break;
+      case 'M': number(static_cast<double>(little(2))); break;
+      case 'J': number(static_cast<int32_t>(little(4))); break;
+      case 'G': {
+        uint64_t bits = 0;
+        for (int i = 0; i < 8; ++i) bits = (bits << 8) | byte();
+        double value;
+        std::memcpy(&value, &bits, sizeof value);
+        number(value);
+        break;
+      }
+      case 0x8c: text(byte()); break; // SHORT_BINUNICODE
+      case 'X': text(little(4)); break; // BINUNICODE
+      case 0x94: memo_.push_back(top()); break; // MEMOIZE
+      case 'h': stack_.push_back(memo(byte())); break;
+      case 'j': stack_.push_back(memo(little(4))); break;
+      case 'a': { // APPEND
+        ValuePtr item = pop();
+        top()->items.push_back(item);
+        break;
+      }
+      case 's': { // SETITEM
+        ValuePtr value = pop();
+        ValuePtr key = pop();
+        top()->items.push_back(key);
+        top()->items.push_back(value);
+        break;
+      }
+      case 'e': // APPENDS
+      case 'u': { // SETITEMS
+        std::vector<ValuePtr> items = pop_to_mark();
+        top()->items.insert(top()->items.end(), items.begin(), items.end());
+        break;
+      }
+      default:
+        throw std::invalid_argument("unsupported pickle opcode " +
+                                    std::to_string(op));
+      }
+    }
+  }
+
+private:
+  uint8_t byte() {
+    if (p_ == end_) throw std::invalid_argument("truncated pickle");
+    return *p_++;
+  }
+  const uint8_t *bytes(size_t n) {
+    if (static_cast<size_t>(end_ - p_) < n)
+      throw std::invalid_argument("truncated pickle");
+    const uint8_t *start = p_;
+    p_ += n;
+    return start;
+  }
+  uint32_t little(int n) {
+    uint32_t value = 0;
+    for (int i = 0; i < n; ++i) value |= static_cast<uint32_t>(byte()) << (8 * i);
+    return value;
+  }
+  void push(Value::Kind kind) {
+    stack_.push_back(std::make_shared<Value>());
+    stack_.back()->kind = kind;
+  }
+  void number(double value) {
+    push(Value::Number);
+    stack_.back()->number = value;
+  }
+  void text(size_t size) {
+    const uint8_t *data = bytes(size);
+    push(Value::Text);
+    stack_.back()->text.assign(reinterpret_cast<const char *>(data), size);
+  }
+  ValuePtr top() {
+    if (stack_.empty()) throw std::invalid_argument("malformed pickle");
+    return stack_.back();
+  }
+  ValuePtr pop() {
+    ValuePtr value = top();
+    stack_.pop_back();
+    return value;
+  }
+  ValuePtr memo(size_t index) {
+    if (index >= memo_.size()) throw std::invalid_argument("malformed pickle");
+    return memo_[index];
+  }
+  std::vector<ValuePtr> pop_to_mark() {
+    std::vector<ValuePtr> items;
+    while (top()->kind != Value::Mark) items.insert(items.begin(), pop());
+    pop();
+    return items;
+  }
+
+  const uint8_t *p_;
+  const uint8_t *end_;
+  std::vector<ValuePtr> stack_;
+  std::vector<ValuePtr> memo_;
+};
+
+struct Call {
+  const FunctionInfo *fn;
+  std::vector<double> params;
+  // Indexes into fn->outputs; empty for the only output as a plain column
+  std::vector<size_t> outputs;
+};
+
+Call parse_call(const uint8_t *kwargs, size_t size) {
+  using Value = Unpickler::Value;
+  Unpickler::ValuePtr dict = Unpickler(kwargs, size).load();
+  if (dict->kind != Value::Dict)
+    throw std::invalid_argument("plugin keyword arguments must be a dict");
+  std::string function, plugin;
+  Unpickler::ValuePtr params, outputs;
+  for (size_t i = 0; i + 1 < dict->items.size(); i += 2) {
+    const std::string &key = dict->items[i]->text;
+    const Unpickler::ValuePtr &value = dict->items[i + 1];
+    if (key == "function") function = value->text;
+    else if (key == "plugin") plugin = value->text;
+    else if (key == "params") params = value;
+    else if (key == "outputs") outputs = value;
+  }
+
+  if (!plugin.empty()) pytafast::load_plugin(plugin);
+  Call call{&pytafast::find_function(function), {}, {}};
+  if (params)
+    for (const auto &item : params->items) {
+      if (item->kind != Value::Number)
+        throw std::invalid_argument(function + ": parameters must be numbers");
+      call.params.push_back(item->number);
+    }
+  if (outputs)
+    for (const auto &item : outputs->items) {
+      const auto &names = call.fn->outputs;
+      size_t k = 0;
+      while (k < names.size() && item->text != names[k]) ++k;
+      if (k == names.size())
+        throw std::invalid_argument(function + " has no output '" +
+                                    item->text + "'");
+      call.outputs.push_back(k);
+    }
+  return call;
+}
+
+// --- Results ---
+
+// Owns the names and children of an exported schema
+struct SchemaData {
+  std::string name;
+  std::vector<std::string> field_names;
+  std::vector<ArrowSchema> fields;
+  std::vector<ArrowSchema *> children;
+};
+
+void release_child_schema(ArrowSchema *schema) { schema->release = nullptr; }
+
+void release_schema(ArrowSchema *schema) {
+  auto *data = static_cast<SchemaData *>(schema->private_data);
+  for (ArrowSchema *child : data->children)
+    if (child->release) child->release(child);
+  delete data;
+  schema->release = nullptr;
+}
+
+// float64 ("g") or int32 ("i") named `name`; a struct of such fields when
+// `fields` is not empty
+void export_schema(ArrowSchema *out, const std::string &name,
+                   const char *format, const std::vector<std::string> &fields) {
+  auto *data = new SchemaData{name, fields, {}, {}};
+  data->fields.resize(fields.size());
+  for (size_t k = 0; k < fields.size(); ++k) {
+    data->fields[k] = ArrowSchema{format, data->field_names[k].c_str(),
+                                  nullptr, ARROW_FLAG_NULLABLE, 0, nullptr,
+                                  nullptr, release_child_schema, data};
+    data->children.push_back(&data->fields[k]);
+  }
+  *out = ArrowSchema{fields.empty() ? format : "+s",
+                     data->name.c_str(),
+                     nullptr,
+                     ARROW_FLAG_NULLABLE,
+                     static_cast<int64_t>(fields.size()),
+                     data->children.empty() ? nullptr : data->children.data(),
+                     nullptr,
+                     release_schema,
+                     data};
+}
+
+// One output column: its values, validity bitmap and ArrowArray
+struct Column {
+  std::vector<double> real;
+  std::vector<int> integer;
+  std::vector<uint8_t> validity;
+  const void *buffers[2] = {nullptr, nullptr};
+  ArrowArray array{};
+};
+
+// Owns every buffer of an exported array, struct children included
+struct ArrayData {
+  std::vector<std::unique_ptr<Column>> columns;
+  std::vector<ArrowArray *> children;
+  const void *buffers[1] = {nullptr};
+};
+
+void release_child_array(ArrowArray *array) { array->release = nullptr; }
+
+void release_array(ArrowArray *array) {
+  auto *data = static_cast<ArrayData *>(array->private_data);
+  for (ArrowArray *child : data->children)
+    if (child->release) child->release(child);
+  delete data;
+  array->release = nullptr;
+}
+
+// Fills in column.array over its own buffers; NaN values are null
+void finish_column(Column &column, size_t size, void *owner) {
+  int64_t null_count = 0;
+  if (!column.real.empty()) {
+    for (size_t i = 0; i < size; ++i) {
+      if (!std::isnan(column.real[i])) continue;
+      if (column.validity.empty()) column.validity.assign((size + 7) / 8, 0xFF);
+      // LSB-first bitmap, 1 = valid
+      column.validity[i >> 3] &= static_cast<uint8_t>(~(1u << (i & 7)));
+      ++null_count;
+    }
+    column.buffers[1] = column.real.data();
+  } else {
+    column.buffers[1] = column.integer.data();
+  }
+  column.buffers[0] = column.validity.empty() ? nullptr : column.validity.data();
+  column.array = ArrowArray{static_cast<int64_t>(size),
+                            null_count,
+                            0,
+                            2,
+                            0,
+                            column.buffers,
+                            nullptr,
+                            nullptr,
+                            release_child_array,
+                            owner};
+}
+
+// The ArrowArray handed to Polars: the column itself for one output, a
+// struct over the columns otherwise
+void export_array(ArrowArray *out, std::unique_ptr<ArrayData> data,
+                  size_t size, bool as_struct) {
+  for (auto &column : data->columns) finish_column(*column, size, data.get());
+  if (as_struct) {
+    for (auto &column : data->columns) data->children.push_back(&column->array);
+    *out = ArrowArray{static_cast<int64_t>(size),
+                      0,
+                      0,
+                      1,
+                      static_cast<int64_t>(data->children.size()),
+                      data->buffers,
+                      data->children.data(),
+                      nullptr,
+                      release_array,
+                      data.get()};
+  } else {
+    *out = data->columns[0]->array;
+    out->release = release_array;
+  }
+  data.release();
+}
+
+// What a returned SeriesExport points to. Polars moves the array out of
+// `array` and releases it itself; the export's release frees the rest.
+struct ExportData {
+  ArrowSchema field{};
+  ArrowArray array{};
+  ArrowArray *arrays[1];
+};
+
+void release_export(SeriesExport *series) {
+  auto *data = static_cast<ExportData *>(series->private_data);
+  if (data->field.release) data->field.release(&data->field);
+  delete data;
+  series->release = nullptr;
+}
+
+// --- Inputs ---
+
+// Releases the inputs, which the callee owns, however the call ends
+class Inputs {
+public:
+  Inputs(const SeriesExport *series, size_t count)
+      : series_(series), count_(count) {}
+  ~Inputs() {
+    for (size_t i = 0; i < count_; ++i) {
+      SeriesExport series = series_[i];
+      for (size_t c = 0; c < series.len; ++c)
+        if (series.arrays[c]->release) series.arrays[c]->release(series.arrays[c]);
+      if (series.release) series.release(&series);
+    }
+  }
+  Inputs(const Inputs &) = delete;
+  Inputs &operator=(const Inputs &) = delete;
+
+  size_t size() const { return count_; }
+  const SeriesExport &operator[](size_t i) const { return series_[i]; }
+
+private:
+  const SeriesExport *series_;
+  size_t count_;
+};
+
+// One input as contiguous float64: the chunk in place when it is a single
+// chunk without nulls, else a copy with nulls as NaN
+pytafast::span<const double> as_doubles(const SeriesExport &series,
+                                        std::vector<double> &copy) {
+  if (std::strcmp(series.field->format, "g") != 0)
+    throw std::invalid_argument(std::string("input '") + series.field->name +
+                                "' must be Float64");
+  if (series.len == 1) {
+    const ArrowArray &chunk = *series.arrays[0];
+    // A null_count of -1 means "unknown"
+    if (chunk.null_count == 0 || !chunk.buffers[0])
+      return {static_cast<const double *>(chunk.buffers[1]) + chunk.offset,
+              static_cast<size_t>(chunk.length)};
+  }
+  for (size_t c = 0; c < series.len; ++c) {
+    const ArrowArray &chunk = *series.arrays[c];
+    const auto *values = static_cast<const double *>(chunk.buffers[1]);
+    const auto *validity = static_cast<const uint8_t *>(chunk.buffers[0]);
+    for (int64_t i = 0; i < chunk.length; ++i) {
+      const int64_t bit = chunk.offset + i;
+      const bool valid = !validity || ((validity[bit >> 3] >> (bit & 7)) & 1);
+      copy.push_back(valid ? values[bit] : std::nan(""));
+    }
+  }
+  return copy;
+}
+
+std::vector<std::string> field_names(const Call &call) {
+  std::vector<std::string> names;
+  for (size_t k : call.outputs) names.emplace_back(call.fn->outputs[k]);
+  return names;
+}
+
+} // namespace
+
+PYTAFAST_POLARS_EXPORT uint32_t _polars_plugin_get_version() {
+  // polars-ffi major version 0, minor 1
+  return (0u << 16) | 1u;
+}
+
+PYTAFAST_POLARS_EXPORT const char *_polars_plugin_get_last_error_message() {
+  return last_error.c_str();
+}
+
+// The output field, for Polars' schema resolution
+PYTAFAST_POLARS_EXPORT void
+_polars_plugin_field_ta(const ArrowSchema *fields, size_t n_fields,
+                        ArrowSchema *result, const uint8_t *kwargs,
+                        size_t kwargs_len) {
+  try {
+    const Call call = parse_call(kwargs, kwargs_len);
+    if (n_fields != call.fn->inputs.size())
+      throw std::invalid_argument(std::string(call.fn->name) + " takes " +
+                                  std::to_string(call.fn->inputs.size()) +
+                                  " inputs");
+    export_schema(result, n_fields ? fields[0].name : call.fn->name,
+                  call.fn->integer_output ? "i" : "g", field_names(call));
+  } catch (const std::exception &e) {
+    last_error = e.what();
+  }
+}
+
+PYTAFAST_POLARS_EXPORT void
+_polars_plugin_ta(const SeriesExport *series, size_t n_series,
+                  const uint8_t *kwargs, size_t kwargs_len,
+                  SeriesExport *result, CallerContext *) {
+  Inputs inputs(series, n_series);
+  try {
+    ensure_initialized();
+    const Call call = parse_call(kwargs, kwargs_len);
+    const FunctionInfo &fn = *call.fn;
+
+    std::vector<std::vector<double>> copies(inputs.size());
+    std::vector<pytafast::span<const double>> in;
+    for (size_t i = 0; i < inputs.size(); ++i)
+      in.push_back(as_doubles(inputs[i], copies[i]));
+    const size_t size = in.empty() ? 0 : in[0].size();
+
+    // Every output is computed; the ones not asked for are dropped
+    auto data = std::make_unique<ArrayData>();
+    for (size_t k = 0; k < fn.outputs.size(); ++k) {
+      data->columns.push_back(std::make_unique<Column>());
+      if (fn.integer_output) data->columns.back()->integer.resize(size);
+      else data->columns.back()->real.resize(size);
+    }
+    if (fn.integer_output) {
+      std::vector<pytafast::span<int>> out;
+      for (auto &column : data->columns) out.emplace_back(column->integer);
+      pytafast::compute(fn, in, call.params, out);
+    } else {
+      std::vector<pytafast::span<double>> out;
+      for (auto &column : data->columns) out.emplace_back(column->real);
+      pytafast::compute(fn, in, call.params, out);
+    }
+    if (!call.outputs.empty()) {
+      std::vector<std::unique_ptr<Column>> selected;
+      for (size_t k : call.outputs) {
+        if (!data->columns[k])
+          throw std::invalid_argument(std::string(fn.name) +
+                                      ": an output is asked for twice");
+        selected.push_back(std::move(data->columns[k]));
+      }
+      data->columns = std::move(selected);
+    }
+
+    auto exported = std::make_unique<ExportData>();
+    export_schema(&exported->field,
+                  inputs.size() ? inputs[0].field->name : fn.name,
+                  fn.integer_output ? "i" : "g", field_names(call));
+    export_array(&exported->array, std::move(data), size,
+                 !call.outputs.empty());
+    exported->arrays[0] = &exported->array;
+    *result = SeriesExport{&exported->field, exported->arrays, 1,
+                           release_export, exported.get()};
+    exported.release();
+  } catch (const std::exception &e) {
+    last_error = e.what();
+  }
+}
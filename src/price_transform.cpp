@@ -1,51 +1,15 @@
-// Price Transform: AVGPRICE, MEDPRICE, TYPPRICE, WCLPRICE, MIDPRICE
-#include "common.h"
+// Price Transform: AVGPRICE, TYPPRICE, WCLPRICE, PRICE_ALL
+// (MEDPRICE, MIDPRICE are in the function table, core/function_list.h)
+#include "core/fused.h"
+#include "kernel.h"
 
 // ---------------------------------------------------------
 // AVERAGE PRICE
 // ---------------------------------------------------------
 DoubleArrayOUT avgprice(DoubleArrayIN inOpen, DoubleArrayIN inHigh,
                         DoubleArrayIN inLow, DoubleArrayIN inClose) {
-  if (inOpen.size() == 0 || inHigh.size() == 0 || inLow.size() == 0 ||
-      inClose.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  size_t size = inOpen.shape(0);
-  int lookback = TA_AVGPRICE_Lookback();
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0, outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode = TA_AVGPRICE(0, size - 1, inOpen.data(), inHigh.data(),
-                          inLow.data(), inClose.data(), &outBegIdx,
-                          &outNBElement, outData + lookback);
-  }
-  check_ta_retcode(retCode, "TA_AVGPRICE");
-  return DoubleArrayOUT(outData, {size}, owner);
-}
-
-// ---------------------------------------------------------
-// MEDIAN PRICE
-// ---------------------------------------------------------
-DoubleArrayOUT medprice(DoubleArrayIN inHigh, DoubleArrayIN inLow) {
-  if (inHigh.size() == 0 || inLow.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  if (inHigh.shape(0) != inLow.shape(0))
-    throw std::runtime_error("Input lengths must match");
-  size_t size = inHigh.shape(0);
-  int lookback = TA_MEDPRICE_Lookback();
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0, outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode = TA_MEDPRICE(0, size - 1, inHigh.data(), inLow.data(), &outBegIdx,
-                          &outNBElement, outData + lookback);
-  }
-  check_ta_retcode(retCode, "TA_MEDPRICE");
-  return DoubleArrayOUT(outData, {size}, owner);
+  return ta_call("TA_AVGPRICE", TA_AVGPRICE, TA_AVGPRICE_Lookback(),
+                 std::tie(inOpen, inHigh, inLow, inClose));
 }
 
 // ---------------------------------------------------------
@@ -53,24 +17,8 @@ DoubleArrayOUT medprice(DoubleArrayIN inHigh, DoubleArrayIN inLow) {
 // ---------------------------------------------------------
 DoubleArrayOUT typprice(DoubleArrayIN inHigh, DoubleArrayIN inLow,
                         DoubleArrayIN inClose) {
-  if (inHigh.size() == 0 || inLow.size() == 0 || inClose.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  if (inHigh.shape(0) != inLow.shape(0) || inHigh.shape(0) != inClose.shape(0))
-    throw std::runtime_error("Input lengths must match");
-  size_t size = inHigh.shape(0);
-  int lookback = TA_TYPPRICE_Lookback();
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0, outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode =
-        TA_TYPPRICE(0, size - 1, inHigh.data(), inLow.data(), inClose.data(),
-                    &outBegIdx, &outNBElement, outData + lookback);
-  }
-  check_ta_retcode(retCode, "TA_TYPPRICE");
-  return DoubleArrayOUT(outData, {size}, owner);
+  return ta_call("TA_TYPPRICE", TA_TYPPRICE, TA_TYPPRICE_Lookback(),
+                 std::tie(inHigh, inLow, inClose));
 }
 
 // ---------------------------------------------------------
@@ -78,47 +26,58 @@ DoubleArrayOUT typprice(DoubleArrayIN inHigh, DoubleArrayIN inLow,
 // ---------------------------------------------------------
 DoubleArrayOUT wclprice(DoubleArrayIN inHigh, DoubleArrayIN inLow,
                         DoubleArrayIN inClose) {
-  if (inHigh.size() == 0 || inLow.size() == 0 || inClose.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  if (inHigh.shape(0) != inLow.shape(0) || inHigh.shape(0) != inClose.shape(0))
-    throw std::runtime_error("Input lengths must match");
-  size_t size = inHigh.shape(0);
-  int lookback = TA_WCLPRICE_Lookback();
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0, outNBElement = 0;
-  TA_RetCode retCode;
-  {
-    nb::gil_scoped_release release;
-    retCode =
-        TA_WCLPRICE(0, size - 1, inHigh.data(), inLow.data(), inClose.data(),
-                    &outBegIdx, &outNBElement, outData + lookback);
-  }
-  check_ta_retcode(retCode, "TA_WCLPRICE");
-  return DoubleArrayOUT(outData, {size}, owner);
+  return ta_call("TA_WCLPRICE", TA_WCLPRICE, TA_WCLPRICE_Lookback(),
+                 std::tie(inHigh, inLow, inClose));
 }
 
 // ---------------------------------------------------------
-// MIDPRICE
+// PRICE TRANSFORMS AND TRUE RANGE, FUSED (PRICE_ALL)
+// AVGPRICE, MEDPRICE, TYPPRICE, WCLPRICE and TRANGE from one read of OHLC
+// in pytafast_core (core/fused.cpp), for any subset of the outputs, in any
+// order
 // ---------------------------------------------------------
-DoubleArrayOUT midprice(DoubleArrayIN inHigh, DoubleArrayIN inLow,
-                        int optInTimePeriod = 14) {
-  if (inHigh.size() == 0 || inLow.size() == 0) {
-    return DoubleArrayOUT(nullptr, {0}, nb::handle());
-  }
-  if (inHigh.shape(0) != inLow.shape(0))
-    throw std::runtime_error("Input lengths must match");
-  size_t size = inHigh.shape(0);
-  int lookback = TA_MIDPRICE_Lookback(optInTimePeriod);
-  auto [outData, owner] = alloc_output(size, lookback);
-  int outBegIdx = 0, outNBElement = 0;
-  TA_RetCode retCode;
+using pytafast::PriceOutput;
+
+static PriceOutput parse_price_output(const std::string &name) {
+  if (name == "avgprice") return pytafast::PRICE_AVGPRICE;
+  if (name == "medprice") return pytafast::PRICE_MEDPRICE;
+  if (name == "typprice") return pytafast::PRICE_TYPPRICE;
+  if (name == "wclprice") return pytafast::PRICE_WCLPRICE;
+  if (name == "trange") return pytafast::PRICE_TRANGE;
+  throw std::invalid_argument(
+      "PRICE_ALL: unknown output '" + name +
+      "' (expected avgprice, medprice, typprice, wclprice or trange)");
+}
+
+nb::object price_all(DoubleArrayIN inOpen, DoubleArrayIN inHigh,
+                     DoubleArrayIN inLow, DoubleArrayIN inClose,
+                     const std::vector<std::string> &outputs,
+                     const std::string &layout = "tuple") {
+  std::vector<PriceOutput> kinds;
+  for (const auto &name : outputs) kinds.push_back(parse_price_output(name));
+
+  size_t size = input_length(inOpen, inHigh, inLow, inClose);
+  std::vector<int> rowLookbacks;
+  for (PriceOutput kind : kinds)
+    rowLookbacks.push_back(pytafast::price_all_lookback(kind));
+  MultiOutput out(size, rowLookbacks, parse_layout(layout));
+  if (size == 0) return out.result();
+
+  // Each kind is computed into the first row that requested it
+  double *outData[pytafast::PRICE_NB_OUTPUTS] = {};
+  for (size_t j = kinds.size(); j-- > 0;) outData[kinds[j]] = out.row(j);
+
+  int retCode;
   {
-    nb::gil_scoped_release release;
-    retCode =
-        TA_MIDPRICE(0, size - 1, inHigh.data(), inLow.data(), optInTimePeriod,
-                    &outBegIdx, &outNBElement, outData + lookback);
+    ComputeScope compute;
+    retCode = pytafast::price_all(inOpen.data(), inHigh.data(), inLow.data(),
+                                  inClose.data(), size, outData);
+  }
+  check_ta_retcode((TA_RetCode)retCode, "PRICE_ALL");
+
+  for (size_t j = 0; j < kinds.size(); ++j) {
+    if (outData[kinds[j]] != out.row(j))
+      std::copy(outData[kinds[j]], outData[kinds[j]] + size, out.row(j));
   }
-  check_ta_retcode(retCode, "TA_MIDPRICE");
-  return DoubleArrayOUT(outData, {size}, owner);
+  return out.result();
 }
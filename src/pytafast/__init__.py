@@ -1,404 +1,462 @@
+import os as _os
+import sys as _sys
+
 import numpy as np
-import atexit
 
 # We import the compiled extension module
 from . import pytafast_ext
-from .pytafast_ext import MAType
+from .pytafast_ext import HTStream, MAType, StreamCDL
+from .pytafast_ext import api as _api
 
 __version__ = "0.3.0"
 
-# --- Module-level pandas detection (optimization #1) ---
-try:
-    import pandas as pd
-    _HAS_PANDAS = True
-except ImportError:
-    pd = None  # type: ignore
-    _HAS_PANDAS = False
+# --- pandas is never imported here ---
+# A caller holding a pd.Series has imported pandas already, so the Series
+# check only looks in sys.modules and the wrappers build their pandas
+# results from the module found there.
+
+def _pandas():
+    return _sys.modules["pandas"]
 
 
 def _is_pandas_series(obj):
-    return _HAS_PANDAS and isinstance(obj, pd.Series)
+    pd = _sys.modules.get("pandas")
+    return pd is not None and isinstance(obj, pd.Series)
+
+
+def _ma_int(matype):
+    """Accept either a MAType member or a plain int."""
+    return int(matype.value) if hasattr(matype, 'value') else int(matype)
 
 
 def _ensure_array(x):
-    """Fast-path: skip np.ascontiguousarray when already float64 C-contiguous."""
+    """Fast-path: skip conversion when already float64 C-contiguous.
+
+    Anything else goes through pytafast_ext.as_float64, which reads Arrow
+    and DLPack buffers in place when they are already float64.
+    """
     if isinstance(x, np.ndarray) and x.dtype == np.float64 and x.flags['C_CONTIGUOUS']:
         return x
-    return np.ascontiguousarray(x, dtype=np.float64)
+    return pytafast_ext.as_float64(x)
 
 
-# ===================================================================
-# Factory functions — eliminate ~700 lines of repetitive wrappers
-# ===================================================================
+def to_arrow(result):
+    """Export float64 result(s) through the Arrow PyCapsule interface.
 
-def _make_single(name, default_timeperiod):
-    """Factory for single-input indicators: f(inReal, timeperiod=N)"""
-    ext_fn = getattr(pytafast_ext, name)
-    def wrapper(inReal, timeperiod=default_timeperiod):
-        is_series = _is_pandas_series(inReal)
-        arr = _ensure_array(inReal)
-        out = ext_fn(arr, timeperiod)
-        if is_series:
-            return pd.Series(out, index=inReal.index, name=name)
-        return out
-    wrapper.__name__ = name
-    wrapper.__doc__ = f"{name} indicator."
-    return wrapper
-
-
-def _make_single_no_params(name):
-    """Factory for single-input, no-param indicators: f(inReal)"""
-    ext_fn = getattr(pytafast_ext, name)
-    def wrapper(inReal):
-        is_series = _is_pandas_series(inReal)
-        arr = _ensure_array(inReal)
-        out = ext_fn(arr)
-        if is_series:
-            return pd.Series(out, index=inReal.index, name=name)
-        return out
-    wrapper.__name__ = name
-    wrapper.__doc__ = f"{name} indicator."
-    return wrapper
-
-
-def _make_hlc(name, default_timeperiod):
-    """Factory for HLC indicators: f(inHigh, inLow, inClose, timeperiod=N)"""
-    ext_fn = getattr(pytafast_ext, name)
-    def wrapper(inHigh, inLow, inClose, timeperiod=default_timeperiod):
-        is_series = _is_pandas_series(inClose)
-        h = _ensure_array(inHigh)
-        l = _ensure_array(inLow)
-        c = _ensure_array(inClose)
-        out = ext_fn(h, l, c, timeperiod)
-        if is_series:
-            return pd.Series(out, index=inClose.index, name=name)
-        return out
-    wrapper.__name__ = name
-    wrapper.__doc__ = f"{name} indicator."
-    return wrapper
-
-
-def _make_hl(name, default_timeperiod):
-    """Factory for HL indicators: f(inHigh, inLow, timeperiod=N)"""
-    ext_fn = getattr(pytafast_ext, name)
-    def wrapper(inHigh, inLow, timeperiod=default_timeperiod):
-        is_series = _is_pandas_series(inHigh)
-        h = _ensure_array(inHigh)
-        l = _ensure_array(inLow)
-        out = ext_fn(h, l, timeperiod)
-        if is_series:
-            return pd.Series(out, index=inHigh.index, name=name)
-        return out
-    wrapper.__name__ = name
-    wrapper.__doc__ = f"{name} indicator."
-    return wrapper
-
-
-def _make_dual(name, default_timeperiod):
-    """Factory for dual-input indicators: f(inReal0, inReal1, timeperiod=N)"""
-    ext_fn = getattr(pytafast_ext, name)
-    def wrapper(inReal0, inReal1, timeperiod=default_timeperiod):
-        is_series = _is_pandas_series(inReal0)
-        a0 = _ensure_array(inReal0)
-        a1 = _ensure_array(inReal1)
-        out = ext_fn(a0, a1, timeperiod)
-        if is_series:
-            return pd.Series(out, index=inReal0.index, name=name)
-        return out
-    wrapper.__name__ = name
-    wrapper.__doc__ = f"{name} indicator."
-    return wrapper
-
-
-def _make_dual_no_params(name):
-    """Factory for dual-input, no-param: f(inReal0, inReal1)"""
-    ext_fn = getattr(pytafast_ext, name)
-    def wrapper(inReal0, inReal1):
-        is_series = _is_pandas_series(inReal0)
-        a0 = _ensure_array(inReal0)
-        a1 = _ensure_array(inReal1)
-        out = ext_fn(a0, a1)
-        if is_series:
-            return pd.Series(out, index=inReal0.index, name=name)
-        return out
-    wrapper.__name__ = name
-    wrapper.__doc__ = f"{name} indicator."
-    return wrapper
+    ``pa.array(pytafast.to_arrow(out))`` shares ``out``'s buffer and marks
+    the lookback region (the leading NaN run) as null instead of NaN.
+    Tuples from multi-output functions are converted element-wise.
+    """
+    if isinstance(result, tuple):
+        return tuple(to_arrow(r) for r in result)
+    if _is_pandas_series(result):
+        result = result.to_numpy()
+    return pytafast_ext.ArrowResult(_ensure_array(result))
 
 
+def lookback(name, **params):
+    """Number of leading bars ``name`` returns without a value.
+
+    ``lookback("RSI", timeperiod=14)`` is 14: the first RSI value needs 15
+    bars, so ``lookback(...) + n`` bars of history yield the latest ``n``
+    values. Recursive indicators (EMA, RSI, ADX, ...) still remember older
+    bars, so fetch extra history when they must match a longer run exactly.
+    Parameters not given take the function's defaults.
+    """
+    return pytafast_ext.lookback(name, **params)
+
+
+# Metadata from the same C++ table: function_info("BBANDS") gives inputs,
+# outputs, parameter defaults, output dtype and default lookback
+function_info = pytafast_ext.function_info
+function_names = pytafast_ext.function_names
+
+
+def enable_cache(max_bytes=256 * 2**20):
+    """Cache results of every function in a ``max_bytes`` LRU.
+
+    Calls are keyed by a hash of the function, its parameters and the input
+    bytes, so repeating a request - from any array holding the same data -
+    returns the cached result. While enabled, results are read-only arrays
+    sharing the cached buffer (``.copy()`` one before writing to it).
+
+    When a windowed function (SMA, WILLR, STDDEV, ...: no recursive state)
+    is called on inputs that extend a cached call's, only the appended bars
+    are computed. Calling ``enable_cache`` again changes the budget.
+    """
+    if max_bytes <= 0:
+        raise ValueError("max_bytes must be positive")
+    pytafast_ext.cache_configure(int(max_bytes))
+
+
+def disable_cache():
+    """Stop caching and drop every cached result."""
+    pytafast_ext.cache_configure(0)
+
+
+# cache_info() -> {"enabled", "max_bytes", "bytes", "entries", "hits",
+# "tail_hits", "misses"}; clear_cache() drops entries and resets counts
+cache_info = pytafast_ext.cache_info
+clear_cache = pytafast_ext.cache_clear
+
+
+def stats():
+    """Per-function hot-path counters, ``{name: {counter: value}}``.
+
+    Counters: ``calls``, ``elements`` (input bars), ``total_ns`` (time in
+    the C++ binding), ``compute_ns`` (TA-Lib, GIL released),
+    ``overhead_ns`` (``total_ns - compute_ns``: conversion, allocation,
+    result wrapping), ``alloc_ns`` and ``bytes_allocated`` (outputs and
+    their lookback fill), ``gil_released_ns`` and ``gil_wait_ns`` (waiting
+    to reacquire the GIL after compute). Only functions called since the
+    last ``reset_stats()`` are listed.
+
+    The counters are compiled out unless pytafast is built with
+    ``-DPYTAFAST_STATS=ON`` (``stats_available`` tells); ``stats()`` raises
+    RuntimeError otherwise.
+    """
+    return pytafast_ext.stats()
+
+
+reset_stats = pytafast_ext.reset_stats
+stats_available = pytafast_ext.HAS_STATS
+
+
+def start_trace(sample_rate=1.0, buffer_events=65536):
+    """Record calls for a Chrome / Perfetto trace (see ``dump_trace``).
+
+    Each sampled call into pytafast records its span on the calling thread,
+    with ``compute`` (TA-Lib, GIL released) and ``gil_wait`` (reacquiring
+    the GIL) spans inside it; ``pytafast.aio`` calls also record the time
+    spent queued for a worker thread. ``sample_rate`` keeps about that
+    fraction of calls per thread, so a low rate can stay on in production.
+    Every thread keeps its last ``buffer_events`` events. Starting again
+    drops the previous trace.
+    """
+    pytafast_ext.trace_start(float(sample_rate), int(buffer_events))
+
+
+def stop_trace():
+    """Stop recording. The events stay available to ``dump_trace``."""
+    pytafast_ext.trace_stop()
+
+
+def dump_trace(path):
+    """Write the recorded events to ``path`` as Chrome trace JSON.
+
+    Open the file in https://ui.perfetto.dev or chrome://tracing: there is
+    one timeline per thread, named after its ``threading`` name. Can be
+    called while tracing. Returns the number of events written.
+    """
+    import json
+    import os
+    import threading
+
+    pid = os.getpid()
+    events = [
+        {"name": name, "cat": cat, "ph": "X", "pid": pid, "tid": tid,
+         "ts": begin / 1000, "dur": (end - begin) / 1000}
+        for name, cat, begin, end, tid in pytafast_ext.trace_events()
+    ]
+    tids = {e["tid"] for e in events}
+    names = [
+        {"name": "thread_name", "ph": "M", "pid": pid, "tid": t.native_id,
+         "args": {"name": t.name}}
+        for t in threading.enumerate() if t.native_id in tids
+    ]
+    with open(path, "w") as f:
+        json.dump({"traceEvents": names + events, "displayTimeUnit": "ms"}, f)
+    return len(events)
+
+
+def _wrap_multi(outs, layout, index, names):
+    """Shape a multi-output result for the caller.
+
+    ``layout="tuple"`` gives one array (or Series) per output, all views
+    into a single allocation. ``"kN"`` / ``"Nk"`` give the block itself as
+    a 2-D array, or a DataFrame with ``names`` as columns for pandas input.
+    """
+    if layout == "tuple":
+        if index is not None:
+            return tuple(_pandas().Series(out, index=index, name=name)
+                         for out, name in zip(outs, names))
+        return outs
+    if index is not None:
+        return _pandas().DataFrame(outs.T if layout == "kN" else outs,
+                            index=index, columns=list(names), copy=False)
+    return outs
+
+
+def _run(fn, inputs, nan_policy, *args):
+    """``fn(*inputs, *args)``, with NaN gaps in ``inputs`` handled per
+    ``nan_policy`` ("propagate", "skip" or "restart") and the result cache
+    consulted in C++."""
+    if nan_policy == "propagate" and not pytafast_ext.cache_enabled():
+        return fn(*inputs, *args)
+    return pytafast_ext.run(fn, list(inputs), nan_policy, *args)
+
+
+# Functions with a common calling convention (f(inReal, timeperiod=N),
+# f(inHigh, inLow, inClose, ...), candlesticks, ...) are bound directly in
+# C++ as pytafast_ext.api.<NAME>: a numpy call goes straight from vectorcall
+# to the kernel, and pandas / list inputs are converted and re-indexed there.
+# They are looked up on first access (see __getattr__ below).
+
 
 # ===================================================================
 # Overlap Studies
 # ===================================================================
 
-SMA = _make_single("SMA", 30)
-EMA = _make_single("EMA", 30)
-DEMA = _make_single("DEMA", 30)
-KAMA = _make_single("KAMA", 30)
-TEMA = _make_single("TEMA", 30)
-TRIMA = _make_single("TRIMA", 30)
-WMA = _make_single("WMA", 30)
-MIDPOINT = _make_single("MIDPOINT", 14)
-
-
-def MA(inReal, timeperiod=30, matype=0):
+def MA(inReal, timeperiod=30, matype=0, nan_policy="propagate"):
     """Moving Average (generic)."""
     is_series = _is_pandas_series(inReal)
     arr = _ensure_array(inReal)
-    out = pytafast_ext.MA(arr, timeperiod, matype)
+    out = _run(pytafast_ext.MA, (arr,), nan_policy, timeperiod, matype)
     if is_series:
-        return pd.Series(out, index=inReal.index, name="MA")
+        return _pandas().Series(out, index=inReal.index, name="MA")
     return out
 
 
-def T3(inReal, timeperiod=5, vfactor=0.7):
+def T3(inReal, timeperiod=5, vfactor=0.7, nan_policy="propagate"):
     """Triple Exponential Moving Average (T3)."""
     is_series = _is_pandas_series(inReal)
     arr = _ensure_array(inReal)
-    out = pytafast_ext.T3(arr, timeperiod, vfactor)
+    out = _run(pytafast_ext.T3, (arr,), nan_policy, timeperiod, vfactor)
     if is_series:
-        return pd.Series(out, index=inReal.index, name="T3")
+        return _pandas().Series(out, index=inReal.index, name="T3")
     return out
 
 
-def BBANDS(inReal, timeperiod=5, nbdevup=2.0, nbdevdn=2.0, matype=MAType.SMA):
+def BBANDS(inReal, timeperiod=5, nbdevup=2.0, nbdevdn=2.0, matype=MAType.SMA,
+           layout="tuple", nan_policy="propagate"):
     """Bollinger Bands. Returns: (upperband, middleband, lowerband)"""
-    is_series = _is_pandas_series(inReal)
+    index = inReal.index if _is_pandas_series(inReal) else None
     arr = _ensure_array(inReal)
     ma_int = int(matype.value) if hasattr(matype, 'value') else int(matype)
-    upper, middle, lower = pytafast_ext.BBANDS(arr, timeperiod, nbdevup, nbdevdn, ma_int)
-    if is_series:
-        return (
-            pd.Series(upper, index=inReal.index, name="UpperBand"),
-            pd.Series(middle, index=inReal.index, name="MiddleBand"),
-            pd.Series(lower, index=inReal.index, name="LowerBand"),
-        )
-    return upper, middle, lower
+    outs = _run(pytafast_ext.BBANDS, (arr,), nan_policy, timeperiod, nbdevup, nbdevdn,
+                ma_int, layout)
+    return _wrap_multi(outs, layout, index, ("UpperBand", "MiddleBand", "LowerBand"))
 
 
-def SAR(inHigh, inLow, acceleration=0.02, maximum=0.2):
+def SAR(inHigh, inLow, acceleration=0.02, maximum=0.2, nan_policy="propagate"):
     """Parabolic SAR."""
     is_series = _is_pandas_series(inHigh)
     h = _ensure_array(inHigh)
     l = _ensure_array(inLow)
-    out = pytafast_ext.SAR(h, l, acceleration, maximum)
+    out = _run(pytafast_ext.SAR, (h, l), nan_policy, acceleration, maximum)
     if is_series:
-        return pd.Series(out, index=inHigh.index, name="SAR")
+        return _pandas().Series(out, index=inHigh.index, name="SAR")
     return out
 
 
-MIDPRICE = _make_hl("MIDPRICE", 14)
-
-
 # ===================================================================
 # Momentum Indicators
 # ===================================================================
 
-RSI = _make_single("RSI", 14)
-MOM = _make_single("MOM", 10)
-ROC = _make_single("ROC", 10)
-ROCP = _make_single("ROCP", 10)
-ROCR = _make_single("ROCR", 10)
-ROCR100 = _make_single("ROCR100", 10)
-CMO = _make_single("CMO", 14)
-TRIX = _make_single("TRIX", 30)
-
-
-def APO(inReal, fastperiod=12, slowperiod=26, matype=0):
+def APO(inReal, fastperiod=12, slowperiod=26, matype=0, nan_policy="propagate"):
     """Absolute Price Oscillator."""
     is_series = _is_pandas_series(inReal)
     arr = _ensure_array(inReal)
-    out = pytafast_ext.APO(arr, fastperiod, slowperiod, matype)
+    out = _run(pytafast_ext.APO, (arr,), nan_policy, fastperiod, slowperiod, matype)
     if is_series:
-        return pd.Series(out, index=inReal.index, name="APO")
+        return _pandas().Series(out, index=inReal.index, name="APO")
     return out
 
 
-def PPO(inReal, fastperiod=12, slowperiod=26, matype=0):
+def PPO(inReal, fastperiod=12, slowperiod=26, matype=0, nan_policy="propagate"):
     """Percentage Price Oscillator."""
     is_series = _is_pandas_series(inReal)
     arr = _ensure_array(inReal)
-    out = pytafast_ext.PPO(arr, fastperiod, slowperiod, matype)
+    out = _run(pytafast_ext.PPO, (arr,), nan_policy, fastperiod, slowperiod, matype)
     if is_series:
-        return pd.Series(out, index=inReal.index, name="PPO")
+        return _pandas().Series(out, index=inReal.index, name="PPO")
     return out
 
 
-def MACD(inReal, fastperiod=12, slowperiod=26, signalperiod=9):
+def MACD(inReal, fastperiod=12, slowperiod=26, signalperiod=9, layout="tuple",
+         nan_policy="propagate"):
     """Moving Average Convergence/Divergence. Returns: (macd, signal, hist)"""
-    is_series = _is_pandas_series(inReal)
+    index = inReal.index if _is_pandas_series(inReal) else None
     arr = _ensure_array(inReal)
-    macd, signal, hist = pytafast_ext.MACD(arr, fastperiod, slowperiod, signalperiod)
-    if is_series:
-        return (
-            pd.Series(macd, index=inReal.index, name="MACD"),
-            pd.Series(signal, index=inReal.index, name="MACD_Signal"),
-            pd.Series(hist, index=inReal.index, name="MACD_Hist"),
-        )
-    return macd, signal, hist
+    outs = _run(pytafast_ext.MACD, (arr,), nan_policy, fastperiod, slowperiod, signalperiod,
+                layout)
+    return _wrap_multi(outs, layout, index, ("MACD", "MACD_Signal", "MACD_Hist"))
 
 
 def MACDEXT(inReal, fastperiod=12, fastmatype=0, slowperiod=26, slowmatype=0,
-            signalperiod=9, signalmatype=0):
+            signalperiod=9, signalmatype=0, layout="tuple", nan_policy="propagate"):
     """MACD with controllable MA type."""
-    is_series = _is_pandas_series(inReal)
+    index = inReal.index if _is_pandas_series(inReal) else None
     arr = _ensure_array(inReal)
-    macd, signal, hist = pytafast_ext.MACDEXT(
-        arr, fastperiod, fastmatype, slowperiod, slowmatype, signalperiod, signalmatype)
-    if is_series:
-        idx = inReal.index
-        return (pd.Series(macd, index=idx, name="MACD"),
-                pd.Series(signal, index=idx, name="MACDSignal"),
-                pd.Series(hist, index=idx, name="MACDHist"))
-    return macd, signal, hist
+    outs = _run(pytafast_ext.MACDEXT, (arr,), nan_policy, fastperiod, fastmatype,
+                slowperiod, slowmatype, signalperiod, signalmatype, layout)
+    return _wrap_multi(outs, layout, index, ("MACD", "MACDSignal", "MACDHist"))
 
 
-def MACDFIX(inReal, signalperiod=9):
+def MACDFIX(inReal, signalperiod=9, layout="tuple", nan_policy="propagate"):
     """MACD Fix 12/26."""
-    is_series = _is_pandas_series(inReal)
+    index = inReal.index if _is_pandas_series(inReal) else None
     arr = _ensure_array(inReal)
-    macd, signal, hist = pytafast_ext.MACDFIX(arr, signalperiod)
-    if is_series:
-        idx = inReal.index
-        return (pd.Series(macd, index=idx, name="MACD"),
-                pd.Series(signal, index=idx, name="MACDSignal"),
-                pd.Series(hist, index=idx, name="MACDHist"))
-    return macd, signal, hist
+    outs = _run(pytafast_ext.MACDFIX, (arr,), nan_policy, signalperiod, layout)
+    return _wrap_multi(outs, layout, index, ("MACD", "MACDSignal", "MACDHist"))
 
 
 def STOCH(inHigh, inLow, inClose, fastk_period=5, slowk_period=3,
-          slowk_matype=MAType.SMA, slowd_period=3, slowd_matype=MAType.SMA):
+          slowk_matype=MAType.SMA, slowd_period=3, slowd_matype=MAType.SMA,
+          layout="tuple", nan_policy="propagate"):
     """Stochastic. Returns: (slowk, slowd)"""
-    is_series = _is_pandas_series(inClose)
+    index = inClose.index if _is_pandas_series(inClose) else None
     h = _ensure_array(inHigh)
     l = _ensure_array(inLow)
     c = _ensure_array(inClose)
     sk_t = int(slowk_matype.value) if hasattr(slowk_matype, 'value') else int(slowk_matype)
     sd_t = int(slowd_matype.value) if hasattr(slowd_matype, 'value') else int(slowd_matype)
-    slowk, slowd = pytafast_ext.STOCH(h, l, c, fastk_period, slowk_period, sk_t, slowd_period, sd_t)
-    if is_series:
-        return (pd.Series(slowk, index=inClose.index, name="SlowK"),
-                pd.Series(slowd, index=inClose.index, name="SlowD"))
-    return slowk, slowd
+    outs = _run(pytafast_ext.STOCH, (h, l, c), nan_policy, fastk_period, slowk_period, sk_t,
+                slowd_period, sd_t, layout)
+    return _wrap_multi(outs, layout, index, ("SlowK", "SlowD"))
 
 
-def STOCHF(inHigh, inLow, inClose, fastk_period=5, fastd_period=3, fastd_matype=0):
+def STOCHF(inHigh, inLow, inClose, fastk_period=5, fastd_period=3, fastd_matype=0,
+           layout="tuple", nan_policy="propagate"):
     """Stochastic Fast."""
-    is_series = _is_pandas_series(inClose)
+    index = inClose.index if _is_pandas_series(inClose) else None
     h = _ensure_array(inHigh)
     l = _ensure_array(inLow)
     c = _ensure_array(inClose)
-    fastk, fastd = pytafast_ext.STOCHF(h, l, c, fastk_period, fastd_period, fastd_matype)
-    if is_series:
-        idx = inClose.index
-        return (pd.Series(fastk, index=idx, name="FastK"),
-                pd.Series(fastd, index=idx, name="FastD"))
-    return fastk, fastd
+    outs = _run(pytafast_ext.STOCHF, (h, l, c), nan_policy, fastk_period, fastd_period,
+                fastd_matype, layout)
+    return _wrap_multi(outs, layout, index, ("FastK", "FastD"))
 
 
-def STOCHRSI(inReal, timeperiod=14, fastk_period=5, fastd_period=3, fastd_matype=0):
+def STOCHRSI(inReal, timeperiod=14, fastk_period=5, fastd_period=3, fastd_matype=0,
+             layout="tuple", nan_policy="propagate"):
     """Stochastic RSI."""
-    is_series = _is_pandas_series(inReal)
+    index = inReal.index if _is_pandas_series(inReal) else None
     arr = _ensure_array(inReal)
-    fastk, fastd = pytafast_ext.STOCHRSI(arr, timeperiod, fastk_period, fastd_period, fastd_matype)
-    if is_series:
-        idx = inReal.index
-        return (pd.Series(fastk, index=idx, name="FastK"),
-                pd.Series(fastd, index=idx, name="FastD"))
-    return fastk, fastd
+    outs = _run(pytafast_ext.STOCHRSI, (arr,), nan_policy, timeperiod, fastk_period,
+                fastd_period, fastd_matype, layout)
+    return _wrap_multi(outs, layout, index, ("FastK", "FastD"))
 
 
-ADX = _make_hlc("ADX", 14)
-ADXR = _make_hlc("ADXR", 14)
-CCI = _make_hlc("CCI", 14)
-DX = _make_hlc("DX", 14)
-MINUS_DI = _make_hlc("MINUS_DI", 14)
-PLUS_DI = _make_hlc("PLUS_DI", 14)
-WILLR = _make_hlc("WILLR", 14)
+_STOCH_ALL_NAMES = {
+    "fastk": "FastK", "fastd": "FastD", "slowk": "SlowK", "slowd": "SlowD",
+    "willr": "WILLR",
+}
 
-MINUS_DM = _make_hl("MINUS_DM", 14)
-PLUS_DM = _make_hl("PLUS_DM", 14)
 
-AROONOSC = _make_hl("AROONOSC", 14)
+def STOCH_ALL(inHigh, inLow, inClose, outputs=("slowk", "slowd"),
+              fastk_period=5, slowk_period=3, slowk_matype=MAType.SMA,
+              slowd_period=3, slowd_matype=MAType.SMA, fastd_period=3,
+              fastd_matype=MAType.SMA, layout="tuple", nan_policy="propagate"):
+    """Stochastic family sharing one highest-high/lowest-low scan.
+
+    ``outputs`` selects any of "fastk", "fastd" (as STOCHF), "slowk",
+    "slowd" (as STOCH) and "willr" (WILLR over ``fastk_period``).
+    Returns a tuple in the requested order.
+    """
+    if isinstance(outputs, str):
+        outputs = (outputs,)
+    outputs = list(outputs)
+    index = inClose.index if _is_pandas_series(inClose) else None
+    h = _ensure_array(inHigh)
+    l = _ensure_array(inLow)
+    c = _ensure_array(inClose)
+    outs = _run(pytafast_ext.STOCH_ALL, (h, l, c), nan_policy, outputs, fastk_period,
+                slowk_period, _ma_int(slowk_matype), slowd_period, _ma_int(slowd_matype),
+                fastd_period, _ma_int(fastd_matype), layout)
+    return _wrap_multi(outs, layout, index, [_STOCH_ALL_NAMES[name] for name in outputs])
 
 
-def AROON(inHigh, inLow, timeperiod=14):
+def AROON(inHigh, inLow, timeperiod=14, layout="tuple", nan_policy="propagate"):
     """Aroon. Returns: (aroondown, aroonup)"""
-    is_series = _is_pandas_series(inHigh)
+    index = inHigh.index if _is_pandas_series(inHigh) else None
     h = _ensure_array(inHigh)
     l = _ensure_array(inLow)
-    down, up = pytafast_ext.AROON(h, l, timeperiod)
-    if is_series:
-        return (pd.Series(down, index=inHigh.index, name="AROON_DOWN"),
-                pd.Series(up, index=inHigh.index, name="AROON_UP"))
-    return down, up
+    outs = _run(pytafast_ext.AROON, (h, l), nan_policy, timeperiod, layout)
+    return _wrap_multi(outs, layout, index, ("AROON_DOWN", "AROON_UP"))
 
 
-def MFI(inHigh, inLow, inClose, inVolume, timeperiod=14):
+def MFI(inHigh, inLow, inClose, inVolume, timeperiod=14, nan_policy="propagate"):
     """Money Flow Index."""
     is_series = _is_pandas_series(inClose)
     h = _ensure_array(inHigh)
     l = _ensure_array(inLow)
     c = _ensure_array(inClose)
     v = _ensure_array(inVolume)
-    out = pytafast_ext.MFI(h, l, c, v, timeperiod)
+    out = _run(pytafast_ext.MFI, (h, l, c, v), nan_policy, timeperiod)
     if is_series:
-        return pd.Series(out, index=inClose.index, name="MFI")
+        return _pandas().Series(out, index=inClose.index, name="MFI")
     return out
 
 
-def ULTOSC(inHigh, inLow, inClose, timeperiod1=7, timeperiod2=14, timeperiod3=28):
+def ULTOSC(inHigh, inLow, inClose, timeperiod1=7, timeperiod2=14, timeperiod3=28,
+           nan_policy="propagate"):
     """Ultimate Oscillator."""
     is_series = _is_pandas_series(inClose)
     h = _ensure_array(inHigh)
     l = _ensure_array(inLow)
     c = _ensure_array(inClose)
-    out = pytafast_ext.ULTOSC(h, l, c, timeperiod1, timeperiod2, timeperiod3)
+    out = _run(pytafast_ext.ULTOSC, (h, l, c), nan_policy, timeperiod1, timeperiod2,
+               timeperiod3)
     if is_series:
-        return pd.Series(out, index=inClose.index, name="ULTOSC")
+        return _pandas().Series(out, index=inClose.index, name="ULTOSC")
     return out
 
 
-def BOP(inOpen, inHigh, inLow, inClose):
+def BOP(inOpen, inHigh, inLow, inClose, nan_policy="propagate"):
     """Balance Of Power."""
     is_series = _is_pandas_series(inClose)
     o = _ensure_array(inOpen)
     h = _ensure_array(inHigh)
     l = _ensure_array(inLow)
     c = _ensure_array(inClose)
-    out = pytafast_ext.BOP(o, h, l, c)
+    out = _run(pytafast_ext.BOP, (o, h, l, c), nan_policy)
     if is_series:
-        return pd.Series(out, index=inClose.index, name="BOP")
+        return _pandas().Series(out, index=inClose.index, name="BOP")
     return out
 
 
+_DMI_ALL_NAMES = ("PLUS_DM", "MINUS_DM", "PLUS_DI", "MINUS_DI", "DX", "ADX", "ADXR")
+
+
+def DMI_ALL(inHigh, inLow, inClose, timeperiod=14, layout="tuple",
+            nan_policy="propagate"):
+    """Whole directional movement family from one shared pass.
+
+    Returns: (plus_dm, minus_dm, plus_di, minus_di, dx, adx, adxr), each
+    identical to the corresponding standalone function.
+    """
+    index = inClose.index if _is_pandas_series(inClose) else None
+    h = _ensure_array(inHigh)
+    l = _ensure_array(inLow)
+    c = _ensure_array(inClose)
+    outs = _run(pytafast_ext.DMI_ALL, (h, l, c), nan_policy, timeperiod, layout)
+    return _wrap_multi(outs, layout, index, _DMI_ALL_NAMES)
+
+
 # ===================================================================
 # Volatility
 # ===================================================================
 
-ATR = _make_hlc("ATR", 14)
-NATR = _make_hlc("NATR", 14)
-
-
-def TRANGE(inHigh, inLow, inClose):
+def TRANGE(inHigh, inLow, inClose, nan_policy="propagate"):
     """True Range."""
     is_series = _is_pandas_series(inClose)
     h = _ensure_array(inHigh)
     l = _ensure_array(inLow)
     c = _ensure_array(inClose)
-    out = pytafast_ext.TRANGE(h, l, c)
+    out = _run(pytafast_ext.TRANGE, (h, l, c), nan_policy)
     if is_series:
-        return pd.Series(out, index=inClose.index, name="TRANGE")
+        return _pandas().Series(out, index=inClose.index, name="TRANGE")
     return out
 
 
-def STDDEV(inReal, timeperiod=5, nbdev=1.0):
+def STDDEV(inReal, timeperiod=5, nbdev=1.0, nan_policy="propagate"):
     """Standard Deviation."""
     is_series = _is_pandas_series(inReal)
     arr = _ensure_array(inReal)
-    out = pytafast_ext.STDDEV(arr, timeperiod, nbdev)
+    out = _run(pytafast_ext.STDDEV, (arr,), nan_policy, timeperiod, nbdev)
     if is_series:
-        return pd.Series(out, index=inReal.index, name="STDDEV")
+        return _pandas().Series(out, index=inReal.index, name="STDDEV")
     return out
 
 
@@ -406,32 +464,30 @@ def STDDEV(inReal, timeperiod=5, nbdev=1.0):
 # Volume
 # ===================================================================
 
-OBV = _make_dual_no_params("OBV")
-
-
-def AD(inHigh, inLow, inClose, inVolume):
+def AD(inHigh, inLow, inClose, inVolume, nan_policy="propagate"):
     """Chaikin A/D Line."""
     is_series = _is_pandas_series(inClose)
     h = _ensure_array(inHigh)
     l = _ensure_array(inLow)
     c = _ensure_array(inClose)
     v = _ensure_array(inVolume)
-    out = pytafast_ext.AD(h, l, c, v)
+    out = _run(pytafast_ext.AD, (h, l, c, v), nan_policy)
     if is_series:
-        return pd.Series(out, index=inClose.index, name="AD")
+        return _pandas().Series(out, index=inClose.index, name="AD")
     return out
 
 
-def ADOSC(inHigh, inLow, inClose, inVolume, fastperiod=3, slowperiod=10):
+def ADOSC(inHigh, inLow, inClose, inVolume, fastperiod=3, slowperiod=10,
+          nan_policy="propagate"):
     """Chaikin A/D Oscillator."""
     is_series = _is_pandas_series(inClose)
     h = _ensure_array(inHigh)
     l = _ensure_array(inLow)
     c = _ensure_array(inClose)
     v = _ensure_array(inVolume)
-    out = pytafast_ext.ADOSC(h, l, c, v, fastperiod, slowperiod)
+    out = _run(pytafast_ext.ADOSC, (h, l, c, v), nan_policy, fastperiod, slowperiod)
     if is_series:
-        return pd.Series(out, index=inClose.index, name="ADOSC")
+        return _pandas().Series(out, index=inClose.index, name="ADOSC")
     return out
 
 
@@ -439,82 +495,90 @@ def ADOSC(inHigh, inLow, inClose, inVolume, fastperiod=3, slowperiod=10):
 # Price Transform
 # ===================================================================
 
-def AVGPRICE(inOpen, inHigh, inLow, inClose):
+def AVGPRICE(inOpen, inHigh, inLow, inClose, nan_policy="propagate"):
     """Average Price."""
     is_series = _is_pandas_series(inClose)
     o = _ensure_array(inOpen)
     h = _ensure_array(inHigh)
     l = _ensure_array(inLow)
     c = _ensure_array(inClose)
-    out = pytafast_ext.AVGPRICE(o, h, l, c)
+    out = _run(pytafast_ext.AVGPRICE, (o, h, l, c), nan_policy)
     if is_series:
-        return pd.Series(out, index=inClose.index, name="AVGPRICE")
+        return _pandas().Series(out, index=inClose.index, name="AVGPRICE")
     return out
 
 
-MEDPRICE = _make_dual_no_params("MEDPRICE")
-
-
-def TYPPRICE(inHigh, inLow, inClose):
+def TYPPRICE(inHigh, inLow, inClose, nan_policy="propagate"):
     """Typical Price."""
     is_series = _is_pandas_series(inClose)
     h = _ensure_array(inHigh)
     l = _ensure_array(inLow)
     c = _ensure_array(inClose)
-    out = pytafast_ext.TYPPRICE(h, l, c)
+    out = _run(pytafast_ext.TYPPRICE, (h, l, c), nan_policy)
     if is_series:
-        return pd.Series(out, index=inClose.index, name="TYPPRICE")
+        return _pandas().Series(out, index=inClose.index, name="TYPPRICE")
     return out
 
 
-def WCLPRICE(inHigh, inLow, inClose):
+def WCLPRICE(inHigh, inLow, inClose, nan_policy="propagate"):
     """Weighted Close Price."""
     is_series = _is_pandas_series(inClose)
     h = _ensure_array(inHigh)
     l = _ensure_array(inLow)
     c = _ensure_array(inClose)
-    out = pytafast_ext.WCLPRICE(h, l, c)
+    out = _run(pytafast_ext.WCLPRICE, (h, l, c), nan_policy)
     if is_series:
-        return pd.Series(out, index=inClose.index, name="WCLPRICE")
+        return _pandas().Series(out, index=inClose.index, name="WCLPRICE")
     return out
 
 
+_PRICE_ALL_NAMES = {
+    "avgprice": "AVGPRICE", "medprice": "MEDPRICE", "typprice": "TYPPRICE",
+    "wclprice": "WCLPRICE", "trange": "TRANGE",
+}
+
+
+def PRICE_ALL(inOpen, inHigh, inLow, inClose,
+              outputs=("avgprice", "medprice", "typprice", "wclprice", "trange"),
+              layout="tuple", nan_policy="propagate"):
+    """Price transforms and true range from one read of OHLC.
+
+    ``outputs`` selects any of "avgprice", "medprice", "typprice",
+    "wclprice" and "trange" (as AVGPRICE, MEDPRICE, ... TRANGE).
+    Returns a tuple in the requested order.
+    """
+    if isinstance(outputs, str):
+        outputs = (outputs,)
+    outputs = list(outputs)
+    index = inClose.index if _is_pandas_series(inClose) else None
+    o = _ensure_array(inOpen)
+    h = _ensure_array(inHigh)
+    l = _ensure_array(inLow)
+    c = _ensure_array(inClose)
+    outs = _run(pytafast_ext.PRICE_ALL, (o, h, l, c), nan_policy, outputs, layout)
+    return _wrap_multi(outs, layout, index, [_PRICE_ALL_NAMES[name] for name in outputs])
+
+
 # ===================================================================
 # Statistics
 # ===================================================================
 
-BETA = _make_dual("BETA", 5)
-CORREL = _make_dual("CORREL", 30)
-LINEARREG = _make_single("LINEARREG", 14)
-LINEARREG_ANGLE = _make_single("LINEARREG_ANGLE", 14)
-LINEARREG_INTERCEPT = _make_single("LINEARREG_INTERCEPT", 14)
-LINEARREG_SLOPE = _make_single("LINEARREG_SLOPE", 14)
-TSF = _make_single("TSF", 14)
-AVGDEV = _make_single("AVGDEV", 14)
-MAX = _make_single("MAX", 30)
-MIN = _make_single("MIN", 30)
-SUM = _make_single("SUM", 30)
-
-
-def VAR(inReal, timeperiod=5, nbdev=1.0):
+def VAR(inReal, timeperiod=5, nbdev=1.0, nan_policy="propagate"):
     """Variance."""
     is_series = _is_pandas_series(inReal)
     arr = _ensure_array(inReal)
-    out = pytafast_ext.VAR(arr, timeperiod, nbdev)
+    out = _run(pytafast_ext.VAR, (arr,), nan_policy, timeperiod, nbdev)
     if is_series:
-        return pd.Series(out, index=inReal.index, name="VAR")
+        return _pandas().Series(out, index=inReal.index, name="VAR")
     return out
 
 
-def MINMAX(inReal, timeperiod=30):
+def MINMAX(inReal, timeperiod=30, layout="tuple", nan_policy="propagate"):
     """Lowest and highest values over a specified period."""
-    is_series = _is_pandas_series(inReal)
+    index = inReal.index if _is_pandas_series(inReal) else None
     arr = _ensure_array(inReal)
-    out_min, out_max = pytafast_ext.MINMAX(arr, timeperiod)
-    if is_series:
-        return (pd.Series(out_min, index=inReal.index, name="min"),
-                pd.Series(out_max, index=inReal.index, name="max"))
-    return out_min, out_max
+    outs = _run(pytafast_ext.MINMAX, (arr,), nan_policy, timeperiod, layout)
+    return _wrap_multi(outs, layout, index, ("min", "max"))
 
 
 def MINMAXINDEX(inReal, timeperiod=30):
@@ -523,87 +587,48 @@ def MINMAXINDEX(inReal, timeperiod=30):
     arr = _ensure_array(inReal)
     out_minidx, out_maxidx = pytafast_ext.MINMAXINDEX(arr, timeperiod)
     if is_series:
-        return (pd.Series(out_minidx, index=inReal.index, name="minidx"),
-                pd.Series(out_maxidx, index=inReal.index, name="maxidx"))
+        return (_pandas().Series(out_minidx, index=inReal.index, name="minidx"),
+                _pandas().Series(out_maxidx, index=inReal.index, name="maxidx"))
     return out_minidx, out_maxidx
 
 
 # ===================================================================
-# Math Operators
-# ===================================================================
-
-ADD = _make_dual_no_params("ADD")
-SUB = _make_dual_no_params("SUB")
-MULT = _make_dual_no_params("MULT")
-DIV = _make_dual_no_params("DIV")
-
-
-# ===================================================================
-# Math Transforms (factory, same as before)
+# Cycle Indicators
 # ===================================================================
 
-def _make_math_transform(name):
-    """Factory for single-input math transform wrappers."""
-    ext_fn = getattr(pytafast_ext, name)
-    def wrapper(inReal):
-        is_series = _is_pandas_series(inReal)
-        arr = _ensure_array(inReal)
-        out = ext_fn(arr)
-        if is_series:
-            return pd.Series(out, index=inReal.index, name=name)
-        return out
-    wrapper.__name__ = name
-    wrapper.__doc__ = f"Vector {name}."
-    return wrapper
-
-
-ACOS = _make_math_transform("ACOS")
-ASIN = _make_math_transform("ASIN")
-ATAN = _make_math_transform("ATAN")
-CEIL = _make_math_transform("CEIL")
-COS = _make_math_transform("COS")
-COSH = _make_math_transform("COSH")
-EXP = _make_math_transform("EXP")
-FLOOR = _make_math_transform("FLOOR")
-LN = _make_math_transform("LN")
-LOG10 = _make_math_transform("LOG10")
-SIN = _make_math_transform("SIN")
-SINH = _make_math_transform("SINH")
-SQRT = _make_math_transform("SQRT")
-TAN = _make_math_transform("TAN")
-TANH = _make_math_transform("TANH")
+def HT_PHASOR(inReal, layout="tuple", nan_policy="propagate"):
+    """Hilbert Transform - Phasor Components."""
+    index = inReal.index if _is_pandas_series(inReal) else None
+    arr = _ensure_array(inReal)
+    outs = _run(pytafast_ext.HT_PHASOR, (arr,), nan_policy, layout)
+    return _wrap_multi(outs, layout, index, ("inphase", "quadrature"))
 
 
-# ===================================================================
-# Cycle Indicators
-# ===================================================================
+def HT_SINE(inReal, layout="tuple", nan_policy="propagate"):
+    """Hilbert Transform - SineWave."""
+    index = inReal.index if _is_pandas_series(inReal) else None
+    arr = _ensure_array(inReal)
+    outs = _run(pytafast_ext.HT_SINE, (arr,), nan_policy, layout)
+    return _wrap_multi(outs, layout, index, ("sine", "leadsine"))
 
-HT_DCPERIOD = _make_single_no_params("HT_DCPERIOD")
-HT_DCPHASE = _make_single_no_params("HT_DCPHASE")
-HT_TRENDLINE = _make_single_no_params("HT_TRENDLINE")
-HT_TRENDMODE = _make_single_no_params("HT_TRENDMODE")
 
+_HT_ALL_NAMES = ("dcperiod", "dcphase", "inphase", "quadrature", "sine",
+                 "leadsine", "trendline", "trendmode")
 
-def HT_PHASOR(inReal):
-    """Hilbert Transform - Phasor Components."""
-    is_series = _is_pandas_series(inReal)
-    arr = _ensure_array(inReal)
-    inphase, quadrature = pytafast_ext.HT_PHASOR(arr)
-    if is_series:
-        return (pd.Series(inphase, index=inReal.index, name="inphase"),
-                pd.Series(quadrature, index=inReal.index, name="quadrature"))
-    return inphase, quadrature
 
+def HT_ALL(inReal, layout="tuple", nan_policy="propagate"):
+    """All Hilbert Transform outputs from one pass over the data.
 
-def HT_SINE(inReal):
-    """Hilbert Transform - SineWave."""
-    is_series = _is_pandas_series(inReal)
+    Returns HT_DCPERIOD, HT_DCPHASE, HT_PHASOR (inphase, quadrature),
+    HT_SINE (sine, leadsine), HT_TRENDLINE and HT_TRENDMODE, each equal to
+    its standalone function and NaN over that function's lookback; the
+    Hilbert transform they share runs once. trendmode is float64 (0.0 /
+    1.0). ``pytafast.HTStream`` computes the same bar by bar.
+    """
+    index = inReal.index if _is_pandas_series(inReal) else None
     arr = _ensure_array(inReal)
-    sine, leadsine = pytafast_ext.HT_SINE(arr)
-    if is_series:
-        return (pd.Series(sine, index=inReal.index, name="sine"),
-                pd.Series(leadsine, index=inReal.index, name="leadsine"))
-    return sine, leadsine
+    outs = _run(pytafast_ext.HT_ALL, (arr,), nan_policy, layout)
+    return _wrap_multi(outs, layout, index, _HT_ALL_NAMES)
 
 
 # ===================================================================
@@ -630,79 +655,93 @@ _CDL_STANDARD = [
     "CDLXSIDEGAP3METHODS",
 ]
 
-_CDL_PENETRATION = {
-    "CDLABANDONEDBABY": 0.3, "CDLDARKCLOUDCOVER": 0.5,
-    "CDLEVENINGDOJISTAR": 0.3, "CDLEVENINGSTAR": 0.3,
-    "CDLMATHOLD": 0.5, "CDLMORNINGDOJISTAR": 0.3, "CDLMORNINGSTAR": 0.3,
-}
-
-
-def _make_cdl_standard(name):
-    ext_fn = getattr(pytafast_ext, name)
-    def wrapper(inOpen, inHigh, inLow, inClose):
-        is_series = _is_pandas_series(inClose)
-        o = _ensure_array(inOpen)
-        h = _ensure_array(inHigh)
-        l = _ensure_array(inLow)
-        c = _ensure_array(inClose)
-        out = ext_fn(o, h, l, c)
-        if is_series:
-            return pd.Series(out, index=inClose.index, name=name)
-        return out
-    wrapper.__name__ = name
-    wrapper.__doc__ = f"Candlestick Pattern: {name}"
-    return wrapper
-
-
-def _make_cdl_penetration(name, default_pen):
-    ext_fn = getattr(pytafast_ext, name)
-    def wrapper(inOpen, inHigh, inLow, inClose, penetration=default_pen):
-        is_series = _is_pandas_series(inClose)
-        o = _ensure_array(inOpen)
-        h = _ensure_array(inHigh)
-        l = _ensure_array(inLow)
-        c = _ensure_array(inClose)
-        out = ext_fn(o, h, l, c, penetration)
-        if is_series:
-            return pd.Series(out, index=inClose.index, name=name)
-        return out
-    wrapper.__name__ = name
-    wrapper.__doc__ = f"Candlestick Pattern: {name}"
-    return wrapper
-
-
-for _name in _CDL_STANDARD:
-    globals()[_name] = _make_cdl_standard(_name)
-
-for _name, _pen in _CDL_PENETRATION.items():
-    globals()[_name] = _make_cdl_penetration(_name, _pen)
+# Take an extra ``penetration`` argument (defaults are set in C++)
+_CDL_PENETRATION = [
+    "CDLABANDONEDBABY", "CDLDARKCLOUDCOVER", "CDLEVENINGDOJISTAR",
+    "CDLEVENINGSTAR", "CDLMATHOLD", "CDLMORNINGDOJISTAR", "CDLMORNINGSTAR",
+]
 
 
 # ===================================================================
-# Async wrappers — built as a virtual submodule `pytafast.aio`
+# Native plugins
 # ===================================================================
 
-import asyncio as _asyncio
-import sys as _sys
-import types as _types
+# Plugin function name -> path of its library (pytafast.parallel workers
+# load it again from there)
+_PLUGINS = {}
+
+
+def load_plugin(path):
+    """Register the functions of a native plugin library.
+
+    ``path`` is a shared library exporting ``pytafast_plugin_entry`` (see
+    ``include/pytafast/plugin.h``). Each of its functions becomes
+    ``pytafast.<NAME>``, called like the built-in ones: input series, then
+    parameters by position or keyword, ``layout=`` and ``nan_policy=``,
+    pandas in and out. They are listed by ``function_names()``, described by
+    ``function_info``, cached by ``enable_cache`` and available through
+    ``pytafast.aio`` and ``SharedMemoryEngine``. Loading a library again is
+    a no-op. Returns the names of its functions.
+    """
+    path = _os.fspath(path)
+    if _os.path.exists(path):
+        path = _os.path.abspath(path)
+    kernels = pytafast_ext.load_plugin(path)
+    for name, kernel in kernels.items():
+        globals()[name] = _plugin_function(name, kernel)
+        if name not in _PLUGINS:
+            __all__.append(name)
+        _PLUGINS[name] = path
+    return list(kernels)
+
+
+def get_include():
+    """Directory holding ``pytafast/plugin.h``, for compiling plugins."""
+    return _os.path.join(_os.path.dirname(__file__), "include")
+
+
+def _plugin_function(name, kernel):
+    """``pytafast.<name>`` over the raw plugin ``kernel``, which takes
+    ``(*inputs, *params[, layout])``."""
+    info = function_info(name)
+    n_inputs = len(info["inputs"])
+    params = info["parameters"]
+    outputs = tuple(info["outputs"])
+
+    def fn(*args, layout="tuple", nan_policy="propagate", **kwargs):
+        if not n_inputs <= len(args) <= n_inputs + len(params):
+            raise TypeError(f"{name} takes {n_inputs} input series and at "
+                            f"most {len(params)} parameters")
+        values = dict(zip(params, args[n_inputs:]))
+        for key, value in kwargs.items():
+            if key not in params or key in values:
+                raise TypeError(f"{name} got an unexpected or repeated "
+                                f"argument {key!r}")
+            values[key] = value
+        # Integer and MAType parameters have integer defaults
+        call = [_ma_int(values.get(p, d)) if isinstance(d, int)
+                else float(values.get(p, d)) for p, d in params.items()]
+
+        series = args[:n_inputs]
+        index = next((x.index for x in series if _is_pandas_series(x)), None)
+        arrays = tuple(_ensure_array(x) for x in series)
+        if len(outputs) > 1:
+            outs = _run(kernel, arrays, nan_policy, *call, layout)
+            return _wrap_multi(outs, layout, index, outputs)
+        out = _run(kernel, arrays, nan_policy, *call)
+        if index is not None:
+            return _pandas().Series(out, index=index, name=name)
+        return out
 
-def _make_async(sync_fn):
-    async def wrapper(*args, **kwargs):
-        return await _asyncio.to_thread(sync_fn, *args, **kwargs)
-    wrapper.__name__ = sync_fn.__name__
-    wrapper.__doc__ = sync_fn.__doc__
-    return wrapper
+    fn.__name__ = fn.__qualname__ = name
+    fn.__doc__ = f"{name} ({info['group']}, native plugin)."
+    return fn
 
-# Build the aio namespace as a proper module object
-aio = _types.ModuleType("pytafast.aio")
-aio.__doc__ = """Async wrappers for all pytafast functions via asyncio.to_thread.
 
-Usage:
-    import pytafast
-    result = await pytafast.aio.SMA(close, timeperiod=20)
-"""
+# ===================================================================
+# Public names, bound on first use
+# ===================================================================
 
-# Auto-generate async versions of all public indicator functions
 _ALL_FUNCTIONS = [
     # Overlap
     "SMA", "EMA", "DEMA", "KAMA", "MA", "T3", "TEMA", "TRIMA", "WMA",
@@ -712,12 +751,13 @@ _ALL_FUNCTIONS = [
     "ROCR100", "CMO", "APO", "PPO", "TRIX", "ADX", "ADXR", "CCI", "DX",
     "MINUS_DI", "MINUS_DM", "PLUS_DI", "PLUS_DM", "WILLR", "MFI",
     "STOCH", "STOCHF", "STOCHRSI", "AROON", "AROONOSC", "ULTOSC", "BOP",
+    "DMI_ALL", "STOCH_ALL",
     # Volatility
     "ATR", "NATR", "TRANGE", "STDDEV",
     # Volume
     "OBV", "AD", "ADOSC",
     # Price Transform
-    "AVGPRICE", "MEDPRICE", "TYPPRICE", "WCLPRICE",
+    "AVGPRICE", "MEDPRICE", "TYPPRICE", "WCLPRICE", "PRICE_ALL",
     # Statistics
     "BETA", "CORREL", "LINEARREG", "LINEARREG_ANGLE",
     "LINEARREG_INTERCEPT", "LINEARREG_SLOPE", "TSF", "VAR", "AVGDEV",
@@ -729,23 +769,43 @@ _ALL_FUNCTIONS = [
     "LN", "LOG10", "SIN", "SINH", "SQRT", "TAN", "TANH",
     # Cycle
     "HT_DCPERIOD", "HT_DCPHASE", "HT_PHASOR", "HT_SINE",
-    "HT_TRENDLINE", "HT_TRENDMODE",
+    "HT_TRENDLINE", "HT_TRENDMODE", "HT_ALL",
 ]
 
-for _fn_name in _ALL_FUNCTIONS:
-    setattr(aio, _fn_name, _make_async(globals()[_fn_name]))
-
-# Candlestick patterns
-for _fn_name in _CDL_STANDARD + list(_CDL_PENETRATION.keys()):
-    setattr(aio, _fn_name, _make_async(globals()[_fn_name]))
-
-# Register as a proper submodule so `import pytafast.aio` also works
-_sys.modules["pytafast.aio"] = aio
+_PUBLIC = frozenset(_ALL_FUNCTIONS + _CDL_STANDARD + _CDL_PENETRATION)
 
+# Fused functions whose ``outputs=`` picks the series returned, with the
+# default selection
+_OUTPUT_SELECTION = {
+    "STOCH_ALL": ("slowk", "slowd"),
+    "PRICE_ALL": tuple(_PRICE_ALL_NAMES),
+}
 
-# ===================================================================
-# Initialize TA-Lib context
-# ===================================================================
 
-pytafast_ext.initialize()
-atexit.register(pytafast_ext.shutdown)
+# `from pytafast import *`: every indicator, bound on first use like any
+# other lookup, plus the module's own API. Plugin functions are added as
+# they are loaded; pytafast.aio stays lazy.
+__all__ = sorted(_PUBLIC | {
+    "MAType", "HTStream", "StreamCDL", "to_arrow", "lookback",
+    "function_info", "function_names", "enable_cache", "disable_cache",
+    "cache_info", "clear_cache", "stats", "reset_stats", "stats_available",
+    "start_trace", "stop_trace", "dump_trace", "load_plugin", "get_include",
+})
+
+
+def __getattr__(name):
+    # Table functions resolve to pytafast_ext.api.<NAME> and are cached in
+    # the module namespace, so later lookups never come back here.
+    # pytafast.aio (async wrappers, and asyncio) is imported when first used.
+    if name in _PUBLIC:
+        fn = getattr(_api, name)
+        globals()[name] = fn
+        return fn
+    if name == "aio":
+        import importlib
+        return importlib.import_module(".aio", __name__)
+    raise AttributeError(f"module {__name__!r} has no attribute {name!r}")
+
+
+def __dir__():
+    return sorted(set(globals()) | _PUBLIC | {"aio"})
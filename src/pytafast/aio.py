@@ -0,0 +1,48 @@
+"""Async wrappers for all pytafast functions via asyncio.to_thread.
+
+Usage:
+    import pytafast
+    result = await pytafast.aio.SMA(close, timeperiod=20)
+
+Each wrapper is built the first time it is looked up.
+"""
+
+import asyncio as _asyncio
+
+import pytafast as _pytafast
+from . import pytafast_ext
+
+
+def _traced_call(sync_fn, queued_ns, args, kwargs):
+    # Runs on the worker thread: the span from submission to here is the
+    # queue wait, and when it is sampled the call below is too
+    pytafast_ext.trace_span(f"{sync_fn.__name__} queued", "queue", queued_ns,
+                            pytafast_ext.trace_now())
+    return sync_fn(*args, **kwargs)
+
+
+def _make_async(sync_fn):
+    async def wrapper(*args, **kwargs):
+        if pytafast_ext.trace_enabled():
+            return await _asyncio.to_thread(_traced_call, sync_fn,
+                                            pytafast_ext.trace_now(), args, kwargs)
+        return await _asyncio.to_thread(sync_fn, *args, **kwargs)
+    wrapper.__name__ = sync_fn.__name__
+    wrapper.__doc__ = sync_fn.__doc__
+    return wrapper
+
+
+# `from pytafast.aio import *`: the async version of every indicator
+__all__ = sorted(_pytafast._PUBLIC)
+
+
+def __getattr__(name):
+    if name not in _pytafast._PUBLIC and name not in _pytafast._PLUGINS:
+        raise AttributeError(f"module {__name__!r} has no attribute {name!r}")
+    wrapper = _make_async(getattr(_pytafast, name))
+    globals()[name] = wrapper
+    return wrapper
+
+
+def __dir__():
+    return sorted(set(globals()) | _pytafast._PUBLIC | set(_pytafast._PLUGINS))
@@ -0,0 +1,273 @@
+"""Many series at once: threads in this process, or processes over POSIX
+shared memory.
+
+``ThreadEngine`` hands all the rows to the extension in one call; they are
+spread over threads with the GIL released throughout, so they run in
+parallel without leaving the interpreter::
+
+    from pytafast.parallel import ThreadEngine
+
+    rsi = ThreadEngine(workers=8).run("RSI", closes, timeperiod=14)
+
+``SharedMemoryEngine`` runs the full Python wrappers in worker processes
+instead. For backfills across many series, ``multiprocessing`` normally
+pickles every input to the workers and every result back, which can cost
+more than the indicators. Here inputs and outputs live in shared memory
+segments: each worker attaches to them by name, runs the pytafast function
+on its rows and writes results in place, and the parent gets numpy arrays
+over the output segments. Only the function name, segment names and row
+ranges cross the process boundary::
+
+    from pytafast.parallel import SharedMemoryEngine
+
+    with SharedMemoryEngine(workers=8) as engine:
+        closes = engine.empty((n_symbols, n_bars))   # fill in place: no copy
+        closes[:] = load_closes()
+        rsi = engine.run("RSI", closes, timeperiod=14)        # (n_symbols, n_bars)
+        upper, middle, lower = engine.run("BBANDS", closes, timeperiod=20)
+
+Inputs are 2-D, one series per row. Arrays from ``engine.empty`` are read
+in place; anything else is copied into a segment once per ``run``. Results
+stay valid after the engine is closed: a segment is unmapped and unlinked
+when the last array viewing it is gone.
+"""
+
+import math
+import os
+import sys
+import weakref
+from concurrent.futures import ProcessPoolExecutor
+from multiprocessing import shared_memory
+
+import numpy as np
+
+import pytafast
+
+__all__ = ["SharedMemoryEngine", "ThreadEngine"]
+
+
+def _attach(name):
+    # Pool workers share the parent's resource tracker, so before 3.13 the
+    # attach registers a name the parent already owns (a no-op); the parent
+    # unlinks it
+    if sys.version_info >= (3, 13):
+        return shared_memory.SharedMemory(name=name, track=False)
+    return shared_memory.SharedMemory(name=name)
+
+
+def _split(info, inputs):
+    """(2-D float64 inputs, remaining positional args), checked as ``run``
+    takes them."""
+    n_inputs = len(info["inputs"])
+    if len(inputs) < n_inputs:
+        raise TypeError(f"{info['name']} takes {n_inputs} input series")
+    arrays = [np.asarray(x) for x in inputs[:n_inputs]]
+    shape = arrays[0].shape
+    if len(shape) != 2:
+        raise ValueError("inputs must be 2-D: one series per row")
+    if any(x.shape != shape for x in arrays):
+        raise ValueError("Input shapes must match")
+    return arrays, inputs[n_inputs:]
+
+
+def _release(shm):
+    try:
+        shm.close()
+    except BufferError:  # interpreter exit with arrays still alive
+        pass
+    shm.unlink()
+
+
+def _view(shm, dtype, shape, offset=0):
+    return np.ndarray(shape, dtype=dtype, buffer=shm.buf, offset=offset)
+
+
+def _fill(fn, ins, outs, rows, args, kwargs):
+    for row in range(*rows):
+        result = fn(*[x[row] for x in ins], *args, **kwargs)
+        if not isinstance(result, tuple):
+            result = (result,)
+        for out, values in zip(outs, result):
+            out[row] = values
+
+
+def _run_shard(name, inputs, outputs, rows, args, kwargs, plugin=None):
+    """Worker: ``name`` on rows [begin, end) of every input, written into the
+    outputs. Inputs and outputs are (segment, dtype, shape, offset);
+    ``plugin`` is the library of a plugin function, loaded on first use."""
+    if plugin is not None and name not in pytafast._PLUGINS:
+        pytafast.load_plugin(plugin)
+    segments = {seg: _attach(seg) for seg, *_ in inputs + outputs}
+    try:
+        # The views only live for the duration of the call, so the
+        # segments can be closed afterwards
+        _fill(getattr(pytafast, name),
+              [_view(segments[seg], dtype, shape, offset)
+               for seg, dtype, shape, offset in inputs],
+              [_view(segments[seg], dtype, shape, offset)
+               for seg, dtype, shape, offset in outputs],
+              rows, args, kwargs)
+    finally:
+        for shm in segments.values():
+            try:
+                shm.close()
+            except BufferError:  # views still held by a traceback
+                pass
+
+
+class SharedMemoryEngine:
+    """A process pool that exchanges arrays through shared memory.
+
+    ``workers`` defaults to ``os.cpu_count()``; ``mp_context`` is passed to
+    the ``ProcessPoolExecutor``. Use as a context manager or call
+    ``close()``.
+    """
+
+    def __init__(self, workers=None, mp_context=None):
+        self.workers = workers or os.cpu_count() or 1
+        self._pool = ProcessPoolExecutor(self.workers, mp_context=mp_context)
+        # Segments behind arrays handed out by empty(): base address -> shm
+        self._owned = {}
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+    def close(self):
+        """Shut the workers down. Arrays already returned stay valid."""
+        self._pool.shutdown()
+
+    def _segment(self, shape, dtype):
+        """New array over its own segment, released with the last array
+        that views it."""
+        dtype = np.dtype(dtype)
+        size = max(math.prod(shape) * dtype.itemsize, 1)
+        shm = shared_memory.SharedMemory(create=True, size=size)
+        arr = _view(shm, dtype, shape)
+        weakref.finalize(arr, _release, shm)
+        return arr, shm
+
+    def empty(self, shape, dtype=np.float64):
+        """Uninitialised array in shared memory, read in place by ``run``."""
+        arr, shm = self._segment(tuple(shape), dtype)
+        self._owned[arr.ctypes.data] = (weakref.ref(arr), shm)
+        return arr
+
+    def _locate(self, arr):
+        """(segment, offset) if ``arr`` is a C-contiguous float64 view into a
+        segment from ``empty()``, else None."""
+        if arr.dtype != np.float64 or not arr.flags.c_contiguous:
+            return None
+        address = arr.ctypes.data
+        for base, (ref, shm) in list(self._owned.items()):
+            if ref() is None:
+                del self._owned[base]
+            elif base <= address and address + arr.nbytes <= base + shm.size:
+                return shm.name, address - base
+        return None
+
+    def run(self, name, *inputs, **kwargs):
+        """``pytafast.<name>`` on every row of the 2-D ``inputs``.
+
+        Returns one (n_series, n_bars) array per output - a tuple for
+        multi-output functions - backed by shared memory.
+        """
+        info = pytafast.function_info(name)
+        inputs, args = _split(info, inputs)
+        shape = inputs[0].shape
+
+        if info["name"] in pytafast._OUTPUT_SELECTION:
+            outputs = kwargs.get("outputs",
+                                 pytafast._OUTPUT_SELECTION[info["name"]])
+            n_out = 1 if isinstance(outputs, str) else len(outputs)
+        else:
+            n_out = len(info["outputs"])
+        dtype = np.dtype(info["output_dtype"])
+
+        temporaries = []
+        specs = []
+        for x in inputs:
+            located = self._locate(x)
+            if located is None:
+                arr, shm = self._segment(shape, np.float64)
+                arr[:] = x
+                temporaries.append(arr)
+                located = (shm.name, 0)
+            segment, offset = located
+            specs.append((segment, "float64", shape, offset))
+
+        results = [self._segment(shape, dtype) for _ in range(n_out)]
+        out_specs = [(shm.name, dtype.str, shape, 0) for _, shm in results]
+
+        rows = shape[0]
+        step = max(1, math.ceil(rows / self.workers))
+        futures = [
+            self._pool.submit(_run_shard, info["name"], specs, out_specs,
+                              (begin, min(begin + step, rows)), args, kwargs,
+                              pytafast._PLUGINS.get(info["name"]))
+            for begin in range(0, rows, step)
+        ]
+        for future in futures:
+            future.result()
+        del temporaries
+
+        outs = tuple(arr for arr, _ in results)
+        return outs if n_out > 1 else outs[0]
+
+
+class ThreadEngine:
+    """Rows spread over threads of this process by the extension.
+
+    ``run`` takes what ``SharedMemoryEngine.run`` takes, with parameters
+    by keyword, and returns plain numpy arrays; the whole batch runs in one
+    call with the GIL released, so other Python threads keep running
+    meanwhile. ``workers`` defaults to ``os.cpu_count()``. Functions must be
+    in ``pytafast.function_names()`` (TA-Lib functions and loaded plugins);
+    ``nan_policy`` and the result cache do not apply.
+    """
+
+    def __init__(self, workers=None):
+        self.workers = workers or os.cpu_count() or 1
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *exc):
+        self.close()
+
+    def close(self):
+        """Nothing to release: threads only live for the duration of a
+        ``run``."""
+
+    def run(self, name, *inputs, **kwargs):
+        """``pytafast.<name>`` on every row of the 2-D ``inputs``.
+
+        Returns one (n_series, n_bars) array per output - a tuple for
+        multi-output functions.
+        """
+        info = pytafast.function_info(name)
+        inputs, args = _split(info, inputs)
+        selected = None
+        if info["name"] in pytafast._OUTPUT_SELECTION:
+            selected = kwargs.pop("outputs",
+                                  pytafast._OUTPUT_SELECTION[info["name"]])
+
+        if args:
+            raise TypeError("ThreadEngine.run takes parameters by keyword")
+        for key in kwargs:
+            if key not in info["parameters"]:
+                raise TypeError(f"{info['name']} has no parameter {key!r}")
+        params = [float(pytafast._ma_int(kwargs.get(key, default)))
+                  for key, default in info["parameters"].items()]
+
+        outs = pytafast.pytafast_ext.compute_many(
+            info["name"],
+            [np.ascontiguousarray(x, dtype=np.float64) for x in inputs],
+            params, self.workers)
+        if selected is None:
+            return outs
+        if isinstance(selected, str):
+            return outs[info["outputs"].index(selected)]
+        return tuple(outs[info["outputs"].index(s)] for s in selected)
@@ -0,0 +1,138 @@
+"""Polars expression namespace: ``pl.col("close").ta.rsi(14).over("symbol")``.
+
+Importing this module registers the ``ta`` namespace on ``pl.Expr``. Every
+pytafast function is available under its lower-case name::
+
+    import polars as pl
+    import pytafast.polars  # noqa: F401  (registers .ta)
+
+    df.with_columns(
+        pl.col("close").ta.rsi(14).over("symbol").alias("rsi"),
+        pl.col("close").ta.atr(high="high", low="low", timeperiod=14).over("symbol"),
+        pl.col("close").ta.bbands(timeperiod=20).over("symbol").alias("bb"),  # struct
+    )
+
+Like other single-input expressions, a single-input function keeps the
+input's column name; multi-input functions are named after the function.
+
+The expression the namespace hangs off is the primary price input (inReal,
+or inClose for bar-based functions). Other OHLCV inputs are passed as
+``open=``, ``high=``, ``low=``, ``volume=`` (column names or expressions)
+and the second series of two-input functions as ``other=``. The function's
+parameters follow, positionally or by name.
+
+The expressions are a native Polars plugin (the ``pytafast_polars`` library
+next to the extension module): Polars calls pytafast_core from its own
+thread pool, one call per batch or per group under ``.over``, without the
+GIL and without a Python callback. A float64 column in one chunk without
+nulls is read in place; other inputs are cast to float64, with nulls as
+NaN. NaN outputs (the lookback region) come back as null.
+"""
+
+import glob
+import os
+
+import polars as pl
+from polars.plugins import register_plugin_function
+
+import pytafast
+
+# Keyword each registry input is passed under; None is the expression the
+# namespace hangs off
+_ROLES = {"inReal": None, "inReal0": None, "inClose": None, "inReal1": "other",
+          "inOpen": "open", "inHigh": "high", "inLow": "low", "inVolume": "volume"}
+
+# Functions whose public input names (inReal0, inReal1) hide what they are
+_ROLE_OVERRIDES = {"MEDPRICE": ("high", "low"), "OBV": (None, "volume")}
+
+_FUNCTIONS = set(pytafast.function_names())
+
+
+def _find_library():
+    here = os.path.dirname(__file__)
+    for suffix in (".so", ".pyd", ".dll", ".dylib"):
+        found = glob.glob(os.path.join(here, "pytafast_polars*" + suffix))
+        if found:
+            return found[0]
+    raise ImportError("pytafast was built without its Polars plugin "
+                      "(pytafast_polars)")
+
+
+_LIBRARY = _find_library()
+
+
+def _inputs_for(info):
+    if info["name"] in _ROLE_OVERRIDES:
+        return _ROLE_OVERRIDES[info["name"]]
+    return tuple(_ROLES[name] for name in info["inputs"])
+
+
+def _params(name, params, args, kwargs):
+    """Every parameter of ``name`` as a float, in order, defaults filled in."""
+    if len(args) > len(params):
+        raise TypeError(f"{name.lower()}() takes at most {len(params)} "
+                        f"parameters")
+    values = dict(zip(params, args))
+    for key, value in kwargs.items():
+        if key not in params or key in values:
+            raise TypeError(f"{name.lower()}() got an unexpected or repeated "
+                            f"argument {key!r}")
+        values[key] = value
+    # MAType members become their int value
+    return [float(pytafast._ma_int(v)) if hasattr(v, "value") else float(v)
+            for v in (values.get(p, d) for p, d in params.items())]
+
+
+class TAExprNamespace:
+    def __init__(self, expr):
+        self._expr = expr
+
+    def __getattr__(self, attr):
+        name = attr.upper()
+        if attr.startswith("_") or name not in _FUNCTIONS:
+            raise AttributeError(f"pytafast has no function {name!r}")
+        fn = getattr(pytafast, name)
+
+        def method(*args, **kwargs):
+            return self._call(name, args, kwargs)
+
+        method.__name__ = attr
+        method.__doc__ = fn.__doc__
+        return method
+
+    def _call(self, name, args, kwargs):
+        info = pytafast.function_info(name)
+        if name in pytafast._OUTPUT_SELECTION:
+            outputs = kwargs.pop("outputs", pytafast._OUTPUT_SELECTION[name])
+            outputs = [outputs] if isinstance(outputs, str) else list(outputs)
+        else:
+            outputs = list(info["outputs"]) if len(info["outputs"]) > 1 else []
+
+        roles = _inputs_for(info)
+        columns = []
+        for role in roles:
+            if role is None:
+                columns.append(self._expr)
+                continue
+            col = kwargs.pop(role, None)
+            if col is None:
+                raise TypeError(f"{name.lower()}() needs {role}=<column or expression>")
+            columns.append(pl.col(col) if isinstance(col, str) else col)
+
+        expr = register_plugin_function(
+            plugin_path=_LIBRARY,
+            function_name="ta",
+            args=[c.cast(pl.Float64) for c in columns],
+            kwargs={
+                "function": name,
+                "params": _params(name, info["parameters"], args, kwargs),
+                "outputs": outputs,
+                # Plugin functions are loaded into the Polars plugin too
+                "plugin": pytafast._PLUGINS.get(name, ""),
+            },
+            use_abs_path=True,
+        )
+        return expr if len(columns) == 1 else expr.alias(name.lower())
+
+
+pl.api.register_expr_namespace("ta")(TAExprNamespace)
@@ -1,208 +1,103 @@
 // pytafast_ext - Main module definition
 // Function implementations are in separate files:
-//   overlap.cpp, momentum.cpp, volatility.cpp, price_transform.cpp, volume.cpp
+//   functions.h / functions.cpp (kernels for the function table,
+//   core/function_list.h)
+//   overlap.cpp, momentum.cpp, volatility.cpp, price_transform.cpp, volume.cpp,
+//   statistic.cpp, cycle.cpp (functions with a signature of their own)
+//   arrow.cpp (Arrow C Data Interface import/export)
+//   nan_policy.cpp (NaN-gap handling: propagate / skip / restart)
+//   registry.cpp (function metadata and lookbacks for Python; the table
+//   itself is in pytafast_core, include/pytafast/core.h)
+//   cache.cpp (opt-in result cache)
+//   plugin.cpp (native indicator plugins, include/pytafast/plugin.h)
+//   parallel.cpp (many series over threads, pytafast.parallel.ThreadEngine)
+//   stream.cpp (stateful bar-by-bar indicators: HTStream, StreamCDL)
+//   stats.cpp (per-function counters, PYTAFAST_STATS builds)
+//   trace.cpp (Chrome / Perfetto trace recording)
 #include "common.h"
+#include "dispatch.h"
+#include "functions.h"
+#include "parallel.h"
+#include "plugin.h"
+#include "registry.h"
+#include "stream.h"
 
 // Forward declarations from overlap.cpp
-DoubleArrayOUT sma(DoubleArrayIN, int);
-DoubleArrayOUT ema(DoubleArrayIN, int);
-nb::tuple bbands(DoubleArrayIN, int, double, double, int);
-DoubleArrayOUT dema(DoubleArrayIN, int);
-DoubleArrayOUT kama(DoubleArrayIN, int);
+nb::object bbands(DoubleArrayIN, int, double, double, int, const std::string &);
 DoubleArrayOUT ma(DoubleArrayIN, int, int);
 DoubleArrayOUT t3(DoubleArrayIN, int, double);
-DoubleArrayOUT tema(DoubleArrayIN, int);
-DoubleArrayOUT trima(DoubleArrayIN, int);
-DoubleArrayOUT wma(DoubleArrayIN, int);
 DoubleArrayOUT sar(DoubleArrayIN, DoubleArrayIN, double, double);
-DoubleArrayOUT midpoint(DoubleArrayIN, int);
 
 // Forward declarations from momentum.cpp
-DoubleArrayOUT rsi(DoubleArrayIN, int);
-nb::tuple macd(DoubleArrayIN, int, int, int);
-nb::tuple macdext(DoubleArrayIN, int, int, int, int, int, int);
-nb::tuple macdfix(DoubleArrayIN, int);
-DoubleArrayOUT roc(DoubleArrayIN, int);
-DoubleArrayOUT rocp(DoubleArrayIN, int);
-DoubleArrayOUT rocr(DoubleArrayIN, int);
-DoubleArrayOUT rocr100(DoubleArrayIN, int);
-nb::tuple stoch(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN, int, int, int, int,
-                int);
-nb::tuple stochf(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN, int, int, int);
-nb::tuple stochrsi(DoubleArrayIN, int, int, int, int);
-DoubleArrayOUT mom(DoubleArrayIN, int);
-DoubleArrayOUT cmo(DoubleArrayIN, int);
+nb::object macd(DoubleArrayIN, int, int, int, const std::string &);
+nb::object macdext(DoubleArrayIN, int, int, int, int, int, int,
+                   const std::string &);
+nb::object macdfix(DoubleArrayIN, int, const std::string &);
+nb::object stoch(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN, int, int, int,
+                 int, int, const std::string &);
+nb::object stochf(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN, int, int, int,
+                  const std::string &);
+nb::object stochrsi(DoubleArrayIN, int, int, int, int, const std::string &);
 DoubleArrayOUT apo(DoubleArrayIN, int, int, int);
 DoubleArrayOUT ppo(DoubleArrayIN, int, int, int);
-DoubleArrayOUT trix(DoubleArrayIN, int);
-nb::tuple aroon(DoubleArrayIN, DoubleArrayIN, int);
-DoubleArrayOUT aroonosc(DoubleArrayIN, DoubleArrayIN, int);
-DoubleArrayOUT adx(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN, int);
-DoubleArrayOUT adxr(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN, int);
-DoubleArrayOUT dx(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN, int);
-DoubleArrayOUT minus_di(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN, int);
-DoubleArrayOUT minus_dm(DoubleArrayIN, DoubleArrayIN, int);
-DoubleArrayOUT plus_di(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN, int);
-DoubleArrayOUT plus_dm(DoubleArrayIN, DoubleArrayIN, int);
-DoubleArrayOUT willr(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN, int);
+nb::object aroon(DoubleArrayIN, DoubleArrayIN, int, const std::string &);
 DoubleArrayOUT mfi(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN, DoubleArrayIN,
                    int);
-DoubleArrayOUT cci(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN, int);
 DoubleArrayOUT ultosc(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN, int, int,
                       int);
 DoubleArrayOUT bop(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN, DoubleArrayIN);
+nb::object dmi_all(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN, int,
+                   const std::string &);
+nb::object stoch_all(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN,
+                     const std::vector<std::string> &, int, int, int, int, int,
+                     int, int, const std::string &);
 
 // Forward declarations from volatility.cpp
-DoubleArrayOUT atr(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN, int);
-DoubleArrayOUT natr(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN, int);
 DoubleArrayOUT trange(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN);
 DoubleArrayOUT stddev(DoubleArrayIN, int, double);
 
 // Forward declarations from volume.cpp
-DoubleArrayOUT obv(DoubleArrayIN, DoubleArrayIN);
 DoubleArrayOUT ad(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN, DoubleArrayIN);
 DoubleArrayOUT adosc(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN, DoubleArrayIN,
                      int, int);
 
 // Forward declarations from statistic.cpp
-DoubleArrayOUT beta(DoubleArrayIN, DoubleArrayIN, int);
-DoubleArrayOUT correl(DoubleArrayIN, DoubleArrayIN, int);
-DoubleArrayOUT linearreg(DoubleArrayIN, int);
-DoubleArrayOUT linearreg_angle(DoubleArrayIN, int);
-DoubleArrayOUT linearreg_intercept(DoubleArrayIN, int);
-DoubleArrayOUT linearreg_slope(DoubleArrayIN, int);
-DoubleArrayOUT tsf(DoubleArrayIN, int);
 DoubleArrayOUT var(DoubleArrayIN, int, double);
-DoubleArrayOUT avgdev(DoubleArrayIN, int);
-DoubleArrayOUT ta_max(DoubleArrayIN, int);
-DoubleArrayOUT ta_min(DoubleArrayIN, int);
-DoubleArrayOUT ta_sum(DoubleArrayIN, int);
-nb::tuple minmax(DoubleArrayIN, int);
+nb::object minmax(DoubleArrayIN, int, const std::string &);
 nb::tuple minmaxindex(DoubleArrayIN, int);
 
 // Forward declarations from cycle.cpp
-DoubleArrayOUT ht_dcperiod(DoubleArrayIN);
-DoubleArrayOUT ht_dcphase(DoubleArrayIN);
-nb::tuple ht_phasor(DoubleArrayIN);
-nb::tuple ht_sine(DoubleArrayIN);
-DoubleArrayOUT ht_trendline(DoubleArrayIN);
-nb::ndarray<int, nb::numpy, nb::ndim<1>> ht_trendmode(DoubleArrayIN);
+nb::object ht_phasor(DoubleArrayIN, const std::string &);
+nb::object ht_sine(DoubleArrayIN, const std::string &);
+IntArrayOUT ht_trendmode(DoubleArrayIN);
+nb::object ht_all(DoubleArrayIN, const std::string &);
 
+// Forward declarations from price_transform.cpp
 DoubleArrayOUT avgprice(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN,
                         DoubleArrayIN);
-DoubleArrayOUT medprice(DoubleArrayIN, DoubleArrayIN);
 DoubleArrayOUT typprice(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN);
 DoubleArrayOUT wclprice(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN);
-DoubleArrayOUT midprice(DoubleArrayIN, DoubleArrayIN, int);
-
-// Forward declarations from math_operator.cpp
-DoubleArrayOUT add(DoubleArrayIN, DoubleArrayIN);
-DoubleArrayOUT sub(DoubleArrayIN, DoubleArrayIN);
-DoubleArrayOUT mult(DoubleArrayIN, DoubleArrayIN);
-DoubleArrayOUT ta_div(DoubleArrayIN, DoubleArrayIN);
-
-// Forward declarations from math_transform.cpp
-DoubleArrayOUT ta_acos(DoubleArrayIN);
-DoubleArrayOUT ta_asin(DoubleArrayIN);
-DoubleArrayOUT ta_atan(DoubleArrayIN);
-DoubleArrayOUT ta_ceil(DoubleArrayIN);
-DoubleArrayOUT ta_cos(DoubleArrayIN);
-DoubleArrayOUT ta_cosh(DoubleArrayIN);
-DoubleArrayOUT ta_exp(DoubleArrayIN);
-DoubleArrayOUT ta_floor(DoubleArrayIN);
-DoubleArrayOUT ta_ln(DoubleArrayIN);
-DoubleArrayOUT ta_log10(DoubleArrayIN);
-DoubleArrayOUT ta_sin(DoubleArrayIN);
-DoubleArrayOUT ta_sinh(DoubleArrayIN);
-DoubleArrayOUT ta_sqrt(DoubleArrayIN);
-DoubleArrayOUT ta_tan(DoubleArrayIN);
-DoubleArrayOUT ta_tanh(DoubleArrayIN);
-
-// Forward declarations from candlestick.cpp
-using IntArrayOUT = nb::ndarray<int, nb::numpy, nb::ndim<1>>;
-#define CDL_FWD(NAME)                                                          \
-  IntArrayOUT NAME(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN, DoubleArrayIN)
-#define CDL_FWD_PEN(NAME)                                                      \
-  IntArrayOUT NAME(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN, DoubleArrayIN, \
-                   double)
-CDL_FWD(cdl2crows);
-CDL_FWD(cdl3blackcrows);
-CDL_FWD(cdl3inside);
-CDL_FWD(cdl3linestrike);
-CDL_FWD(cdl3outside);
-CDL_FWD(cdl3starsinsouth);
-CDL_FWD(cdl3whitesoldiers);
-CDL_FWD(cdladvanceblock);
-CDL_FWD(cdlbelthold);
-CDL_FWD(cdlbreakaway);
-CDL_FWD(cdlclosingmarubozu);
-CDL_FWD(cdlconcealbabyswall);
-CDL_FWD(cdlcounterattack);
-CDL_FWD(cdldoji);
-CDL_FWD(cdldojistar);
-CDL_FWD(cdldragonflydoji);
-CDL_FWD(cdlengulfing);
-CDL_FWD(cdlgapsidesidewhite);
-CDL_FWD(cdlgravestonedoji);
-CDL_FWD(cdlhammer);
-CDL_FWD(cdlhangingman);
-CDL_FWD(cdlharami);
-CDL_FWD(cdlharamicross);
-CDL_FWD(cdlhighwave);
-CDL_FWD(cdlhikkake);
-CDL_FWD(cdlhikkakemod);
-CDL_FWD(cdlhomingpigeon);
-CDL_FWD(cdlidentical3crows);
-CDL_FWD(cdlinneck);
-CDL_FWD(cdlinvertedhammer);
-CDL_FWD(cdlkicking);
-CDL_FWD(cdlkickingbylength);
-CDL_FWD(cdlladderbottom);
-CDL_FWD(cdllongleggeddoji);
-CDL_FWD(cdllongline);
-CDL_FWD(cdlmarubozu);
-CDL_FWD(cdlmatchinglow);
-CDL_FWD(cdlonneck);
-CDL_FWD(cdlpiercing);
-CDL_FWD(cdlrickshawman);
-CDL_FWD(cdlrisefall3methods);
-CDL_FWD(cdlseparatinglines);
-CDL_FWD(cdlshootingstar);
-CDL_FWD(cdlshortline);
-CDL_FWD(cdlspinningtop);
-CDL_FWD(cdlstalledpattern);
-CDL_FWD(cdlsticksandwich);
-CDL_FWD(cdltakuri);
-CDL_FWD(cdltasukigap);
-CDL_FWD(cdlthrusting);
-CDL_FWD(cdltristar);
-CDL_FWD(cdlunique3river);
-CDL_FWD(cdlupsidegap2crows);
-CDL_FWD(cdlxsidegap3methods);
-CDL_FWD_PEN(cdlabandonedbaby);
-CDL_FWD_PEN(cdldarkcloudcover);
-CDL_FWD_PEN(cdleveningdojistar);
-CDL_FWD_PEN(cdleveningstar);
-CDL_FWD_PEN(cdlmathold);
-CDL_FWD_PEN(cdlmorningdojistar);
-CDL_FWD_PEN(cdlmorningstar);
-#undef CDL_FWD
-#undef CDL_FWD_PEN
-
-// Helper to initialize and shutdown TA-lib
-void initialize() {
-  TA_RetCode retcode = TA_Initialize();
-  check_ta_retcode(retcode, "TA_Initialize");
-}
-
-void shutdown() {
-  TA_RetCode retcode = TA_Shutdown();
-  check_ta_retcode(retcode, "TA_Shutdown");
-}
+nb::object price_all(DoubleArrayIN, DoubleArrayIN, DoubleArrayIN,
+                     DoubleArrayIN, const std::vector<std::string> &,
+                     const std::string &);
 
 NB_MODULE(pytafast_ext, m) {
   m.doc() = "TA-Lib wrapper using nanobind";
 
+  // The module holds a reference to TA-Lib's context (see
+  // pytafast::initialize) for as long as it lives: it is dropped when the
+  // interpreter tears the module down, after any atexit hooks that may
+  // still compute
+  static const char context_tag = 0;
+  pytafast::initialize();
+  m.attr("_ta_context") = nb::capsule(&context_tag, [](void *) noexcept {
+    try {
+      pytafast::shutdown();
+    } catch (const std::exception &) {
+      // Nothing to report to during teardown
+    }
+  });
+
   nb::enum_<TA_MAType>(m, "MAType")
       .value("SMA", TA_MAType_SMA)
       .value("EMA", TA_MAType_EMA)
@@ -215,293 +110,309 @@ NB_MODULE(pytafast_ext, m) {
       .value("T3", TA_MAType_T3);
 
   // --- Overlap Studies ---
-  m.def("SMA", &sma, nb::arg("inReal").noconvert(),
-        nb::arg("optInTimePeriod") = 30);
-  m.def("EMA", &ema, nb::arg("inReal").noconvert(),
-        nb::arg("optInTimePeriod") = 30);
-  m.def("BBANDS", &bbands, nb::arg("inReal").noconvert(),
+  m.def("BBANDS", timed<&bbands>("BBANDS"), nb::arg("inReal").noconvert(),
         nb::arg("optInTimePeriod") = 5, nb::arg("optInNbDevUp") = 2.0,
-        nb::arg("optInNbDevDn") = 2.0, nb::arg("optInMAType") = 0);
-  m.def("DEMA", &dema, nb::arg("inReal").noconvert(),
-        nb::arg("optInTimePeriod") = 30);
-  m.def("KAMA", &kama, nb::arg("inReal").noconvert(),
-        nb::arg("optInTimePeriod") = 30);
-  m.def("MA", &ma, nb::arg("inReal").noconvert(),
+        nb::arg("optInNbDevDn") = 2.0, nb::arg("optInMAType") = 0,
+        nb::arg("layout") = "tuple");
+  m.def("MA", timed<&ma>("MA"), nb::arg("inReal").noconvert(),
         nb::arg("optInTimePeriod") = 30, nb::arg("optInMAType") = 0);
-  m.def("T3", &t3, nb::arg("inReal").noconvert(),
+  m.def("T3", timed<&t3>("T3"), nb::arg("inReal").noconvert(),
         nb::arg("optInTimePeriod") = 5, nb::arg("optInVFactor") = 0.7);
-  m.def("TEMA", &tema, nb::arg("inReal").noconvert(),
-        nb::arg("optInTimePeriod") = 30);
-  m.def("TRIMA", &trima, nb::arg("inReal").noconvert(),
-        nb::arg("optInTimePeriod") = 30);
-  m.def("WMA", &wma, nb::arg("inReal").noconvert(),
-        nb::arg("optInTimePeriod") = 30);
-  m.def("SAR", &sar, nb::arg("inHigh").noconvert(),
+  m.def("SAR", timed<&sar>("SAR"), nb::arg("inHigh").noconvert(),
         nb::arg("inLow").noconvert(), nb::arg("optInAcceleration") = 0.02,
         nb::arg("optInMaximum") = 0.2);
-  m.def("MIDPOINT", &midpoint, nb::arg("inReal").noconvert(),
-        nb::arg("optInTimePeriod") = 14);
 
   // --- Momentum ---
-  m.def("RSI", &rsi, nb::arg("inReal").noconvert(),
-        nb::arg("optInTimePeriod") = 14);
-  m.def("MACD", &macd, nb::arg("inReal").noconvert(),
+  m.def("MACD", timed<&macd>("MACD"), nb::arg("inReal").noconvert(),
         nb::arg("optInFastPeriod") = 12, nb::arg("optInSlowPeriod") = 26,
-        nb::arg("optInSignalPeriod") = 9);
-  m.def("MACDEXT", &macdext, nb::arg("inReal").noconvert(),
+        nb::arg("optInSignalPeriod") = 9, nb::arg("layout") = "tuple");
+  m.def("MACDEXT", timed<&macdext>("MACDEXT"), nb::arg("inReal").noconvert(),
         nb::arg("optInFastPeriod") = 12, nb::arg("optInFastMAType") = 0,
         nb::arg("optInSlowPeriod") = 26, nb::arg("optInSlowMAType") = 0,
-        nb::arg("optInSignalPeriod") = 9, nb::arg("optInSignalMAType") = 0);
-  m.def("MACDFIX", &macdfix, nb::arg("inReal").noconvert(),
-        nb::arg("optInSignalPeriod") = 9);
-  m.def("ROC", &roc, nb::arg("inReal").noconvert(),
-        nb::arg("optInTimePeriod") = 10);
-  m.def("ROCP", &rocp, nb::arg("inReal").noconvert(),
-        nb::arg("optInTimePeriod") = 10);
-  m.def("ROCR", &rocr, nb::arg("inReal").noconvert(),
-        nb::arg("optInTimePeriod") = 10);
-  m.def("ROCR100", &rocr100, nb::arg("inReal").noconvert(),
-        nb::arg("optInTimePeriod") = 10);
-  m.def("STOCH", &stoch, nb::arg("inHigh").noconvert(),
+        nb::arg("optInSignalPeriod") = 9, nb::arg("optInSignalMAType") = 0,
+        nb::arg("layout") = "tuple");
+  m.def("MACDFIX", timed<&macdfix>("MACDFIX"), nb::arg("inReal").noconvert(),
+        nb::arg("optInSignalPeriod") = 9, nb::arg("layout") = "tuple");
+  m.def("STOCH", timed<&stoch>("STOCH"), nb::arg("inHigh").noconvert(),
         nb::arg("inLow").noconvert(), nb::arg("inClose").noconvert(),
         nb::arg("optInFastK_Period") = 5, nb::arg("optInSlowK_Period") = 3,
         nb::arg("optInSlowK_MAType") = 0, nb::arg("optInSlowD_Period") = 3,
-        nb::arg("optInSlowD_MAType") = 0);
-  m.def("STOCHF", &stochf, nb::arg("inHigh").noconvert(),
+        nb::arg("optInSlowD_MAType") = 0, nb::arg("layout") = "tuple");
+  m.def("STOCHF", timed<&stochf>("STOCHF"), nb::arg("inHigh").noconvert(),
         nb::arg("inLow").noconvert(), nb::arg("inClose").noconvert(),
         nb::arg("optInFastK_Period") = 5, nb::arg("optInFastD_Period") = 3,
-        nb::arg("optInFastD_MAType") = 0);
-  m.def("STOCHRSI", &stochrsi, nb::arg("inReal").noconvert(),
+        nb::arg("optInFastD_MAType") = 0, nb::arg("layout") = "tuple");
+  m.def("STOCHRSI", timed<&stochrsi>("STOCHRSI"), nb::arg("inReal").noconvert(),
         nb::arg("optInTimePeriod") = 14, nb::arg("optInFastK_Period") = 5,
-        nb::arg("optInFastD_Period") = 3, nb::arg("optInFastD_MAType") = 0);
-  m.def("MOM", &mom, nb::arg("inReal").noconvert(),
-        nb::arg("optInTimePeriod") = 10);
-  m.def("CMO", &cmo, nb::arg("inReal").noconvert(),
-        nb::arg("optInTimePeriod") = 14);
-  m.def("APO", &apo, nb::arg("inReal").noconvert(),
+        nb::arg("optInFastD_Period") = 3, nb::arg("optInFastD_MAType") = 0,
+        nb::arg("layout") = "tuple");
+  m.def("APO", timed<&apo>("APO"), nb::arg("inReal").noconvert(),
         nb::arg("optInFastPeriod") = 12, nb::arg("optInSlowPeriod") = 26,
         nb::arg("optInMAType") = 0);
-  m.def("PPO", &ppo, nb::arg("inReal").noconvert(),
+  m.def("PPO", timed<&ppo>("PPO"), nb::arg("inReal").noconvert(),
         nb::arg("optInFastPeriod") = 12, nb::arg("optInSlowPeriod") = 26,
         nb::arg("optInMAType") = 0);
-  m.def("TRIX", &trix, nb::arg("inReal").noconvert(),
-        nb::arg("optInTimePeriod") = 30);
-  m.def("AROON", &aroon, nb::arg("inHigh").noconvert(),
-        nb::arg("inLow").noconvert(), nb::arg("optInTimePeriod") = 14);
-  m.def("AROONOSC", &aroonosc, nb::arg("inHigh").noconvert(),
-        nb::arg("inLow").noconvert(), nb::arg("optInTimePeriod") = 14);
-  m.def("ADX", &adx, nb::arg("inHigh").noconvert(),
-        nb::arg("inLow").noconvert(), nb::arg("inClose").noconvert(),
-        nb::arg("optInTimePeriod") = 14);
-  m.def("ADXR", &adxr, nb::arg("inHigh").noconvert(),
-        nb::arg("inLow").noconvert(), nb::arg("inClose").noconvert(),
-        nb::arg("optInTimePeriod") = 14);
-  m.def("DX", &dx, nb::arg("inHigh").noconvert(), nb::arg("inLow").noconvert(),
-        nb::arg("inClose").noconvert(), nb::arg("optInTimePeriod") = 14);
-  m.def("MINUS_DI", &minus_di, nb::arg("inHigh").noconvert(),
-        nb::arg("inLow").noconvert(), nb::arg("inClose").noconvert(),
-        nb::arg("optInTimePeriod") = 14);
-  m.def("MINUS_DM", &minus_dm, nb::arg("inHigh").noconvert(),
-        nb::arg("inLow").noconvert(), nb::arg("optInTimePeriod") = 14);
-  m.def("PLUS_DI", &plus_di, nb::arg("inHigh").noconvert(),
-        nb::arg("inLow").noconvert(), nb::arg("inClose").noconvert(),
-        nb::arg("optInTimePeriod") = 14);
-  m.def("PLUS_DM", &plus_dm, nb::arg("inHigh").noconvert(),
-        nb::arg("inLow").noconvert(), nb::arg("optInTimePeriod") = 14);
-  m.def("WILLR", &willr, nb::arg("inHigh").noconvert(),
-        nb::arg("inLow").noconvert(), nb::arg("inClose").noconvert(),
-        nb::arg("optInTimePeriod") = 14);
-  m.def("MFI", &mfi, nb::arg("inHigh").noconvert(),
+  m.def("AROON", timed<&aroon>("AROON"), nb::arg("inHigh").noconvert(),
+        nb::arg("inLow").noconvert(), nb::arg("optInTimePeriod") = 14,
+        nb::arg("layout") = "tuple");
+  m.def("MFI", timed<&mfi>("MFI"), nb::arg("inHigh").noconvert(),
         nb::arg("inLow").noconvert(), nb::arg("inClose").noconvert(),
         nb::arg("inVolume").noconvert(), nb::arg("optInTimePeriod") = 14);
-  m.def("CCI", &cci, nb::arg("inHigh").noconvert(),
-        nb::arg("inLow").noconvert(), nb::arg("inClose").noconvert(),
-        nb::arg("optInTimePeriod") = 14);
-  m.def("ULTOSC", &ultosc, nb::arg("inHigh").noconvert(),
+  m.def("ULTOSC", timed<&ultosc>("ULTOSC"), nb::arg("inHigh").noconvert(),
         nb::arg("inLow").noconvert(), nb::arg("inClose").noconvert(),
         nb::arg("optInTimePeriod1") = 7, nb::arg("optInTimePeriod2") = 14,
         nb::arg("optInTimePeriod3") = 28);
-  m.def("BOP", &bop, nb::arg("inOpen").noconvert(),
+  m.def("BOP", timed<&bop>("BOP"), nb::arg("inOpen").noconvert(),
         nb::arg("inHigh").noconvert(), nb::arg("inLow").noconvert(),
         nb::arg("inClose").noconvert());
+  m.def("DMI_ALL", timed<&dmi_all>("DMI_ALL"), nb::arg("inHigh").noconvert(),
+        nb::arg("inLow").noconvert(), nb::arg("inClose").noconvert(),
+        nb::arg("optInTimePeriod") = 14, nb::arg("layout") = "tuple");
+  m.def("STOCH_ALL", timed<&stoch_all>("STOCH_ALL"),
+        nb::arg("inHigh").noconvert(), nb::arg("inLow").noconvert(),
+        nb::arg("inClose").noconvert(), nb::arg("outputs"),
+        nb::arg("optInFastK_Period") = 5, nb::arg("optInSlowK_Period") = 3,
+        nb::arg("optInSlowK_MAType") = 0, nb::arg("optInSlowD_Period") = 3,
+        nb::arg("optInSlowD_MAType") = 0, nb::arg("optInFastD_Period") = 3,
+        nb::arg("optInFastD_MAType") = 0, nb::arg("layout") = "tuple");
 
   // --- Volatility ---
-  m.def("ATR", &atr, nb::arg("inHigh").noconvert(),
-        nb::arg("inLow").noconvert(), nb::arg("inClose").noconvert(),
-        nb::arg("optInTimePeriod") = 14);
-  m.def("NATR", &natr, nb::arg("inHigh").noconvert(),
-        nb::arg("inLow").noconvert(), nb::arg("inClose").noconvert(),
-        nb::arg("optInTimePeriod") = 14);
-  m.def("TRANGE", &trange, nb::arg("inHigh").noconvert(),
+  m.def("TRANGE", timed<&trange>("TRANGE"), nb::arg("inHigh").noconvert(),
         nb::arg("inLow").noconvert(), nb::arg("inClose").noconvert());
-  m.def("STDDEV", &stddev, nb::arg("inReal").noconvert(),
+  m.def("STDDEV", timed<&stddev>("STDDEV"), nb::arg("inReal").noconvert(),
         nb::arg("optInTimePeriod") = 5, nb::arg("optInNbDev") = 1.0);
 
   // --- Volume ---
-  m.def("OBV", &obv, nb::arg("inReal").noconvert(),
+  m.def("AD", timed<&ad>("AD"), nb::arg("inHigh").noconvert(),
+        nb::arg("inLow").noconvert(), nb::arg("inClose").noconvert(),
         nb::arg("inVolume").noconvert());
-  m.def("AD", &ad, nb::arg("inHigh").noconvert(), nb::arg("inLow").noconvert(),
-        nb::arg("inClose").noconvert(), nb::arg("inVolume").noconvert());
-  m.def("ADOSC", &adosc, nb::arg("inHigh").noconvert(),
+  m.def("ADOSC", timed<&adosc>("ADOSC"), nb::arg("inHigh").noconvert(),
         nb::arg("inLow").noconvert(), nb::arg("inClose").noconvert(),
         nb::arg("inVolume").noconvert(), nb::arg("optInFastPeriod") = 3,
         nb::arg("optInSlowPeriod") = 10);
 
   // --- Statistics ---
-  m.def("BETA", &beta, nb::arg("inReal0").noconvert(),
-        nb::arg("inReal1").noconvert(), nb::arg("optInTimePeriod") = 5);
-  m.def("CORREL", &correl, nb::arg("inReal0").noconvert(),
-        nb::arg("inReal1").noconvert(), nb::arg("optInTimePeriod") = 30);
-  m.def("LINEARREG", &linearreg, nb::arg("inReal").noconvert(),
-        nb::arg("optInTimePeriod") = 14);
-  m.def("LINEARREG_ANGLE", &linearreg_angle, nb::arg("inReal").noconvert(),
-        nb::arg("optInTimePeriod") = 14);
-  m.def("LINEARREG_INTERCEPT", &linearreg_intercept,
-        nb::arg("inReal").noconvert(), nb::arg("optInTimePeriod") = 14);
-  m.def("LINEARREG_SLOPE", &linearreg_slope, nb::arg("inReal").noconvert(),
-        nb::arg("optInTimePeriod") = 14);
-  m.def("TSF", &tsf, nb::arg("inReal").noconvert(),
-        nb::arg("optInTimePeriod") = 14);
-  m.def("VAR", &var, nb::arg("inReal").noconvert(),
+  m.def("VAR", timed<&var>("VAR"), nb::arg("inReal").noconvert(),
         nb::arg("optInTimePeriod") = 5, nb::arg("optInNbDev") = 1.0);
-  m.def("AVGDEV", &avgdev, nb::arg("inReal").noconvert(),
-        nb::arg("optInTimePeriod") = 14);
+  m.def("MINMAX", timed<&minmax>("MINMAX"), nb::arg("inReal").noconvert(),
+        nb::arg("optInTimePeriod") = 30, nb::arg("layout") = "tuple");
+  m.def("MINMAXINDEX", timed<&minmaxindex>("MINMAXINDEX"),
+        nb::arg("inReal").noconvert(), nb::arg("optInTimePeriod") = 30);
 
   // --- Price Transform ---
-  m.def("AVGPRICE", &avgprice, nb::arg("inOpen").noconvert(),
+  m.def("AVGPRICE", timed<&avgprice>("AVGPRICE"), nb::arg("inOpen").noconvert(),
         nb::arg("inHigh").noconvert(), nb::arg("inLow").noconvert(),
         nb::arg("inClose").noconvert());
-  m.def("MEDPRICE", &medprice, nb::arg("inHigh").noconvert(),
-        nb::arg("inLow").noconvert());
-  m.def("TYPPRICE", &typprice, nb::arg("inHigh").noconvert(),
+  m.def("TYPPRICE", timed<&typprice>("TYPPRICE"), nb::arg("inHigh").noconvert(),
         nb::arg("inLow").noconvert(), nb::arg("inClose").noconvert());
-  m.def("WCLPRICE", &wclprice, nb::arg("inHigh").noconvert(),
+  m.def("WCLPRICE", timed<&wclprice>("WCLPRICE"), nb::arg("inHigh").noconvert(),
         nb::arg("inLow").noconvert(), nb::arg("inClose").noconvert());
-  m.def("MIDPRICE", &midprice, nb::arg("inHigh").noconvert(),
-        nb::arg("inLow").noconvert(), nb::arg("optInTimePeriod") = 14);
+  m.def("PRICE_ALL", timed<&price_all>("PRICE_ALL"),
+        nb::arg("inOpen").noconvert(), nb::arg("inHigh").noconvert(),
+        nb::arg("inLow").noconvert(), nb::arg("inClose").noconvert(),
+        nb::arg("outputs"), nb::arg("layout") = "tuple");
 
-  // --- Math Operators ---
-  m.def("ADD", &add, nb::arg("inReal0").noconvert(),
-        nb::arg("inReal1").noconvert());
-  m.def("SUB", &sub, nb::arg("inReal0").noconvert(),
-        nb::arg("inReal1").noconvert());
-  m.def("MULT", &mult, nb::arg("inReal0").noconvert(),
-        nb::arg("inReal1").noconvert());
-  m.def("DIV", &ta_div, nb::arg("inReal0").noconvert(),
-        nb::arg("inReal1").noconvert());
+  // --- Cycle ---
+  m.def("HT_PHASOR", timed<&ht_phasor>("HT_PHASOR"),
+        nb::arg("inReal").noconvert(), nb::arg("layout") = "tuple");
+  m.def("HT_SINE", timed<&ht_sine>("HT_SINE"), nb::arg("inReal").noconvert(),
+        nb::arg("layout") = "tuple");
+  m.def("HT_TRENDMODE", timed<&ht_trendmode>("HT_TRENDMODE"),
+        nb::arg("inReal").noconvert());
+  m.def("HT_ALL", timed<&ht_all>("HT_ALL"), nb::arg("inReal").noconvert(),
+        nb::arg("layout") = "tuple");
+  nb::class_<HTStream>(m, "HTStream",
+                       "HT_ALL one bar at a time on the Hilbert transform's "
+                       "state.")
+      .def(nb::init<>())
+      .def("update", &HTStream::update, nb::arg("value"),
+           "Add a bar; its eight HT_ALL outputs, NaN within their lookback.")
+      .def("extend", &HTStream::extend, nb::arg("values").noconvert(),
+           nb::arg("layout") = "tuple",
+           "Add bars; their outputs laid out as by HT_ALL.")
+      .def("reset", &HTStream::reset, "Drop the state.")
+      .def_prop_ro("bars", &HTStream::bars)
+      .def_prop_ro("lookback", &HTStream::lookback);
 
-  // --- Math Transforms ---
-  m.def("ACOS", &ta_acos, nb::arg("inReal").noconvert());
-  m.def("ASIN", &ta_asin, nb::arg("inReal").noconvert());
-  m.def("ATAN", &ta_atan, nb::arg("inReal").noconvert());
-  m.def("CEIL", &ta_ceil, nb::arg("inReal").noconvert());
-  m.def("COS", &ta_cos, nb::arg("inReal").noconvert());
-  m.def("COSH", &ta_cosh, nb::arg("inReal").noconvert());
-  m.def("EXP", &ta_exp, nb::arg("inReal").noconvert());
-  m.def("FLOOR", &ta_floor, nb::arg("inReal").noconvert());
-  m.def("LN", &ta_ln, nb::arg("inReal").noconvert());
-  m.def("LOG10", &ta_log10, nb::arg("inReal").noconvert());
-  m.def("SIN", &ta_sin, nb::arg("inReal").noconvert());
-  m.def("SINH", &ta_sinh, nb::arg("inReal").noconvert());
-  m.def("SQRT", &ta_sqrt, nb::arg("inReal").noconvert());
-  m.def("TAN", &ta_tan, nb::arg("inReal").noconvert());
-  m.def("TANH", &ta_tanh, nb::arg("inReal").noconvert());
+  // --- The function table (core/function_list.h) ---
+#define RAW_1(NAME, FUNC, GROUP, DEF)                                          \
+  m.def(#NAME, timed<&FUNC>(#NAME), nb::arg("inReal").noconvert(),            \
+        nb::arg("optInTimePeriod") = DEF);
+#define RAW_1_NP(NAME, FUNC, GROUP)                                            \
+  m.def(#NAME, timed<&FUNC>(#NAME), nb::arg("inReal").noconvert());
+#define RAW_HL(NAME, FUNC, GROUP, DEF)                                         \
+  m.def(#NAME, timed<&FUNC>(#NAME), nb::arg("inHigh").noconvert(),            \
+        nb::arg("inLow").noconvert(), nb::arg("optInTimePeriod") = DEF);
+#define RAW_HLC(NAME, FUNC, GROUP, DEF)                                        \
+  m.def(#NAME, timed<&FUNC>(#NAME), nb::arg("inHigh").noconvert(),            \
+        nb::arg("inLow").noconvert(), nb::arg("inClose").noconvert(),          \
+        nb::arg("optInTimePeriod") = DEF);
+#define RAW_DUAL(NAME, FUNC, GROUP, DEF)                                       \
+  m.def(#NAME, timed<&FUNC>(#NAME), nb::arg("inReal0").noconvert(),           \
+        nb::arg("inReal1").noconvert(), nb::arg("optInTimePeriod") = DEF);
+#define RAW_DUAL_NP(NAME, FUNC, GROUP, IN0, IN1)                               \
+  m.def(#NAME, timed<&FUNC>(#NAME), nb::arg(#IN0).noconvert(),                \
+        nb::arg(#IN1).noconvert());
+#define RAW_CDL(NAME, FUNC)                                                    \
+  m.def(#NAME, timed<&FUNC>(#NAME), nb::arg("inOpen").noconvert(),            \
+        nb::arg("inHigh").noconvert(), nb::arg("inLow").noconvert(),           \
+        nb::arg("inClose").noconvert());
+#define RAW_CDL_PEN(NAME, FUNC, DEF)                                           \
+  m.def(#NAME, timed<&FUNC>(#NAME), nb::arg("inOpen").noconvert(),            \
+        nb::arg("inHigh").noconvert(), nb::arg("inLow").noconvert(),           \
+        nb::arg("inClose").noconvert(), nb::arg("penetration") = DEF);
+  PYTAFAST_SINGLE(RAW_1)
+  PYTAFAST_SINGLE_NP(RAW_1_NP)
+  PYTAFAST_MATH(RAW_1_NP)
+  PYTAFAST_HL(RAW_HL)
+  PYTAFAST_HLC(RAW_HLC)
+  PYTAFAST_DUAL(RAW_DUAL)
+  PYTAFAST_DUAL_NP(RAW_DUAL_NP)
+  PYTAFAST_CDL(RAW_CDL)
+  PYTAFAST_CDL_PEN(RAW_CDL_PEN)
+#undef RAW_1
+#undef RAW_1_NP
+#undef RAW_HL
+#undef RAW_HLC
+#undef RAW_DUAL
+#undef RAW_DUAL_NP
+#undef RAW_CDL
+#undef RAW_CDL_PEN
 
-  // --- Statistics (MIN/MAX/SUM/MINMAX/MINMAXINDEX) ---
-  m.def("MAX", &ta_max, nb::arg("inReal").noconvert(),
-        nb::arg("optInTimePeriod") = 30);
-  m.def("MIN", &ta_min, nb::arg("inReal").noconvert(),
-        nb::arg("optInTimePeriod") = 30);
-  m.def("SUM", &ta_sum, nb::arg("inReal").noconvert(),
-        nb::arg("optInTimePeriod") = 30);
-  m.def("MINMAX", &minmax, nb::arg("inReal").noconvert(),
-        nb::arg("optInTimePeriod") = 30);
-  m.def("MINMAXINDEX", &minmaxindex, nb::arg("inReal").noconvert(),
-        nb::arg("optInTimePeriod") = 30);
+  // --- Candlestick patterns, bar by bar ---
+  nb::class_<StreamCDL>(m, "StreamCDL",
+                        "Candlestick pattern signals one bar at a time. "
+                        "Each update reruns every pattern over its "
+                        "lookback + 1 bars, kept in a ring.")
+      .def(nb::init<const std::vector<std::string> &, std::optional<double>>(),
+           nb::arg("patterns") = std::vector<std::string>(),
+           nb::arg("penetration") = nb::none())
+      .def("update", &StreamCDL::update, nb::arg("open"), nb::arg("high"),
+           nb::arg("low"), nb::arg("close"),
+           "Add a bar; its signal for each pattern, as int32.")
+      .def("extend", &StreamCDL::extend, nb::arg("open").noconvert(),
+           nb::arg("high").noconvert(), nb::arg("low").noconvert(),
+           nb::arg("close").noconvert(),
+           "Add bars; an int32 (bars, patterns) array of their signals.")
+      .def("reset", &StreamCDL::reset, "Drop every bar.")
+      .def_prop_ro("bars", &StreamCDL::bars)
+      .def_prop_ro("patterns", &StreamCDL::patterns);
 
-  // --- Cycle ---
-  m.def("HT_DCPERIOD", &ht_dcperiod, nb::arg("inReal").noconvert());
-  m.def("HT_DCPHASE", &ht_dcphase, nb::arg("inReal").noconvert());
-  m.def("HT_PHASOR", &ht_phasor, nb::arg("inReal").noconvert());
-  m.def("HT_SINE", &ht_sine, nb::arg("inReal").noconvert());
-  m.def("HT_TRENDLINE", &ht_trendline, nb::arg("inReal").noconvert());
-  m.def("HT_TRENDMODE", &ht_trendmode, nb::arg("inReal").noconvert());
+  // --- Public API (pytafast.<NAME>) ---
+  // Same kernels under the Python argument names, with numpy and pandas
+  // dispatch done here instead of in Python closures (see dispatch.h)
+  nb::module_ api =
+      m.def_submodule("api", "Public functions with pandas dispatch");
+#define API_SINGLE(NAME, FUNC, GROUP, DEF)                                     \
+  def_single<&FUNC>(api, #NAME, #NAME " indicator.", DEF);
+#define API_SINGLE_NP(NAME, FUNC, GROUP)                                       \
+  def_single_no_params<&FUNC>(api, #NAME, #NAME " indicator.");
+#define API_MATH(NAME, FUNC, GROUP)                                            \
+  def_single_no_params<&FUNC>(api, #NAME, "Vector " #NAME ".");
+#define API_HL(NAME, FUNC, GROUP, DEF)                                         \
+  def_hl<&FUNC>(api, #NAME, #NAME " indicator.", DEF);
+#define API_HLC(NAME, FUNC, GROUP, DEF)                                        \
+  def_hlc<&FUNC>(api, #NAME, #NAME " indicator.", DEF);
+#define API_DUAL(NAME, FUNC, GROUP, DEF)                                       \
+  def_dual<&FUNC>(api, #NAME, #NAME " indicator.", DEF);
+#define API_DUAL_NP(NAME, FUNC, GROUP, IN0, IN1)                               \
+  def_dual_no_params<&FUNC>(api, #NAME, #NAME " indicator.");
+#define API_CDL(NAME, FUNC)                                                    \
+  def_cdl<&FUNC>(api, #NAME, "Candlestick Pattern: " #NAME);
+#define API_CDL_PEN(NAME, FUNC, DEF)                                           \
+  def_cdl_pen<&FUNC>(api, #NAME, "Candlestick Pattern: " #NAME, DEF);
+  PYTAFAST_SINGLE(API_SINGLE)
+  PYTAFAST_SINGLE_NP(API_SINGLE_NP)
+  PYTAFAST_MATH(API_MATH)
+  PYTAFAST_HL(API_HL)
+  PYTAFAST_HLC(API_HLC)
+  PYTAFAST_DUAL(API_DUAL)
+  PYTAFAST_DUAL_NP(API_DUAL_NP)
+  PYTAFAST_CDL(API_CDL)
+  PYTAFAST_CDL_PEN(API_CDL_PEN)
+  // Same convention as the table's SINGLE_NP, with an integer output
+  def_single_no_params<&ht_trendmode>(api, "HT_TRENDMODE",
+                                      "HT_TRENDMODE indicator.");
+#undef API_SINGLE
+#undef API_SINGLE_NP
+#undef API_MATH
+#undef API_HL
+#undef API_HLC
+#undef API_DUAL
+#undef API_DUAL_NP
+#undef API_CDL
+#undef API_CDL_PEN
 
-  // --- Candlestick Patterns (standard OHLC) ---
-#define CDL_BIND(NAME, FUNC)                                                   \
-  m.def(#NAME, &FUNC, nb::arg("inOpen").noconvert(),                           \
-        nb::arg("inHigh").noconvert(), nb::arg("inLow").noconvert(),           \
-        nb::arg("inClose").noconvert())
-  CDL_BIND(CDL2CROWS, cdl2crows);
-  CDL_BIND(CDL3BLACKCROWS, cdl3blackcrows);
-  CDL_BIND(CDL3INSIDE, cdl3inside);
-  CDL_BIND(CDL3LINESTRIKE, cdl3linestrike);
-  CDL_BIND(CDL3OUTSIDE, cdl3outside);
-  CDL_BIND(CDL3STARSINSOUTH, cdl3starsinsouth);
-  CDL_BIND(CDL3WHITESOLDIERS, cdl3whitesoldiers);
-  CDL_BIND(CDLADVANCEBLOCK, cdladvanceblock);
-  CDL_BIND(CDLBELTHOLD, cdlbelthold);
-  CDL_BIND(CDLBREAKAWAY, cdlbreakaway);
-  CDL_BIND(CDLCLOSINGMARUBOZU, cdlclosingmarubozu);
-  CDL_BIND(CDLCONCEALBABYSWALL, cdlconcealbabyswall);
-  CDL_BIND(CDLCOUNTERATTACK, cdlcounterattack);
-  CDL_BIND(CDLDOJI, cdldoji);
-  CDL_BIND(CDLDOJISTAR, cdldojistar);
-  CDL_BIND(CDLDRAGONFLYDOJI, cdldragonflydoji);
-  CDL_BIND(CDLENGULFING, cdlengulfing);
-  CDL_BIND(CDLGAPSIDESIDEWHITE, cdlgapsidesidewhite);
-  CDL_BIND(CDLGRAVESTONEDOJI, cdlgravestonedoji);
-  CDL_BIND(CDLHAMMER, cdlhammer);
-  CDL_BIND(CDLHANGINGMAN, cdlhangingman);
-  CDL_BIND(CDLHARAMI, cdlharami);
-  CDL_BIND(CDLHARAMICROSS, cdlharamicross);
-  CDL_BIND(CDLHIGHWAVE, cdlhighwave);
-  CDL_BIND(CDLHIKKAKE, cdlhikkake);
-  CDL_BIND(CDLHIKKAKEMOD, cdlhikkakemod);
-  CDL_BIND(CDLHOMINGPIGEON, cdlhomingpigeon);
-  CDL_BIND(CDLIDENTICAL3CROWS, cdlidentical3crows);
-  CDL_BIND(CDLINNECK, cdlinneck);
-  CDL_BIND(CDLINVERTEDHAMMER, cdlinvertedhammer);
-  CDL_BIND(CDLKICKING, cdlkicking);
-  CDL_BIND(CDLKICKINGBYLENGTH, cdlkickingbylength);
-  CDL_BIND(CDLLADDERBOTTOM, cdlladderbottom);
-  CDL_BIND(CDLLONGLEGGEDDOJI, cdllongleggeddoji);
-  CDL_BIND(CDLLONGLINE, cdllongline);
-  CDL_BIND(CDLMARUBOZU, cdlmarubozu);
-  CDL_BIND(CDLMATCHINGLOW, cdlmatchinglow);
-  CDL_BIND(CDLONNECK, cdlonneck);
-  CDL_BIND(CDLPIERCING, cdlpiercing);
-  CDL_BIND(CDLRICKSHAWMAN, cdlrickshawman);
-  CDL_BIND(CDLRISEFALL3METHODS, cdlrisefall3methods);
-  CDL_BIND(CDLSEPARATINGLINES, cdlseparatinglines);
-  CDL_BIND(CDLSHOOTINGSTAR, cdlshootingstar);
-  CDL_BIND(CDLSHORTLINE, cdlshortline);
-  CDL_BIND(CDLSPINNINGTOP, cdlspinningtop);
-  CDL_BIND(CDLSTALLEDPATTERN, cdlstalledpattern);
-  CDL_BIND(CDLSTICKSANDWICH, cdlsticksandwich);
-  CDL_BIND(CDLTAKURI, cdltakuri);
-  CDL_BIND(CDLTASUKIGAP, cdltasukigap);
-  CDL_BIND(CDLTHRUSTING, cdlthrusting);
-  CDL_BIND(CDLTRISTAR, cdltristar);
-  CDL_BIND(CDLUNIQUE3RIVER, cdlunique3river);
-  CDL_BIND(CDLUPSIDEGAP2CROWS, cdlupsidegap2crows);
-  CDL_BIND(CDLXSIDEGAP3METHODS, cdlxsidegap3methods);
-#undef CDL_BIND
+  // --- Arrow / DLPack interop ---
+  m.def("as_float64", &to_double_array, nb::arg("obj"),
+        "Any 1-D input as a read-only float64 array, zero-copy when possible.");
+  nb::class_<ArrowResult>(m, "ArrowResult",
+                          "float64 result exported through the Arrow "
+                          "PyCapsule interface, lookback region as nulls.")
+      .def(nb::init<DoubleArrayIN>(), nb::arg("values").noconvert())
+      .def("__arrow_c_array__", &ArrowResult::arrow_c_array,
+           nb::arg("requested_schema") = nb::none())
+      .def("__len__", &ArrowResult::size)
+      .def_prop_ro("null_count", &ArrowResult::null_count)
+      .def_prop_ro("values", &ArrowResult::values);
 
-  // --- Candlestick Patterns (with penetration) ---
-#define CDL_BIND_PEN(NAME, FUNC, DEF)                                          \
-  m.def(#NAME, &FUNC, nb::arg("inOpen").noconvert(),                           \
-        nb::arg("inHigh").noconvert(), nb::arg("inLow").noconvert(),           \
-        nb::arg("inClose").noconvert(), nb::arg("penetration") = DEF)
-  CDL_BIND_PEN(CDLABANDONEDBABY, cdlabandonedbaby, 0.3);
-  CDL_BIND_PEN(CDLDARKCLOUDCOVER, cdldarkcloudcover, 0.5);
-  CDL_BIND_PEN(CDLEVENINGDOJISTAR, cdleveningdojistar, 0.3);
-  CDL_BIND_PEN(CDLEVENINGSTAR, cdleveningstar, 0.3);
-  CDL_BIND_PEN(CDLMATHOLD, cdlmathold, 0.5);
-  CDL_BIND_PEN(CDLMORNINGDOJISTAR, cdlmorningdojistar, 0.3);
-  CDL_BIND_PEN(CDLMORNINGSTAR, cdlmorningstar, 0.3);
-#undef CDL_BIND_PEN
+  // --- NaN gaps and result cache ---
+  m.def("run", &run_py, nb::arg("func"), nb::arg("inputs"),
+        nb::arg("nan_policy"), nb::arg("args"),
+        "Call func(*inputs, *args) on the valid bars of `inputs` under "
+        "nan_policy ('propagate', 'skip' or 'restart'), through the result "
+        "cache when it is enabled.");
+  m.def(
+      "cache_configure",
+      [](size_t max_bytes) { ResultCache::instance().configure(max_bytes); },
+      nb::arg("max_bytes"),
+      "Set the result cache budget in bytes; 0 disables it and drops every "
+      "entry.");
+  m.def("cache_enabled", &ResultCache::enabled);
+  m.def(
+      "cache_clear", [] { ResultCache::instance().clear(); },
+      "Drop every cached result and reset the counters.");
+  m.def(
+      "cache_info", [] { return ResultCache::instance().info(); },
+      "Result cache budget, usage and hit / tail-hit / miss counts.");
+
+  // --- Metadata ---
+  m.def("lookback", &lookback_py, nb::arg("name"), nb::arg("params"),
+        "Number of leading bars without output for `name` called with "
+        "`params` (TA-Lib lookback).");
+  m.def("function_info", &function_info_py, nb::arg("name"),
+        "Inputs, outputs, parameter defaults and output dtype of `name`.");
+  m.def("function_names", &function_names_py,
+        "Names of all functions in the metadata registry.");
+  m.def("compute_many", &compute_many_py, nb::arg("name"), nb::arg("inputs"),
+        nb::arg("params"), nb::arg("threads") = 0,
+        "`name` over every row of the 2-D `inputs`, rows spread over "
+        "`threads` threads (0: all cores) with the GIL released.");
+  m.def("load_plugin", &load_plugin_py, nb::arg("path"),
+        "Load a native plugin library and register its functions; returns "
+        "{name: kernel}, kernels called as kernel(*inputs, *params[, "
+        "layout]).");
 
-  m.def("initialize", &initialize);
-  m.def("shutdown", &shutdown);
+  // --- Instrumentation ---
+#ifdef PYTAFAST_STATS
+  m.attr("HAS_STATS") = nb::bool_(true);
+#else
+  m.attr("HAS_STATS") = nb::bool_(false);
+#endif
+  m.def("stats", &stats_py,
+        "Per-function counters since the last reset_stats() (PYTAFAST_STATS "
+        "builds only).");
+  m.def("reset_stats", &reset_stats_py, "Zero every counter.");
+  m.def("trace_start", &trace_start_py, nb::arg("sample_rate"),
+        nb::arg("buffer_events"),
+        "Start recording sampled calls into per-thread rings of "
+        "`buffer_events` events, dropping the previous trace.");
+  m.def("trace_stop", &trace_stop_py, "Stop recording; events stay readable.");
+  m.def("trace_enabled", &trace_enabled_py);
+  m.def("trace_events", &trace_events_py,
+        "Recorded events as (name, category, begin_ns, end_ns, thread id).");
+  m.def("trace_span", &trace_span_py, nb::arg("name"), nb::arg("cat"),
+        nb::arg("begin_ns"), nb::arg("end_ns"),
+        "Record a span measured with trace_now(), subject to sampling.");
+  m.def("trace_now", &trace_now, "The trace clock, in nanoseconds.");
 }
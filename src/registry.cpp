@@ -0,0 +1,63 @@
+#include "registry.h"
+
+namespace {
+
+nb::object param_value(const ParamInfo &param, double value) {
+  if (param.type == ParamType::Real) return nb::float_(value);
+  return nb::int_(static_cast<long long>(value));
+}
+
+} // namespace
+
+int lookback_py(const std::string &name, nb::kwargs params) {
+  const FunctionInfo &fn = find_function(name);
+  std::vector<double> values;
+  for (const auto &param : fn.params) values.push_back(param.default_value);
+
+  for (auto [key, value] : params) {
+    std::string param_name = nb::cast<std::string>(key);
+    size_t j = 0;
+    while (j < fn.params.size() && param_name != fn.params[j].name) ++j;
+    if (j == fn.params.size())
+      throw std::invalid_argument(std::string(fn.name) +
+                                  " has no parameter '" + param_name + "'");
+    // MAType members are enums; take their integer value
+    nb::object number = nb::borrow<nb::object>(value);
+    if (fn.params[j].type == ParamType::MAType && nb::hasattr(value, "value"))
+      number = value.attr("value");
+    values[j] = nb::cast<double>(number);
+  }
+  return fn.lookback(values.data());
+}
+
+nb::dict function_info_py(const std::string &name) {
+  const FunctionInfo &fn = find_function(name);
+  nb::list inputs, outputs;
+  for (const char *input : fn.inputs) inputs.append(nb::str(input));
+  for (const char *output : fn.outputs) outputs.append(nb::str(output));
+  nb::dict params;
+  std::vector<double> defaults;
+  for (const auto &param : fn.params) {
+    params[param.name] = param_value(param, param.default_value);
+    defaults.push_back(param.default_value);
+  }
+
+  nb::dict info;
+  info["name"] = nb::str(fn.name);
+  info["group"] = nb::str(fn.group);
+  info["inputs"] = inputs;
+  info["outputs"] = outputs;
+  info["output_dtype"] = nb::str(fn.integer_output ? "int32" : "float64");
+  info["parameters"] = params;
+  info["lookback"] = nb::int_(fn.lookback(defaults.data()));
+  info["windowed"] = nb::bool_(fn.windowed);
+  return info;
+}
+
+std::vector<std::string> function_names_py() {
+  std::vector<std::string> names;
+  for (const auto &fn : function_table()) names.emplace_back(fn.name);
+  for (const FunctionInfo *fn : pytafast::registered_functions())
+    names.emplace_back(fn->name);
+  return names;
+}
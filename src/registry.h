@@ -0,0 +1,16 @@
+#pragma once
+// Function metadata for Python: pytafast.lookback / function_info /
+// function_names over the pytafast_core function table
+// (include/pytafast/core.h, core/registry.cpp).
+#include "common.h"
+
+using pytafast::find_function;
+using pytafast::FunctionInfo;
+using pytafast::function_table;
+using pytafast::lookup_function;
+using pytafast::ParamInfo;
+using pytafast::ParamType;
+
+int lookback_py(const std::string &name, nb::kwargs params);
+nb::dict function_info_py(const std::string &name);
+std::vector<std::string> function_names_py();
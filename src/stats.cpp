@@ -0,0 +1,106 @@
+#include "stats.h"
+#include <nanobind/stl/string.h>
+#include <stdexcept>
+
+#ifdef PYTAFAST_STATS
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace {
+
+std::mutex registry_mutex;
+
+// Never shrinks, so references handed out stay valid
+std::map<std::string, std::unique_ptr<FunctionStats>> &registry() {
+  static auto *stats = new std::map<std::string, std::unique_ptr<FunctionStats>>();
+  return *stats;
+}
+
+thread_local CallRecord *current_call = nullptr;
+
+} // namespace
+
+FunctionStats &function_stats(const char *name) {
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  auto &slot = registry()[name];
+  if (!slot) slot = std::make_unique<FunctionStats>();
+  return *slot;
+}
+
+CallScope::CallScope(FunctionStats &stats)
+    : stats_(stats), outer_(current_call), start_(stats_now()) {
+  current_call = &record_;
+}
+
+CallScope::~CallScope() {
+  uint64_t total = stats_now() - start_;
+  current_call = outer_;
+  constexpr auto relaxed = std::memory_order_relaxed;
+  stats_.calls.fetch_add(1, relaxed);
+  stats_.total_ns.fetch_add(total, relaxed);
+  stats_.elements.fetch_add(record_.elements, relaxed);
+  stats_.compute_ns.fetch_add(record_.compute_ns, relaxed);
+  stats_.alloc_ns.fetch_add(record_.alloc_ns, relaxed);
+  stats_.bytes_allocated.fetch_add(record_.bytes, relaxed);
+  stats_.gil_released_ns.fetch_add(record_.gil_released_ns, relaxed);
+  stats_.gil_wait_ns.fetch_add(record_.gil_wait_ns, relaxed);
+  if (outer_) {
+    // A nested binding (e.g. run() calling pytafast_ext.MA) also counts
+    // towards its caller's compute, allocation and GIL time
+    outer_->elements += record_.elements;
+    outer_->compute_ns += record_.compute_ns;
+    outer_->alloc_ns += record_.alloc_ns;
+    outer_->bytes += record_.bytes;
+    outer_->gil_released_ns += record_.gil_released_ns;
+    outer_->gil_wait_ns += record_.gil_wait_ns;
+  }
+}
+
+CallRecord *CallScope::current() { return current_call; }
+
+nb::dict stats_py() {
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  nb::dict result;
+  for (const auto &[name, stats] : registry()) {
+    uint64_t calls = stats->calls.load();
+    if (!calls) continue;
+    nb::dict entry;
+    entry["calls"] = calls;
+    entry["elements"] = stats->elements.load();
+    entry["total_ns"] = stats->total_ns.load();
+    entry["compute_ns"] = stats->compute_ns.load();
+    entry["overhead_ns"] = stats->total_ns.load() - stats->compute_ns.load();
+    entry["alloc_ns"] = stats->alloc_ns.load();
+    entry["bytes_allocated"] = stats->bytes_allocated.load();
+    entry["gil_released_ns"] = stats->gil_released_ns.load();
+    entry["gil_wait_ns"] = stats->gil_wait_ns.load();
+    result[name.c_str()] = entry;
+  }
+  return result;
+}
+
+void reset_stats_py() {
+  std::lock_guard<std::mutex> lock(registry_mutex);
+  for (auto &[name, stats] : registry()) {
+    for (auto *counter :
+         {&stats->calls, &stats->elements, &stats->total_ns,
+          &stats->compute_ns, &stats->alloc_ns, &stats->bytes_allocated,
+          &stats->gil_released_ns, &stats->gil_wait_ns})
+      counter->store(0);
+  }
+}
+
+#else
+
+nb::dict stats_py() {
+  throw std::runtime_error(
+      "pytafast was built without PYTAFAST_STATS; rebuild with "
+      "-DPYTAFAST_STATS=ON for pytafast.stats()");
+}
+
+void reset_stats_py() {}
+
+#endif
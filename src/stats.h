@@ -0,0 +1,145 @@
+#pragma once
+// Per-function hot-path counters (pytafast.stats()).
+//
+// Compiled in only with -DPYTAFAST_STATS=ON; otherwise the counters cost
+// nothing and the scopes below only feed tracing (trace.h). When compiled
+// in, each call into a binding records:
+//   calls, elements (input bars), total_ns (time in the C++ binding),
+//   compute_ns (TA-Lib, GIL released), alloc_ns / bytes_allocated (output
+//   allocation and lookback fill), gil_released_ns (from releasing the GIL
+//   until holding it again) and gil_wait_ns (the reacquire part of that).
+// Time outside compute is total_ns - compute_ns; Python-wrapper time is
+// what a caller measures minus total_ns.
+#include "trace.h"
+#include <nanobind/nanobind.h>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace nb = nanobind;
+
+#ifdef PYTAFAST_STATS
+
+#include <atomic>
+
+struct FunctionStats {
+  std::atomic<uint64_t> calls{0}, elements{0}, total_ns{0}, compute_ns{0},
+      alloc_ns{0}, bytes_allocated{0}, gil_released_ns{0}, gil_wait_ns{0};
+};
+
+// Counters for `name`, created on first use; the reference stays valid
+FunctionStats &function_stats(const char *name);
+
+inline uint64_t stats_now() { return trace_now(); }
+
+// Accumulates one call on the calling thread; flushed to the function's
+// counters (one atomic add each) when the call returns
+struct CallRecord {
+  uint64_t elements = 0, compute_ns = 0, alloc_ns = 0, bytes = 0,
+           gil_released_ns = 0, gil_wait_ns = 0;
+};
+
+class CallScope {
+public:
+  explicit CallScope(FunctionStats &stats);
+  ~CallScope();
+
+  // The innermost call on this thread, null outside any binding
+  static CallRecord *current();
+
+private:
+  FunctionStats &stats_;
+  CallRecord record_;
+  CallRecord *outer_;
+  uint64_t start_;
+};
+
+// Output allocation of `bars` bars taking `bytes`
+class AllocScope {
+public:
+  AllocScope(size_t bars, size_t bytes)
+      : start_(stats_now()), bars_(bars), bytes_(bytes) {}
+  ~AllocScope() {
+    if (CallRecord *record = CallScope::current()) {
+      record->alloc_ns += stats_now() - start_;
+      record->elements += bars_;
+      record->bytes += bytes_;
+    }
+  }
+
+private:
+  uint64_t start_;
+  size_t bars_, bytes_;
+};
+
+// Attributes the rest of the enclosing block to `name` (a literal)
+#define PYTAFAST_CALL_SCOPE(name)                                              \
+  TraceScope pytafast_trace_scope_(name);                                      \
+  static FunctionStats &pytafast_stats_ = function_stats(name);                \
+  CallScope pytafast_call_scope_(pytafast_stats_)
+
+#else
+
+struct AllocScope {
+  AllocScope(size_t, size_t) {}
+};
+
+#define PYTAFAST_CALL_SCOPE(name) TraceScope pytafast_trace_scope_(name)
+
+#endif
+
+// Releases the GIL around a kernel (replaces nb::gil_scoped_release). Timed
+// when stats are compiled in or the call is being traced; otherwise just
+// the release
+class ComputeScope {
+public:
+  ComputeScope() {
+#ifdef PYTAFAST_STATS
+    timed_ = true;
+#else
+    timed_ = TraceScope::sampled();
+#endif
+    if (timed_) start_ = trace_now();
+    release_.emplace();
+    if (timed_) begin_ = trace_now();
+  }
+  ~ComputeScope() {
+    if (!timed_) return;
+    uint64_t end = trace_now();
+    release_.reset();
+    uint64_t held = trace_now();
+#ifdef PYTAFAST_STATS
+    if (CallRecord *record = CallScope::current()) {
+      record->compute_ns += end - begin_;
+      record->gil_released_ns += held - start_;
+      record->gil_wait_ns += held - end;
+    }
+#endif
+    if (TraceScope::sampled()) {
+      TraceScope::span("compute", "compute", begin_, end);
+      TraceScope::span("gil_wait", "gil", end, held);
+    }
+  }
+
+private:
+  bool timed_;
+  uint64_t start_ = 0, begin_ = 0;
+  std::optional<nb::gil_scoped_release> release_;
+};
+
+// `Fn` with its calls attributed to `name`: the raw pytafast_ext.<NAME>
+// bindings register timed<&fn>("NAME") instead of &fn
+template <auto Fn, typename R, typename... A>
+auto timed_impl(R (*)(A...), const char *name) {
+  return [name](A... args) -> R {
+    PYTAFAST_CALL_SCOPE(name);
+    return Fn(std::forward<A>(args)...);
+  };
+}
+template <auto Fn> auto timed(const char *name) {
+  return timed_impl<Fn>(Fn, name);
+}
+
+// pytafast.stats() / reset_stats(); stats_py raises when compiled out
+nb::dict stats_py();
+void reset_stats_py();
@@ -0,0 +1,66 @@
+#include "stream.h"
+#include "kernel.h"
+
+nb::tuple HTStream::update(double value) {
+  double out[pytafast::HilbertStream::kOutputs];
+  stream_.update(value, out);
+  nb::list values;
+  for (double v : out) values.append(nb::float_(v));
+  return nb::tuple(values);
+}
+
+nb::object HTStream::extend(DoubleArrayIN values, const std::string &layout) {
+  const size_t size = values.shape(0);
+  constexpr size_t k = pytafast::HilbertStream::kOutputs;
+  // update() writes the NaNs of the lookback itself
+  MultiOutput out(size, std::vector<int>(k, 0), parse_layout(layout));
+  double *rows[k];
+  for (size_t j = 0; j < k; ++j) rows[j] = out.row(j);
+  // The GIL stays held: it is what serializes calls on one stream
+  const double *data = values.data();
+  double bar[k];
+  for (size_t i = 0; i < size; ++i) {
+    stream_.update(data[i], bar);
+    for (size_t j = 0; j < k; ++j) rows[j][i] = bar[j];
+  }
+  return out.result();
+}
+
+static pytafast::CandleStream
+make_candle_stream(const std::vector<std::string> &patterns,
+                   std::optional<double> penetration) {
+  if (penetration) return pytafast::CandleStream(patterns, *penetration);
+  return pytafast::CandleStream(patterns);
+}
+
+StreamCDL::StreamCDL(const std::vector<std::string> &patterns,
+                     std::optional<double> penetration)
+    : stream_(make_candle_stream(patterns, penetration)) {}
+
+IntArrayOUT StreamCDL::update(double open, double high, double low,
+                              double close) {
+  const size_t k = stream_.patterns().size();
+  auto [data, owner] = alloc_output<int>(k, 0);
+  stream_.update(open, high, low, close, {data, k});
+  return IntArrayOUT(data, {k}, owner);
+}
+
+nb::object StreamCDL::extend(DoubleArrayIN open, DoubleArrayIN high,
+                             DoubleArrayIN low, DoubleArrayIN close) {
+  const size_t size = input_length(open, high, low, close);
+  const size_t k = stream_.patterns().size();
+  auto [data, owner] = alloc_output<int>(size * k, 0);
+  // The GIL stays held, as in HTStream::extend
+  for (size_t i = 0; i < size; ++i)
+    stream_.update(open.data()[i], high.data()[i], low.data()[i],
+                   close.data()[i], {data + i * k, k});
+  return nb::cast(
+      nb::ndarray<nb::numpy, int, nb::ndim<2>>(data, {size, k}, owner));
+}
+
+std::vector<std::string> StreamCDL::patterns() const {
+  std::vector<std::string> names;
+  for (const pytafast::FunctionInfo *fn : stream_.patterns())
+    names.emplace_back(fn->name);
+  return names;
+}
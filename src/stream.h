@@ -0,0 +1,46 @@
+#pragma once
+// Stateful indicators fed one bar at a time, for pytafast.HTStream and
+// pytafast.StreamCDL: they keep their state between calls instead of
+// recomputing over the history.
+#include "common.h"
+#include <nanobind/stl/optional.h>
+#include <optional>
+
+// HT_ALL bar by bar (pytafast::HilbertStream)
+class HTStream {
+public:
+  // The eight HT_ALL outputs of a new bar, NaN within their lookback
+  nb::tuple update(double value);
+  // update() over each value in turn; the outputs of every bar, laid out
+  // as by HT_ALL
+  nb::object extend(DoubleArrayIN values, const std::string &layout);
+
+  void reset() { stream_.reset(); }
+  size_t bars() const { return stream_.bars(); }
+  int lookback() const { return stream_.lookback(); }
+
+private:
+  pytafast::HilbertStream stream_;
+};
+
+// Candlestick patterns bar by bar (pytafast::CandleStream): each update
+// reruns every pattern over its lookback + 1 bars
+class StreamCDL {
+public:
+  // Every pattern when `patterns` is empty
+  StreamCDL(const std::vector<std::string> &patterns,
+            std::optional<double> penetration);
+
+  // The signals of a new bar, one per pattern (int32)
+  IntArrayOUT update(double open, double high, double low, double close);
+  // update() over each bar in turn; an int32 (bars, patterns) array
+  nb::object extend(DoubleArrayIN open, DoubleArrayIN high, DoubleArrayIN low,
+                    DoubleArrayIN close);
+
+  void reset() { stream_.reset(); }
+  size_t bars() const { return stream_.bars(); }
+  std::vector<std::string> patterns() const;
+
+private:
+  pytafast::CandleStream stream_;
+};
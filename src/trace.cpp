@@ -0,0 +1,188 @@
+#include "trace.h"
+#include <nanobind/stl/string.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+
+// Slots are atomics so that a dump reading a slot the owner is overwriting
+// is a detectable stale read rather than a data race
+struct TraceSlot {
+  std::atomic<const char *> name{nullptr}, cat{nullptr};
+  std::atomic<uint64_t> begin_ns{0}, end_ns{0};
+};
+
+struct TraceRing {
+  TraceRing(size_t capacity, uint64_t generation)
+      : slots(new TraceSlot[capacity]), capacity(capacity),
+        generation(generation), tid(PyThread_get_thread_native_id()) {}
+
+  // Owner thread only
+  void push(const char *name, const char *cat, uint64_t begin_ns,
+            uint64_t end_ns) {
+    constexpr auto relaxed = std::memory_order_relaxed;
+    uint64_t h = head.load(relaxed);
+    // Orders the previous head store before the slot stores below: a dump
+    // that sees any of them also sees head >= h and drops the old event
+    std::atomic_thread_fence(std::memory_order_release);
+    TraceSlot &slot = slots[h % capacity];
+    slot.name.store(name, relaxed);
+    slot.cat.store(cat, relaxed);
+    slot.begin_ns.store(begin_ns, relaxed);
+    slot.end_ns.store(end_ns, relaxed);
+    head.store(h + 1, std::memory_order_release);
+  }
+
+  std::unique_ptr<TraceSlot[]> slots;
+  size_t capacity;
+  uint64_t generation;
+  unsigned long tid;
+  std::atomic<uint64_t> head{0};
+};
+
+struct TraceConfig {
+  std::mutex mutex;
+  // Rings of the current trace, including those of threads that have exited
+  std::vector<std::shared_ptr<TraceRing>> rings;
+  size_t capacity = 0;
+  std::atomic<uint64_t> generation{0};
+  std::atomic<uint32_t> sample_every{1};
+  // Names of spans recorded from Python; never shrinks
+  std::unordered_set<std::string> names;
+};
+
+TraceConfig &config() {
+  static auto *config = new TraceConfig();
+  return *config;
+}
+
+thread_local std::shared_ptr<TraceRing> ring;
+thread_local uint32_t sample_tick = 0;
+thread_local bool keep_next = false;
+
+TraceRing &thread_ring() {
+  auto &cfg = config();
+  uint64_t generation = cfg.generation.load(std::memory_order_acquire);
+  if (!ring || ring->generation != generation) {
+    std::lock_guard<std::mutex> lock(cfg.mutex);
+    ring = std::make_shared<TraceRing>(cfg.capacity, cfg.generation.load());
+    cfg.rings.push_back(ring);
+  }
+  return *ring;
+}
+
+// One in every sample_every calls on each thread, counted per thread
+bool take_sample() {
+  if (keep_next) {
+    keep_next = false;
+    return true;
+  }
+  if (++sample_tick < config().sample_every.load(std::memory_order_relaxed))
+    return false;
+  sample_tick = 0;
+  return true;
+}
+
+} // namespace
+
+std::atomic<bool> TraceScope::enabled_{false};
+thread_local TraceScope *TraceScope::current_ = nullptr;
+
+void TraceScope::begin(const char *name) {
+  // Calls nested in a recorded call are recorded with it
+  if (!current_ && !take_sample()) return;
+  thread_ring();
+  name_ = name;
+  outer_ = current_;
+  current_ = this;
+  begin_ns_ = trace_now();
+}
+
+void TraceScope::end() {
+  uint64_t end_ns = trace_now();
+  current_ = outer_;
+  if (ring) ring->push(name_, "call", begin_ns_, end_ns);
+}
+
+void TraceScope::span(const char *name, const char *cat, uint64_t begin_ns,
+                      uint64_t end_ns) {
+  if (current_ && ring) ring->push(name, cat, begin_ns, end_ns);
+}
+
+void trace_start_py(double sample_rate, size_t buffer_events) {
+  if (!(sample_rate > 0.0 && sample_rate <= 1.0))
+    throw std::invalid_argument("sample_rate must be in (0, 1]");
+  if (buffer_events == 0)
+    throw std::invalid_argument("buffer_events must be positive");
+  auto &cfg = config();
+  std::lock_guard<std::mutex> lock(cfg.mutex);
+  cfg.rings.clear();
+  cfg.capacity = buffer_events;
+  cfg.sample_every.store((uint32_t)std::lround(1.0 / sample_rate));
+  cfg.generation.fetch_add(1, std::memory_order_release);
+  TraceScope::enabled_.store(true);
+}
+
+void trace_stop_py() { TraceScope::enabled_.store(false); }
+
+bool trace_enabled_py() { return TraceScope::enabled(); }
+
+nb::list trace_events_py() {
+  struct Event {
+    const char *name, *cat;
+    uint64_t begin_ns, end_ns;
+  };
+  std::vector<std::pair<unsigned long, std::vector<Event>>> snapshots;
+  {
+    auto &cfg = config();
+    std::lock_guard<std::mutex> lock(cfg.mutex);
+    constexpr auto relaxed = std::memory_order_relaxed;
+    for (const auto &r : cfg.rings) {
+      uint64_t head = r->head.load(std::memory_order_acquire);
+      uint64_t first = head > r->capacity ? head - r->capacity : 0;
+      std::vector<Event> events;
+      events.reserve(head - first);
+      for (uint64_t i = first; i < head; ++i) {
+        const TraceSlot &slot = r->slots[i % r->capacity];
+        events.push_back({slot.name.load(relaxed), slot.cat.load(relaxed),
+                          slot.begin_ns.load(relaxed),
+                          slot.end_ns.load(relaxed)});
+      }
+      // Drop whatever the owner may have overwritten while we copied,
+      // including the slot it may be writing now
+      std::atomic_thread_fence(std::memory_order_acquire);
+      uint64_t now = r->head.load(relaxed);
+      if (now + 1 > first + r->capacity) {
+        size_t stale = std::min<uint64_t>(now + 1 - r->capacity - first,
+                                          events.size());
+        events.erase(events.begin(), events.begin() + stale);
+      }
+      snapshots.emplace_back(r->tid, std::move(events));
+    }
+  }
+  nb::list result;
+  for (const auto &[tid, events] : snapshots)
+    for (const Event &e : events)
+      result.append(nb::make_tuple(e.name, e.cat, e.begin_ns, e.end_ns, tid));
+  return result;
+}
+
+void trace_span_py(const std::string &name, const std::string &cat,
+                   uint64_t begin_ns, uint64_t end_ns) {
+  if (!TraceScope::enabled() || !take_sample())
+    return;
+  const char *name_ptr, *cat_ptr;
+  {
+    auto &cfg = config();
+    std::lock_guard<std::mutex> lock(cfg.mutex);
+    name_ptr = cfg.names.insert(name).first->c_str();
+    cat_ptr = cfg.names.insert(cat).first->c_str();
+  }
+  thread_ring().push(name_ptr, cat_ptr, begin_ns, end_ns);
+  keep_next = true;
+}
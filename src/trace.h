@@ -0,0 +1,70 @@
+#pragma once
+// Chrome / Perfetto trace recording (pytafast.start_trace / dump_trace).
+//
+// While tracing, a sampled call into a binding records one complete event,
+// with "compute" (TA-Lib, GIL released) and "gil_wait" (reacquiring the GIL
+// afterwards) spans inside it. Events go to a fixed-size ring per thread:
+// the owning thread is the only writer and publishes each event with one
+// release store, so recording takes no lock and never waits for a dump; a
+// full ring overwrites its oldest events. With tracing off a call pays one
+// relaxed load.
+#include <nanobind/nanobind.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace nb = nanobind;
+
+inline uint64_t trace_now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+class TraceScope {
+public:
+  // `name` must outlive the process (a literal or an interned name)
+  explicit TraceScope(const char *name) {
+    if (enabled_.load(std::memory_order_relaxed)) begin(name);
+  }
+  ~TraceScope() {
+    if (name_) end();
+  }
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+
+  // Whether the innermost binding call on this thread is being recorded
+  static bool sampled() { return current_ != nullptr; }
+  // A span of category `cat` inside the current sampled call
+  static void span(const char *name, const char *cat, uint64_t begin_ns,
+                   uint64_t end_ns);
+
+  static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+
+private:
+  friend void trace_start_py(double, size_t);
+  friend void trace_stop_py();
+
+  void begin(const char *name);
+  void end();
+
+  const char *name_ = nullptr;
+  TraceScope *outer_ = nullptr;
+  uint64_t begin_ns_ = 0;
+
+  static std::atomic<bool> enabled_;
+  static thread_local TraceScope *current_;
+};
+
+// pytafast.start_trace / stop_trace; events stay readable until the next
+// start
+void trace_start_py(double sample_rate, size_t buffer_events);
+void trace_stop_py();
+bool trace_enabled_py();
+// Recorded events as (name, category, begin_ns, end_ns, native thread id)
+nb::list trace_events_py();
+// A span measured in Python (e.g. an async call's queue wait), subject to
+// sampling; when kept, the next binding call on this thread is kept too
+void trace_span_py(const std::string &name, const std::string &cat,
+                   uint64_t begin_ns, uint64_t end_ns);
@@ -292,6 +292,24 @@ def test_benchmark_talib_typprice_numpy(benchmark):
     benchmark.group = "TYPPRICE"
     benchmark(talib.TYPPRICE, _high, _low, _close)
 
+# --- PRICE_ALL: the five OHLC-derived series, fused vs one call each ---
+def _price_separately(lib):
+    return (lib.AVGPRICE(_open, _high, _low, _close), lib.MEDPRICE(_high, _low),
+            lib.TYPPRICE(_high, _low, _close), lib.WCLPRICE(_high, _low, _close),
+            lib.TRANGE(_high, _low, _close))
+
+def test_benchmark_pytafast_price_all_numpy(benchmark):
+    benchmark.group = "PRICE_ALL"
+    benchmark(pytafast.PRICE_ALL, _open, _high, _low, _close)
+
+def test_benchmark_pytafast_price_separate_numpy(benchmark):
+    benchmark.group = "PRICE_ALL"
+    benchmark(_price_separately, pytafast)
+
+def test_benchmark_talib_price_separate_numpy(benchmark):
+    benchmark.group = "PRICE_ALL"
+    benchmark(_price_separately, talib)
+
 
 # ======================== Statistics =======================================
 
@@ -400,6 +418,23 @@ def test_benchmark_talib_ht_trendline_numpy(benchmark):
     benchmark.group = "HT_TRENDLINE"
     benchmark(talib.HT_TRENDLINE, _close)
 
+# --- HT_ALL: the eight Hilbert transform series, fused vs one call each ---
+def _ht_separately(lib):
+    return (lib.HT_DCPERIOD(_close), lib.HT_DCPHASE(_close), lib.HT_PHASOR(_close),
+            lib.HT_SINE(_close), lib.HT_TRENDLINE(_close), lib.HT_TRENDMODE(_close))
+
+def test_benchmark_pytafast_ht_all_numpy(benchmark):
+    benchmark.group = "HT_ALL"
+    benchmark(pytafast.HT_ALL, _close)
+
+def test_benchmark_pytafast_ht_separate_numpy(benchmark):
+    benchmark.group = "HT_ALL"
+    benchmark(_ht_separately, pytafast)
+
+def test_benchmark_talib_ht_separate_numpy(benchmark):
+    benchmark.group = "HT_ALL"
+    benchmark(_ht_separately, talib)
+
 
 # ======================== Candlestick Patterns =============================
 
@@ -429,3 +464,26 @@ def test_benchmark_pytafast_cdl3whitesoldiers_numpy(benchmark):
 def test_benchmark_talib_cdl3whitesoldiers_numpy(benchmark):
     benchmark.group = "CDL3WHITESOLDIERS"
     benchmark(talib.CDL3WHITESOLDIERS, _open, _high, _low, _close)
+
+# --- StreamCDL: the newest bar's signal for all 61 patterns, one update vs
+# recomputing each pattern over a 1,000-bar history ---
+_HISTORY = 1_000
+_cdl_stream = pytafast.StreamCDL()
+_cdl_stream.extend(_open[:_HISTORY], _high[:_HISTORY], _low[:_HISTORY], _close[:_HISTORY])
+_cdl_names = _cdl_stream.patterns
+
+def _cdl_recompute(lib):
+    bars = (_open[:_HISTORY], _high[:_HISTORY], _low[:_HISTORY], _close[:_HISTORY])
+    return [getattr(lib, name)(*bars)[-1] for name in _cdl_names]
+
+def test_benchmark_pytafast_stream_cdl_update(benchmark):
+    benchmark.group = "STREAM_CDL"
+    benchmark(_cdl_stream.update, _open[0], _high[0], _low[0], _close[0])
+
+def test_benchmark_pytafast_cdl_recompute_numpy(benchmark):
+    benchmark.group = "STREAM_CDL"
+    benchmark(_cdl_recompute, pytafast)
+
+def test_benchmark_talib_cdl_recompute_numpy(benchmark):
+    benchmark.group = "STREAM_CDL"
+    benchmark(_cdl_recompute, talib)
@@ -0,0 +1,156 @@
+"""
+Thread scaling: throughput and latency against worker count.
+
+Each case runs a fixed batch of calls to one indicator at one size, spread
+over `workers` threads, and reports the batch time (pytest-benchmark) plus
+throughput and p50 / p99 per-call latency in extra_info. The sweep crosses:
+
+- mode: "threads" (sync calls from a thread pool, each thread looping over
+  its share), "aio" (pytafast.aio tasks on an executor of `workers` threads;
+  latency includes the executor queue) and "engine" (SharedMemoryEngine
+  with `workers` processes over one 2-D batch; no per-call latency);
+- indicator: ADD (a few ns per bar, so GIL hand-offs dominate) and HT_SINE
+  (tens of ns per bar);
+- size: bars per call.
+
+Throughput that stops growing with workers marks where GIL hand-offs or the
+executor saturate.
+
+Run with:
+    uv run pytest tests/test_benchmark_concurrency.py --benchmark-columns=min,median \\
+        --benchmark-json=.benchmarks/concurrency.json
+"""
+
+import asyncio
+import multiprocessing
+import os
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+import pytest
+import numpy as np
+import pytafast
+from pytafast.parallel import SharedMemoryEngine
+
+pytest.importorskip("pytest_benchmark")
+
+WORKERS = [w for w in (1, 2, 4, 8, 16) if w <= (os.cpu_count() or 1)]
+SIZES = [100, 10_000, 1_000_000]
+INDICATORS = {
+    "ADD": lambda x: pytafast.ADD(x, x),
+    "HT_SINE": lambda x: pytafast.HT_SINE(x),
+}
+AIO = {
+    "ADD": lambda x: pytafast.aio.ADD(x, x),
+    "HT_SINE": lambda x: pytafast.aio.HT_SINE(x),
+}
+
+np.random.seed(42)
+_close = {n: np.random.random(n) * 100 + 50 for n in SIZES}
+
+
+def _calls(n):
+    # About 2M bars per batch, between 16 and 2048 calls
+    return min(2048, max(16, 2_000_000 // n))
+
+
+def _record(benchmark, latencies_ns, calls):
+    if benchmark.stats is None:  # --benchmark-disable
+        return
+    latencies = np.asarray(latencies_ns, dtype=np.float64)
+    batch_s = benchmark.stats.stats.min
+    benchmark.extra_info["calls_per_s"] = round(calls / batch_s)
+    if latencies.size:
+        benchmark.extra_info["p50_us"] = round(np.percentile(latencies, 50) / 1e3, 2)
+        benchmark.extra_info["p99_us"] = round(np.percentile(latencies, 99) / 1e3, 2)
+
+
+@pytest.fixture(scope="module")
+def thread_pools():
+    pools = {w: ThreadPoolExecutor(w) for w in WORKERS}
+    yield pools
+    for pool in pools.values():
+        pool.shutdown()
+
+
+@pytest.fixture(scope="module")
+def engines():
+    context = multiprocessing.get_context("fork" if os.name == "posix" else "spawn")
+    engines = {}
+
+    def get(workers):
+        if workers not in engines:
+            engines[workers] = SharedMemoryEngine(workers, mp_context=context)
+        return engines[workers]
+
+    yield get
+    for engine in engines.values():
+        engine.close()
+
+
+@pytest.mark.parametrize("n", SIZES)
+@pytest.mark.parametrize("name", INDICATORS)
+@pytest.mark.parametrize("workers", WORKERS)
+def test_scaling_threads(benchmark, thread_pools, workers, name, n):
+    benchmark.group = f"{name} n={n}"
+    fn, x, calls = INDICATORS[name], _close[n], _calls(n)
+    latencies = []
+
+    def share(count):
+        out = []
+        for _ in range(count):
+            start = time.perf_counter_ns()
+            fn(x)
+            out.append(time.perf_counter_ns() - start)
+        return out
+
+    def batch():
+        shares = [calls // workers + (i < calls % workers) for i in range(workers)]
+        latencies[:] = [t for ts in thread_pools[workers].map(share, shares) for t in ts]
+
+    benchmark.pedantic(batch, rounds=5, warmup_rounds=1)
+    _record(benchmark, latencies, calls)
+
+
+@pytest.mark.parametrize("n", SIZES)
+@pytest.mark.parametrize("name", AIO)
+@pytest.mark.parametrize("workers", WORKERS)
+def test_scaling_aio(benchmark, workers, name, n):
+    benchmark.group = f"{name} n={n}"
+    fn, x, calls = AIO[name], _close[n], _calls(n)
+    latencies = []
+
+    async def timed():
+        start = time.perf_counter_ns()
+        await fn(x)
+        latencies.append(time.perf_counter_ns() - start)
+
+    async def gather():
+        await asyncio.gather(*(timed() for _ in range(calls)))
+
+    loop = asyncio.new_event_loop()
+    executor = ThreadPoolExecutor(workers)
+    loop.set_default_executor(executor)
+    try:
+        def batch():
+            latencies.clear()
+            loop.run_until_complete(gather())
+
+        benchmark.pedantic(batch, rounds=5, warmup_rounds=1)
+    finally:
+        loop.close()
+        executor.shutdown()
+    _record(benchmark, latencies, calls)
+
+
+@pytest.mark.parametrize("n", SIZES)
+@pytest.mark.parametrize("name", INDICATORS)
+@pytest.mark.parametrize("workers", WORKERS)
+def test_scaling_engine(benchmark, engines, workers, name, n):
+    benchmark.group = f"{name} n={n}"
+    engine, calls = engines(workers), _calls(n)
+    inputs = engine.empty((calls, n))
+    inputs[:] = _close[n]
+    args = (inputs, inputs) if name == "ADD" else (inputs,)
+    benchmark.pedantic(engine.run, args=(name, *args), rounds=5, warmup_rounds=1)
+    _record(benchmark, [], calls)
@@ -0,0 +1,54 @@
+"""
+Cold-start cost of ``import pytafast``, measured in fresh interpreters.
+
+Each round starts a new Python, imports numpy (every caller pays for it
+anyway) and times ``import pytafast``: the extension module, the Python
+layer and anything they pull in. pandas, asyncio and the per-function
+wrappers are not part of it - they load on first use. For a breakdown by
+module, run ``python -X importtime -c "import pytafast"``.
+
+The fastest round must fit the budget, 50 ms by default or
+PYTAFAST_IMPORT_BUDGET_MS.
+
+Run with:
+    uv run pytest tests/test_benchmark_import.py --benchmark-columns=min,median
+"""
+
+import os
+import subprocess
+import sys
+
+import pytest
+
+pytest.importorskip("pytest_benchmark")
+
+ROUNDS = 10
+BUDGET_MS = float(os.environ.get("PYTAFAST_IMPORT_BUDGET_MS", 50))
+
+
+def _import_us(statement="import pytafast"):
+    """Time ``statement`` takes in a new interpreter, numpy preloaded (us)."""
+    code = ("import time, numpy; t = time.perf_counter(); "
+            f"{statement}; print((time.perf_counter() - t) * 1e6)")
+    proc = subprocess.run([sys.executable, "-c", code],
+                          capture_output=True, text=True, check=True)
+    return float(proc.stdout)
+
+
+def test_import_time(benchmark):
+    times = []
+    benchmark.pedantic(lambda: times.append(_import_us()),
+                       rounds=ROUNDS, iterations=1)
+    best_ms = min(times) / 1000
+    benchmark.extra_info["import_ms"] = best_ms
+    benchmark.extra_info["budget_ms"] = BUDGET_MS
+    assert best_ms <= BUDGET_MS, (
+        f"import pytafast took {best_ms:.1f} ms, budget {BUDGET_MS:.0f} ms")
+
+
+def test_import_time_first_call(benchmark):
+    # Import plus the first table function and the first aio wrapper: what
+    # a short-lived worker pays before its first result
+    benchmark.pedantic(
+        _import_us, args=("import pytafast; pytafast.SMA; pytafast.aio.SMA",),
+        rounds=ROUNDS, iterations=1)
@@ -0,0 +1,72 @@
+"""
+Per-call overhead at small sizes, where binding cost rather than TA-Lib
+dominates.
+
+The public functions are compared against the raw extension entry points
+(pytafast.pytafast_ext.<NAME>), which do no pandas or dtype handling. With
+the C++ dispatch in pytafast_ext.api the numpy numbers should be within
+noise of each other.
+
+Run with:
+    uv run pytest tests/test_benchmark_overhead.py --benchmark-columns=min,median,ops
+"""
+
+import pytest
+import numpy as np
+import pandas as pd
+import pytafast
+
+pytest.importorskip("pytest_benchmark")
+
+ext = pytafast.pytafast_ext
+
+np.random.seed(42)
+SIZES = [50, 500]
+_data = {}
+for _n in SIZES:
+    _close = np.random.random(_n) * 100 + 50
+    _data[_n] = {
+        "close": _close,
+        "high": _close + np.random.random(_n) * 5,
+        "low": _close - np.random.random(_n) * 5,
+        "close_s": pd.Series(_close),
+    }
+
+
+@pytest.mark.parametrize("n", SIZES)
+def test_overhead_sma_ext(benchmark, n):
+    benchmark.group = f"SMA n={n}"
+    benchmark(ext.SMA, _data[n]["close"], 14)
+
+
+@pytest.mark.parametrize("n", SIZES)
+def test_overhead_sma_numpy(benchmark, n):
+    benchmark.group = f"SMA n={n}"
+    benchmark(pytafast.SMA, _data[n]["close"], timeperiod=14)
+
+
+@pytest.mark.parametrize("n", SIZES)
+def test_overhead_sma_pandas(benchmark, n):
+    benchmark.group = f"SMA n={n}"
+    benchmark(pytafast.SMA, _data[n]["close_s"], timeperiod=14)
+
+
+@pytest.mark.parametrize("n", SIZES)
+def test_overhead_atr_ext(benchmark, n):
+    benchmark.group = f"ATR n={n}"
+    d = _data[n]
+    benchmark(ext.ATR, d["high"], d["low"], d["close"], 14)
+
+
+@pytest.mark.parametrize("n", SIZES)
+def test_overhead_atr_numpy(benchmark, n):
+    benchmark.group = f"ATR n={n}"
+    d = _data[n]
+    benchmark(pytafast.ATR, d["high"], d["low"], d["close"], timeperiod=14)
+
+
+@pytest.mark.parametrize("n", SIZES)
+def test_overhead_cdl_numpy(benchmark, n):
+    benchmark.group = f"CDLENGULFING n={n}"
+    d = _data[n]
+    benchmark(pytafast.CDLENGULFING, d["close"], d["high"], d["low"], d["close"])
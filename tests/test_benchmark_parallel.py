@@ -0,0 +1,94 @@
+"""
+Many-series backfill across processes: pickling vs shared memory, and
+threads in this process.
+
+The pickling baseline is the usual ProcessPoolExecutor pattern - each
+worker gets its rows pickled in and pickles its results back.
+SharedMemoryEngine runs the same shards with inputs and outputs in shared
+memory. Both use the same pool size and sharding, so the difference is the
+data exchange. ThreadEngine runs the rows on as many threads in one call,
+with no data exchange at all.
+
+Run with:
+    uv run pytest tests/test_benchmark_parallel.py --benchmark-columns=min,median,ops
+"""
+
+import math
+import multiprocessing
+import os
+from concurrent.futures import ProcessPoolExecutor
+
+import pytest
+import numpy as np
+import pytafast
+from pytafast.parallel import SharedMemoryEngine, ThreadEngine
+
+pytest.importorskip("pytest_benchmark")
+
+WORKERS = min(os.cpu_count() or 1, 8)
+SERIES = 256
+BARS = 20_000
+
+np.random.seed(42)
+_close = np.random.random((SERIES, BARS)) * 100 + 50
+
+
+def _pickled_shard(name, rows, kwargs):
+    fn = getattr(pytafast, name)
+    return np.stack([fn(row, **kwargs) for row in rows])
+
+
+def _pickled_run(pool, name, data, **kwargs):
+    step = math.ceil(len(data) / WORKERS)
+    futures = [pool.submit(_pickled_shard, name, data[i:i + step], kwargs)
+               for i in range(0, len(data), step)]
+    return np.concatenate([f.result() for f in futures])
+
+
+@pytest.fixture(scope="module")
+def context():
+    return multiprocessing.get_context("fork" if os.name == "posix" else "spawn")
+
+
+@pytest.fixture(scope="module")
+def pickle_pool(context):
+    with ProcessPoolExecutor(WORKERS, mp_context=context) as pool:
+        pool.submit(int).result()  # start the workers outside the timing
+        yield pool
+
+
+@pytest.fixture(scope="module")
+def engine(context):
+    with SharedMemoryEngine(WORKERS, mp_context=context) as engine:
+        engine._pool.submit(int).result()
+        yield engine
+
+
+@pytest.mark.parametrize("name", ["SMA", "RSI"])
+def test_parallel_pickle(benchmark, pickle_pool, name):
+    benchmark.group = f"{name} {SERIES}x{BARS}"
+    out = benchmark(_pickled_run, pickle_pool, name, _close, timeperiod=14)
+    assert out.shape == _close.shape
+
+
+@pytest.mark.parametrize("name", ["SMA", "RSI"])
+def test_parallel_shared_memory(benchmark, engine, name):
+    benchmark.group = f"{name} {SERIES}x{BARS}"
+    closes = engine.empty(_close.shape)
+    closes[:] = _close
+    out = benchmark(engine.run, name, closes, timeperiod=14)
+    np.testing.assert_array_equal(out[-1], getattr(pytafast, name)(_close[-1], 14))
+
+
+@pytest.mark.parametrize("name", ["SMA", "RSI"])
+def test_parallel_shared_memory_copy_in(benchmark, engine, name):
+    # Inputs not built in shared memory: one copy in per run
+    benchmark.group = f"{name} {SERIES}x{BARS}"
+    benchmark(engine.run, name, _close, timeperiod=14)
+
+
+@pytest.mark.parametrize("name", ["SMA", "RSI"])
+def test_parallel_threads(benchmark, name):
+    benchmark.group = f"{name} {SERIES}x{BARS}"
+    out = benchmark(ThreadEngine(WORKERS).run, name, _close, timeperiod=14)
+    np.testing.assert_array_equal(out[-1], getattr(pytafast, name)(_close[-1], 14))
@@ -0,0 +1,194 @@
+"""
+Memory high-water and allocation churn for every function.
+
+Each registered function (all 61 CDL patterns, the multi-output functions in
+every layout, the int-output functions) is called on NUMBARS bars and
+measured for:
+
+- py_blocks / py_bytes: Python memory blocks and bytes (tracemalloc) held by
+  one result - the arrays, capsules and tuples a call hands back;
+- py_retained / rss_retained: Python and native (RSS) growth after REPEAT
+  calls whose results are dropped - a leaked capsule or output shows here;
+- rss_peak: native high-water above the starting RSS during one call
+  (Linux, where /proc/self/clear_refs resets the high-water mark).
+
+Leaks and gross over-allocation fail against fixed bounds. Every measure
+also fails when it grows past the stored baseline (tests/memory_baseline.json)
+by more than the tolerance. To record or refresh the baseline on the
+reference machine, run:
+
+    PYTAFAST_UPDATE_MEMORY_BASELINE=1 uv run pytest tests/test_memory.py
+
+Every test fails while the baseline file is missing. Functions without an
+entry in it (added since it was recorded) are only checked against the
+bounds.
+"""
+
+import gc
+import json
+import os
+import pathlib
+import tracemalloc
+
+import pytest
+import numpy as np
+import pytafast
+
+NUMBARS = 100_000
+REPEAT = 50
+BASELINE = pathlib.Path(__file__).with_name("memory_baseline.json")
+UPDATE = bool(os.environ.get("PYTAFAST_UPDATE_MEMORY_BASELINE"))
+
+# Growth allowed over the baseline: relative, plus an absolute floor for
+# measures that are near zero
+TOLERANCE = 0.10
+SLACK = {"py_blocks": 2, "py_bytes": 1024, "py_retained": 4096,
+         "rss_retained": 2**20, "rss_peak": 2**20}
+
+np.random.seed(42)
+_close = np.random.random(NUMBARS) * 100 + 50
+_SERIES = {
+    "inOpen": _close + (np.random.random(NUMBARS) - 0.5) * 3,
+    "inHigh": _close + np.random.random(NUMBARS) * 5,
+    "inLow": _close - np.random.random(NUMBARS) * 5,
+    "inClose": _close,
+    "inVolume": np.random.random(NUMBARS) * 1_000_000 + 100_000,
+    "inReal": _close,
+    "inReal0": _close,
+    "inReal1": np.random.random(NUMBARS) * 100 + 50,
+}
+
+
+def _cases():
+    cases = []
+    for name in pytafast.function_names():
+        cases.append((name, None))
+        info = pytafast.function_info(name)
+        if len(info["outputs"]) > 1 and name not in pytafast._OUTPUT_SELECTION:
+            cases += [(name, "kN"), (name, "Nk")]
+    return cases
+
+
+def _case_id(case):
+    name, layout = case
+    return name if layout is None else f"{name}-{layout}"
+
+
+def _call(name, layout):
+    fn = getattr(pytafast, name)
+    inputs = [_SERIES[i] for i in pytafast.function_info(name)["inputs"]]
+    if layout is None:
+        return lambda: fn(*inputs)
+    return lambda: fn(*inputs, layout=layout)
+
+
+def _rss():
+    try:
+        with open("/proc/self/statm") as f:
+            return int(f.read().split()[1]) * os.sysconf("SC_PAGE_SIZE")
+    except OSError:
+        return None
+
+
+def _reset_peak_rss():
+    try:
+        with open("/proc/self/clear_refs", "w") as f:
+            f.write("5")
+        return True
+    except OSError:
+        return False
+
+
+def _peak_rss():
+    with open("/proc/self/status") as f:
+        for line in f:
+            if line.startswith("VmHWM:"):
+                return int(line.split()[1]) * 1024
+    return None
+
+
+def _output_bytes(name):
+    info = pytafast.function_info(name)
+    itemsize = np.dtype(info["output_dtype"]).itemsize
+    return len(info["outputs"]) * NUMBARS * itemsize
+
+
+def _measure(call):
+    call()  # warm up: lazy imports, first-use caches
+    gc.collect()
+    measured = {}
+
+    tracemalloc.start()
+    try:
+        before = tracemalloc.take_snapshot()
+        result = call()
+        after = tracemalloc.take_snapshot()
+        held = [s for s in after.compare_to(before, "filename") if s.size_diff > 0]
+        measured["py_blocks"] = sum(s.count_diff for s in held)
+        measured["py_bytes"] = sum(s.size_diff for s in held)
+        del result
+
+        gc.collect()
+        base, _ = tracemalloc.get_traced_memory()
+        for _ in range(REPEAT):
+            call()
+        gc.collect()
+        current, _ = tracemalloc.get_traced_memory()
+        measured["py_retained"] = max(0, current - base)
+    finally:
+        tracemalloc.stop()
+
+    rss = _rss()
+    if rss is not None:
+        for _ in range(REPEAT):
+            call()
+        gc.collect()
+        measured["rss_retained"] = max(0, _rss() - rss)
+        if _reset_peak_rss():
+            start = _rss()
+            result = call()
+            measured["rss_peak"] = max(0, _peak_rss() - start)
+            del result
+    return measured
+
+
+@pytest.fixture(scope="module")
+def baseline():
+    if not BASELINE.exists() and not UPDATE:
+        pytest.fail(f"{BASELINE.name} is missing: record it with "
+                    "PYTAFAST_UPDATE_MEMORY_BASELINE=1 uv run pytest "
+                    "tests/test_memory.py and commit it", pytrace=False)
+    stored = json.loads(BASELINE.read_text()) if BASELINE.exists() else {}
+    recorded = {}
+    yield stored, recorded
+    if UPDATE and recorded:
+        stored.update(recorded)
+        BASELINE.write_text(json.dumps(stored, indent=1, sort_keys=True) + "\n")
+
+
+@pytest.mark.parametrize("case", _cases(), ids=_case_id)
+def test_memory(baseline, case):
+    name, layout = case
+    stored, recorded = baseline
+    measured = _measure(_call(name, layout))
+    key = _case_id(case)
+    recorded[key] = measured
+
+    output = _output_bytes(name)
+    # No leaks: nothing accumulates over REPEAT calls beyond allocator noise
+    assert measured["py_retained"] < 64 * 1024, measured
+    if "rss_retained" in measured:
+        assert measured["rss_retained"] < 4 * output + 4 * 2**20, measured
+    # Results hold Python objects only; the output buffers are native
+    assert measured["py_bytes"] < 16 * 1024, measured
+    # The call itself: outputs plus TA-Lib scratch of a few series
+    if "rss_peak" in measured:
+        assert measured["rss_peak"] < output + 6 * NUMBARS * 8 + 4 * 2**20, measured
+
+    if UPDATE or key not in stored:
+        return
+    regressions = {
+        k: (v, stored[key][k]) for k, v in measured.items()
+        if k in stored[key] and v > stored[key][k] * (1 + TOLERANCE) + SLACK[k]
+    }
+    assert not regressions, f"{key}: measured vs baseline {regressions}"
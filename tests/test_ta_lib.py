@@ -896,3 +896,1021 @@ def test_cdl_penetration_against_official_talib(func_name):
     p_out = getattr(pytafast, func_name)(in_open, in_high, in_low, in_close)
     valid = ~np.isnan(o_out.astype(float))
     np.testing.assert_array_equal(np.array(p_out)[valid], np.array(o_out)[valid].astype(int))
+
+# --- Batch 8: Fused kernels ---
+
+def test_dmi_all_matches_standalone():
+    np.random.seed(42)
+    in_high = np.random.random(200) * 100 + 10
+    in_low = in_high - np.random.random(200) * 5
+    in_close = in_low + (in_high - in_low) / 2
+    for period in [2, 5, 14]:
+        outs = pytafast.DMI_ALL(in_high, in_low, in_close, timeperiod=period)
+        expected = (
+            pytafast.PLUS_DM(in_high, in_low, timeperiod=period),
+            pytafast.MINUS_DM(in_high, in_low, timeperiod=period),
+            pytafast.PLUS_DI(in_high, in_low, in_close, timeperiod=period),
+            pytafast.MINUS_DI(in_high, in_low, in_close, timeperiod=period),
+            pytafast.DX(in_high, in_low, in_close, timeperiod=period),
+            pytafast.ADX(in_high, in_low, in_close, timeperiod=period),
+            pytafast.ADXR(in_high, in_low, in_close, timeperiod=period),
+        )
+        assert len(outs) == 7
+        for p_out, e_out in zip(outs, expected):
+            np.testing.assert_allclose(p_out, e_out, rtol=1e-12, equal_nan=True)
+
+def test_dmi_all_pandas_and_edge_cases():
+    np.random.seed(42)
+    idx = pd.date_range("2024-01-01", periods=50, freq="D")
+    high = pd.Series(np.random.random(50) * 100 + 10, index=idx)
+    low = high - np.random.random(50) * 5
+    close = low + (high - low) / 2
+    outs = pytafast.DMI_ALL(high, low, close, timeperiod=5)
+    assert [o.name for o in outs] == ["PLUS_DM", "MINUS_DM", "PLUS_DI", "MINUS_DI", "DX", "ADX", "ADXR"]
+    assert all(o.index.equals(idx) for o in outs)
+
+    # Shorter than the ADXR lookback: everything past each lookback, rest NaN
+    short = pytafast.DMI_ALL(high.values[:6], low.values[:6], close.values[:6], timeperiod=5)
+    assert np.isnan(short[6]).all()
+    assert not np.isnan(short[0][4])
+
+    assert all(len(o) == 0 for o in pytafast.DMI_ALL(np.array([]), np.array([]), np.array([])))
+    with pytest.raises(Exception):
+        pytafast.DMI_ALL(high.values, low.values[:10], close.values)
+    with pytest.raises(Exception):
+        pytafast.DMI_ALL(high.values, low.values, close.values, timeperiod=1)
+
+def test_stoch_all_matches_standalone():
+    np.random.seed(42)
+    in_high = np.random.random(200) * 100 + 10
+    in_low = in_high - np.random.random(200) * 5
+    in_close = in_low + (in_high - in_low) * np.random.random(200)
+    for matype_val in [0, 1]:  # SMA, EMA
+        for fastk_period in [2, 5, 14]:
+            fastk, fastd, slowk, slowd, willr = pytafast.STOCH_ALL(
+                in_high, in_low, in_close,
+                outputs=["fastk", "fastd", "slowk", "slowd", "willr"],
+                fastk_period=fastk_period, slowk_period=3, slowk_matype=matype_val,
+                slowd_period=4, slowd_matype=matype_val,
+                fastd_period=3, fastd_matype=matype_val)
+            e_slowk, e_slowd = pytafast.STOCH(
+                in_high, in_low, in_close, fastk_period=fastk_period,
+                slowk_period=3, slowk_matype=matype_val,
+                slowd_period=4, slowd_matype=matype_val)
+            e_fastk, e_fastd = pytafast.STOCHF(
+                in_high, in_low, in_close, fastk_period=fastk_period,
+                fastd_period=3, fastd_matype=matype_val)
+            e_willr = pytafast.WILLR(in_high, in_low, in_close, timeperiod=fastk_period)
+            np.testing.assert_allclose(fastk, e_fastk, equal_nan=True)
+            np.testing.assert_allclose(fastd, e_fastd, equal_nan=True)
+            np.testing.assert_allclose(slowk, e_slowk, equal_nan=True)
+            np.testing.assert_allclose(slowd, e_slowd, equal_nan=True)
+            np.testing.assert_allclose(willr, e_willr, equal_nan=True)
+
+def test_stoch_all_fastk_period_1_without_willr():
+    np.random.seed(42)
+    in_high = np.random.random(100) * 100 + 10
+    in_low = in_high - np.random.random(100) * 5
+    in_close = in_low + (in_high - in_low) * np.random.random(100)
+    fastk, slowk = pytafast.STOCH_ALL(in_high, in_low, in_close,
+                                      outputs=["fastk", "slowk"], fastk_period=1)
+    e_fastk, _ = pytafast.STOCHF(in_high, in_low, in_close, fastk_period=1)
+    e_slowk, _ = pytafast.STOCH(in_high, in_low, in_close, fastk_period=1)
+    np.testing.assert_allclose(fastk, e_fastk, equal_nan=True)
+    np.testing.assert_allclose(slowk, e_slowk, equal_nan=True)
+
+def test_stoch_all_fastk_period_1_with_willr_raises():
+    np.random.seed(42)
+    in_high = np.random.random(100) * 100 + 10
+    in_low = in_high - np.random.random(100) * 5
+    in_close = in_low + (in_high - in_low) * np.random.random(100)
+    with pytest.raises(RuntimeError, match="STOCH_ALL"):
+        pytafast.STOCH_ALL(in_high, in_low, in_close,
+                           outputs=["fastk", "willr"], fastk_period=1)
+
+def test_stoch_all_output_selection():
+    np.random.seed(42)
+    in_high = pd.Series(np.random.random(60) * 100 + 10)
+    in_low = in_high - np.random.random(60) * 5
+    in_close = in_low + (in_high - in_low) / 2
+    (willr,) = pytafast.STOCH_ALL(in_high, in_low, in_close, outputs="willr")
+    assert isinstance(willr, pd.Series) and willr.name == "WILLR"
+    slowd, fastk = pytafast.STOCH_ALL(in_high, in_low, in_close, outputs=["slowd", "fastk"])
+    assert (slowd.name, fastk.name) == ("SlowD", "FastK")
+    assert pytafast.STOCH_ALL(np.array([]), np.array([]), np.array([]), outputs=["slowk"])[0].size == 0
+    with pytest.raises(ValueError):
+        pytafast.STOCH_ALL(in_high, in_low, in_close, outputs=["rsi"])
+
+# --- Batch 9: Multi-output layouts ---
+
+def test_multi_output_tuple_shares_one_block():
+    np.random.seed(42)
+    in_real = np.random.random(100) * 100
+    macd, signal, hist = pytafast.MACD(in_real)
+    assert macd.base is not None
+    assert macd.base is signal.base and signal.base is hist.base
+
+@pytest.mark.parametrize("layout", ["kN", "Nk"])
+def test_multi_output_block_layouts(layout):
+    np.random.seed(42)
+    in_high = np.random.random(100) * 100 + 10
+    in_low = in_high - np.random.random(100) * 5
+    in_close = in_low + (in_high - in_low) * np.random.random(100)
+    cases = [
+        (pytafast.BBANDS, (in_close,), {"timeperiod": 10}),
+        (pytafast.MACD, (in_close,), {}),
+        (pytafast.STOCH, (in_high, in_low, in_close), {}),
+        (pytafast.AROON, (in_high, in_low), {}),
+        (pytafast.MINMAX, (in_close,), {"timeperiod": 10}),
+        (pytafast.HT_SINE, (in_close,), {}),
+        (pytafast.DMI_ALL, (in_high, in_low, in_close), {}),
+        (pytafast.STOCH_ALL, (in_high, in_low, in_close), {"outputs": ["willr", "fastk", "willr"]}),
+    ]
+    for func, args, kwargs in cases:
+        expected = np.vstack(func(*args, **kwargs))
+        block = func(*args, layout=layout, **kwargs)
+        assert block.flags['C_CONTIGUOUS']
+        got = block if layout == "kN" else block.T
+        assert got.shape == expected.shape
+        np.testing.assert_array_equal(got, expected)
+
+def test_multi_output_layout_pandas_and_errors():
+    in_real = pd.Series(np.arange(1.0, 41.0), index=pd.date_range("2024-01-01", periods=40))
+    for layout in ["kN", "Nk"]:
+        df = pytafast.BBANDS(in_real, layout=layout)
+        assert isinstance(df, pd.DataFrame)
+        assert list(df.columns) == ["UpperBand", "MiddleBand", "LowerBand"]
+        assert df.index.equals(in_real.index)
+        pd.testing.assert_series_equal(df["MiddleBand"], pytafast.BBANDS(in_real)[1])
+    assert pytafast.MACD(np.array([]), layout="Nk").shape == (0, 3)
+    with pytest.raises(ValueError):
+        pytafast.MACD(in_real.values, layout="columns")
+
+# --- Batch 10: C++ dispatch of the public API ---
+
+def test_api_dispatch_input_kinds():
+    np.random.seed(42)
+    in_real = np.random.random(64) * 100
+    expected = pytafast.pytafast_ext.SMA(in_real, 10)
+    np.testing.assert_array_equal(pytafast.SMA(in_real, timeperiod=10), expected)
+    np.testing.assert_array_equal(pytafast.SMA(in_real, 10), expected)
+    # Slow-path inputs are converted like np.ascontiguousarray(x, float64)
+    np.testing.assert_array_equal(pytafast.SMA(in_real.tolist(), timeperiod=10), expected)
+    doubled = np.repeat(in_real, 2)[::2]
+    assert not doubled.flags['C_CONTIGUOUS']
+    np.testing.assert_array_equal(pytafast.SMA(doubled, timeperiod=10), expected)
+    f32 = in_real.astype(np.float32)
+    np.testing.assert_array_equal(
+        pytafast.SMA(f32, timeperiod=10),
+        pytafast.pytafast_ext.SMA(f32.astype(np.float64), 10))
+
+def test_api_dispatch_pandas_index_source():
+    np.random.seed(42)
+    idx = pd.date_range("2024-01-01", periods=50)
+    high = pd.Series(np.random.random(50) * 10 + 20, index=idx)
+    low = high - 5
+    close = low + 2
+    # HLC functions take the index from inClose, HL from inHigh
+    out = pytafast.ATR(high.values, low.values, close, timeperiod=5)
+    assert isinstance(out, pd.Series) and out.name == "ATR" and out.index.equals(idx)
+    assert isinstance(pytafast.ATR(high, low, close.values), np.ndarray)
+    out = pytafast.AROONOSC(high, low.values)
+    assert isinstance(out, pd.Series) and out.name == "AROONOSC"
+    out = pytafast.CDLMORNINGSTAR(close, high, low, close, penetration=0.2)
+    assert isinstance(out, pd.Series) and out.dtype == np.int32
+
+# --- Batch 11: Arrow / DLPack interop ---
+
+def test_arrow_input_zero_copy_and_nulls():
+    pa = pytest.importorskip("pyarrow")
+    np.random.seed(42)
+    values = np.random.random(100) * 100
+    arr = pa.array(values)
+    view = pytafast.pytafast_ext.as_float64(arr)
+    assert np.shares_memory(view, arr.to_numpy(zero_copy_only=True))
+    np.testing.assert_array_equal(pytafast.SMA(arr, timeperiod=10), pytafast.SMA(values, timeperiod=10))
+    np.testing.assert_array_equal(
+        pytafast.BBANDS(arr, timeperiod=10)[1], pytafast.BBANDS(values, timeperiod=10)[1])
+    # Nulls become NaN; other numeric types and chunked arrays are converted
+    np.testing.assert_array_equal(
+        pytafast.pytafast_ext.as_float64(pa.array([1.0, None, 3.0])), [1.0, np.nan, 3.0])
+    np.testing.assert_array_equal(
+        pytafast.pytafast_ext.as_float64(pa.array([1, 2, 3], type=pa.int32())), [1.0, 2.0, 3.0])
+    chunked = pa.chunked_array([values[:40], values[40:]])
+    np.testing.assert_array_equal(pytafast.pytafast_ext.as_float64(chunked), values)
+    with pytest.raises(ValueError):
+        pytafast.pytafast_ext.as_float64(pa.array(["a", "b"]))
+
+def test_dlpack_input():
+    np.random.seed(42)
+    values = np.random.random(50)
+
+    class DLPackOnly:
+        def __init__(self, a):
+            self._a = a
+        def __dlpack__(self, *args, **kwargs):
+            return self._a.__dlpack__(*args, **kwargs)
+        def __dlpack_device__(self):
+            return self._a.__dlpack_device__()
+
+    np.testing.assert_array_equal(
+        pytafast.SMA(DLPackOnly(values), timeperiod=5), pytafast.SMA(values, timeperiod=5))
+
+def test_arrow_output_validity_bitmap():
+    pa = pytest.importorskip("pyarrow")
+    np.random.seed(42)
+    values = np.random.random(60) * 100
+    out = pytafast.SMA(values, timeperiod=10)
+    exported = pytafast.to_arrow(out)
+    assert len(exported) == 60 and exported.null_count == 9
+    arr = pa.array(exported)
+    assert arr.type == pa.float64() and arr.null_count == 9
+    assert arr.to_pylist()[:9] == [None] * 9
+    np.testing.assert_array_equal(arr.to_numpy(zero_copy_only=False)[9:], out[9:])
+    upper, middle, lower = pytafast.to_arrow(pytafast.BBANDS(values, timeperiod=5))
+    assert pa.array(middle).null_count == 4
+
+# --- Batch 12: Polars expression namespace ---
+
+def test_polars_namespace_matches_per_group():
+    pl = pytest.importorskip("polars")
+    import pytafast.polars  # noqa: F401
+    np.random.seed(42)
+    n = 120
+    close = np.random.random(n) * 100 + 10
+    df = pl.DataFrame({
+        "symbol": ["a"] * (n // 2) + ["b"] * (n // 2),
+        "close": close, "high": close + 1.0, "low": close - 1.0,
+    })
+    out = df.with_columns(
+        pl.col("close").ta.rsi(14).over("symbol").alias("rsi"),
+        pl.col("close").ta.atr(high="high", low="low", timeperiod=5).over("symbol"),
+        pl.col("close").ta.bbands(timeperiod=10).over("symbol").alias("bb"),
+    )
+    for sym, part in zip("ab", (slice(0, n // 2), slice(n // 2, n))):
+        rows = out.filter(pl.col("symbol") == sym)
+        c = close[part]
+        np.testing.assert_array_equal(
+            rows["rsi"].fill_null(np.nan).to_numpy(), pytafast.RSI(c, 14))
+        np.testing.assert_array_equal(
+            rows["atr"].fill_null(np.nan).to_numpy(), pytafast.ATR(c + 1.0, c - 1.0, c, 5))
+        np.testing.assert_array_equal(
+            rows["bb"].struct.field("middleband").fill_null(np.nan).to_numpy(),
+            pytafast.BBANDS(c, 10)[1])
+        # Lookback comes back as null rather than NaN
+        assert rows["rsi"].null_count() == 14
+    with pytest.raises(AttributeError):
+        pl.col("close").ta.not_an_indicator
+    with pytest.raises(TypeError):
+        pl.col("close").ta.atr(timeperiod=5)
+
+
+def test_polars_plugin_runs_natively(monkeypatch):
+    pl = pytest.importorskip("polars")
+    import pytafast.polars  # noqa: F401
+    np.random.seed(42)
+    close = np.random.random(100) * 100 + 10
+    expected = pytafast.SMA(np.where(np.arange(100) == 50, np.nan, close), 5)
+    expected_pattern = pytafast.CDLDOJI(close, close + 1.0, close - 1.0, close)
+    # No Python callback: the plugin calls pytafast_core itself
+    monkeypatch.setattr(pytafast, "SMA", None)
+    # Two chunks, an integer column and a null
+    df = pl.concat([pl.DataFrame({"close": close[:40]}),
+                    pl.DataFrame({"close": close[40:]})], rechunk=False)
+    df = df.with_columns(
+        pl.when(pl.int_range(pl.len()) == 50).then(None).otherwise(pl.col("close"))
+        .alias("gapped"))
+    out = df.select(
+        pl.col("gapped").ta.sma(timeperiod=5).alias("sma"),
+        pl.col("close").ta.cdldoji(open="close", high=pl.col("close") + 1.0,
+                                   low=pl.col("close") - 1.0),
+        pl.col("close").ta.stoch_all(high=pl.col("close") + 1.0,
+                                     low=pl.col("close") - 1.0, outputs="fastk"),
+    )
+    np.testing.assert_array_equal(out["sma"].fill_null(np.nan).to_numpy(), expected)
+    assert out["cdldoji"].dtype == pl.Int32
+    np.testing.assert_array_equal(out["cdldoji"].to_numpy(), expected_pattern)
+    assert out["stoch_all"].dtype == pl.Struct({"fastk": pl.Float64})
+    with pytest.raises(TypeError):
+        pl.col("close").ta.sma(timeperiod=5, nan_policy="skip")
+
+# --- Batch 13: nan_policy ---
+
+def _gapped(n=200, gaps=(60, 61, 130)):
+    np.random.seed(42)
+    x = np.random.random(n) * 100 + 10
+    x[list(gaps)] = np.nan
+    return x
+
+
+def test_nan_policy_skip_matches_packed():
+    x = _gapped()
+    valid = ~np.isnan(x)
+    out = pytafast.EMA(x, timeperiod=10, nan_policy="skip")
+    expected = np.full(len(x), np.nan)
+    expected[valid] = pytafast.EMA(x[valid], timeperiod=10)
+    np.testing.assert_array_equal(out, expected)
+    # TA-Lib on its own never recovers from the gap
+    assert np.isnan(pytafast.EMA(x, timeperiod=10)[100:]).all()
+
+
+def test_nan_policy_restart_per_segment():
+    x = _gapped()
+    out = pytafast.RSI(x, timeperiod=14, nan_policy="restart")
+    for begin, end in ((0, 60), (62, 130), (131, 200)):
+        np.testing.assert_array_equal(out[begin:end],
+                                      pytafast.RSI(x[begin:end], timeperiod=14))
+    assert np.isnan(out[[60, 61, 130]]).all()
+
+
+def test_nan_policy_multi_input_and_output():
+    c = _gapped()
+    h, l = c + 1.0, c - 1.0
+    valid = ~np.isnan(c)
+    out = pytafast.ATR(h, l, c, timeperiod=5, nan_policy="skip")
+    np.testing.assert_array_equal(out[valid], pytafast.ATR(h[valid], l[valid], c[valid], 5))
+    macd = pytafast.MACD(c, nan_policy="skip")
+    for got, exp in zip(macd, pytafast.MACD(c[valid])):
+        np.testing.assert_array_equal(got[valid], exp)
+        assert np.isnan(got[~valid]).all()
+    cdl = pytafast.CDLDOJI(c, h, l, c, nan_policy="restart")
+    assert cdl.dtype == np.int32 and (cdl[~valid] == 0).all()
+
+
+def test_nan_policy_pandas_and_errors():
+    x = _gapped()
+    s = pd.Series(x, index=pd.date_range("2024-01-01", periods=len(x)))
+    out = pytafast.SMA(s, timeperiod=5, nan_policy="skip")
+    assert isinstance(out, pd.Series) and out.index.equals(s.index)
+    np.testing.assert_array_equal(out.values, pytafast.SMA(x, 5, nan_policy="skip"))
+    # No gaps: identical to the default
+    clean = np.random.random(100)
+    np.testing.assert_array_equal(pytafast.SMA(clean, nan_policy="restart"),
+                                  pytafast.SMA(clean))
+    with pytest.raises(ValueError):
+        pytafast.SMA(x, nan_policy="drop")
+    with pytest.raises(ValueError):
+        pytafast.BBANDS(x, layout="kN", nan_policy="skip")
+
+# --- Batch 14: Function metadata and lookback ---
+
+def _registry_inputs(n=300):
+    np.random.seed(42)
+    close = np.random.random(n) * 0.4 + 0.5
+    return {
+        "inReal": close, "inReal0": close, "inReal1": close[::-1].copy(),
+        "inOpen": close, "inHigh": close + 0.05, "inLow": close - 0.05,
+        "inClose": close, "inVolume": np.random.random(n) * 1000,
+    }
+
+
+def test_registry_covers_public_api():
+    names = set(pytafast.function_names())
+    assert names == set(pytafast._ALL_FUNCTIONS + pytafast._CDL_STANDARD +
+                        pytafast._CDL_PENETRATION)
+    # Custom-signature functions are bound by hand in pytafast_ext.cpp
+    assert [n for n in names if not hasattr(pytafast.pytafast_ext, n)] == []
+
+
+def test_lookback_matches_leading_nans():
+    data = _registry_inputs()
+    for name in pytafast.function_names():
+        info = pytafast.function_info(name)
+        if info["output_dtype"] != "float64":
+            continue
+        out = getattr(pytafast, name)(*[data[i] for i in info["inputs"]])
+        outs = out if isinstance(out, tuple) else (out,)
+        leading = max(int(np.argmax(~np.isnan(o))) for o in outs)
+        assert leading == pytafast.lookback(name) == info["lookback"], name
+
+
+def test_lookback_params_and_info():
+    assert pytafast.lookback("SMA", timeperiod=20) == 19
+    assert pytafast.lookback("sma") == 29
+    assert pytafast.lookback("MA", timeperiod=10, matype=pytafast.MAType.EMA) == 9
+    x = _registry_inputs()["inReal"]
+    upper = pytafast.BBANDS(x, timeperiod=20, matype=pytafast.MAType.WMA)[0]
+    assert np.isnan(upper).sum() == pytafast.lookback(
+        "BBANDS", timeperiod=20, matype=pytafast.MAType.WMA)
+
+    info = pytafast.function_info("BBANDS")
+    assert info["inputs"] == ["inReal"]
+    assert info["outputs"] == ["upperband", "middleband", "lowerband"]
+    assert info["parameters"] == {"timeperiod": 5, "nbdevup": 2.0,
+                                  "nbdevdn": 2.0, "matype": 0}
+    assert pytafast.function_info("CDLDOJI")["output_dtype"] == "int32"
+
+    with pytest.raises(ValueError):
+        pytafast.lookback("NOT_A_FUNCTION")
+    with pytest.raises(ValueError):
+        pytafast.lookback("SMA", period=10)
+
+# --- Batch 15: Result cache ---
+
+@pytest.fixture
+def result_cache():
+    pytafast.enable_cache()
+    pytafast.clear_cache()
+    yield
+    pytafast.disable_cache()
+
+
+def test_cache_hit_shares_readonly_buffer(result_cache):
+    x = _registry_inputs()["inReal"]
+    first = pytafast.SMA(x, timeperiod=20)
+    again = pytafast.SMA(x.copy(), timeperiod=20)
+    assert np.shares_memory(first, again)
+    assert not again.flags.writeable
+    info = pytafast.cache_info()
+    assert (info["hits"], info["misses"], info["entries"]) == (1, 1, 1)
+    # Parameters, nan_policy and layout are part of the key
+    pytafast.SMA(x, timeperiod=10)
+    pytafast.SMA(x, timeperiod=20, nan_policy="skip")
+    pytafast.MINMAX(x, layout="tuple")
+    pytafast.MINMAX(x, layout="kN")  # 2-D: computed, not cached
+    assert pytafast.cache_info()["entries"] == 4
+    s = pd.Series(x, index=pd.date_range("2024-01-01", periods=len(x)))
+    out = pytafast.SMA(s, timeperiod=20)
+    assert isinstance(out, pd.Series) and out.index.equals(s.index)
+    assert pytafast.cache_info()["hits"] == 2
+
+
+def test_cache_append_computes_tail(result_cache):
+    data = _registry_inputs()
+    pytafast.disable_cache()
+    expected = {}
+    for name in pytafast.function_names():
+        info = pytafast.function_info(name)
+        if info["windowed"]:
+            expected[name] = getattr(pytafast, name)(*[data[i] for i in info["inputs"]])
+    pytafast.enable_cache()
+    for name, full in expected.items():
+        info = pytafast.function_info(name)
+        fn = getattr(pytafast, name)
+        fn(*[data[i][:250] for i in info["inputs"]])
+        tail_hits = pytafast.cache_info()["tail_hits"]
+        out = fn(*[data[i] for i in info["inputs"]])
+        assert pytafast.cache_info()["tail_hits"] == tail_hits + 1, name
+        for got, exp in zip(out if isinstance(out, tuple) else (out,),
+                            full if isinstance(full, tuple) else (full,)):
+            np.testing.assert_allclose(got, exp, rtol=1e-9, atol=1e-12, err_msg=name)
+
+    # Recursive functions recompute in full
+    x = data["inReal"]
+    pytafast.EMA(x[:250], timeperiod=10)
+    tail_hits = pytafast.cache_info()["tail_hits"]
+    pytafast.disable_cache()
+    expected = pytafast.EMA(x, timeperiod=10)
+    pytafast.enable_cache()
+    np.testing.assert_array_equal(pytafast.EMA(x, timeperiod=10), expected)
+    assert pytafast.cache_info()["tail_hits"] == tail_hits
+
+
+def test_cache_budget_and_disable(result_cache):
+    x = _registry_inputs()["inReal"]
+    pytafast.enable_cache(max_bytes=3 * x.nbytes)
+    for period in range(5, 15):
+        pytafast.SMA(x, timeperiod=period)
+    info = pytafast.cache_info()
+    assert info["entries"] == 3 and info["bytes"] <= info["max_bytes"]
+    pytafast.SMA(x, timeperiod=14)
+    assert pytafast.cache_info()["hits"] == 1
+    pytafast.SMA(x, timeperiod=5)
+    assert pytafast.cache_info()["misses"] == 11
+
+    pytafast.disable_cache()
+    assert pytafast.cache_info()["entries"] == 0
+    assert pytafast.SMA(x, timeperiod=5).flags.writeable
+    with pytest.raises(ValueError):
+        pytafast.enable_cache(max_bytes=0)
+
+# --- Batch 16: Shared-memory process engine ---
+
+def test_shared_memory_engine():
+    import multiprocessing
+    from pytafast.parallel import SharedMemoryEngine
+
+    np.random.seed(42)
+    closes = np.random.random((7, 300)) * 100 + 50
+    with SharedMemoryEngine(workers=3,
+                            mp_context=multiprocessing.get_context("spawn")) as engine:
+        rsi = engine.run("RSI", closes, timeperiod=14)
+        shared = engine.empty(closes.shape)
+        shared[:] = closes
+        upper, middle, lower = engine.run("BBANDS", shared[2:], timeperiod=20)
+        cdl = engine.run("CDLDOJI", closes, closes + 1, closes - 1, closes)
+        with pytest.raises(ValueError):
+            engine.run("SMA", closes[0])
+    # Results outlive the engine
+    for row in range(len(closes)):
+        np.testing.assert_array_equal(rsi[row], pytafast.RSI(closes[row], 14))
+        np.testing.assert_array_equal(cdl[row], pytafast.CDLDOJI(
+            closes[row], closes[row] + 1, closes[row] - 1, closes[row]))
+    for got, exp in zip((upper, middle, lower),
+                        pytafast.BBANDS(closes[-1], timeperiod=20)):
+        assert got.shape == (5, 300)
+        np.testing.assert_array_equal(got[-1], exp)
+    assert cdl.dtype == np.int32
+
+# --- Batch 17: Instrumentation counters ---
+
+def test_stats_counters():
+    if not pytafast.stats_available:
+        with pytest.raises(RuntimeError):
+            pytafast.stats()
+        return
+    pytafast.reset_stats()
+    x = np.random.random(1000)
+    pytafast.SMA(x, timeperiod=10)
+    pytafast.SMA(pd.Series(x), timeperiod=10)
+    pytafast.MA(x, timeperiod=10)
+    pytafast.MACD(x)
+    stats = pytafast.stats()
+    sma = stats["SMA"]
+    assert sma["calls"] == 2 and sma["elements"] == 2000
+    assert sma["bytes_allocated"] == 2 * x.nbytes
+    assert sma["total_ns"] >= sma["compute_ns"] + sma["alloc_ns"]
+    assert sma["overhead_ns"] == sma["total_ns"] - sma["compute_ns"]
+    assert sma["gil_released_ns"] >= sma["compute_ns"]
+    assert stats["MA"]["calls"] == 1
+    assert stats["MACD"]["bytes_allocated"] == 3 * x.nbytes
+    pytafast.reset_stats()
+    assert pytafast.stats() == {}
+
+# --- Batch 18: Trace export ---
+
+def test_trace_export(tmp_path):
+    import asyncio
+    import json
+    import threading
+
+    x = np.random.random(1000)
+    pytafast.start_trace()
+    try:
+        pytafast.SMA(x, timeperiod=10)
+        worker = threading.Thread(target=pytafast.RSI, args=(x, 14),
+                                  name="rsi-worker")
+        worker.start()
+        worker.join()
+        asyncio.run(pytafast.aio.EMA(x, timeperiod=10))
+    finally:
+        pytafast.stop_trace()
+    pytafast.SMA(x, timeperiod=20)  # not recorded
+
+    path = tmp_path / "trace.json"
+    count = pytafast.dump_trace(path)
+    events = json.loads(path.read_text())["traceEvents"]
+    spans = [e for e in events if e["ph"] == "X"]
+    assert len(spans) == count
+    calls = {e["name"]: e for e in spans if e["cat"] == "call"}
+    assert {"SMA", "RSI", "EMA"} <= set(calls)
+    assert sum(e["name"] == "SMA" for e in spans) == 1
+    assert calls["RSI"]["tid"] != calls["SMA"]["tid"]
+    assert any(e["name"] == "EMA queued" and e["tid"] == calls["EMA"]["tid"]
+               for e in spans)
+    sma = calls["SMA"]
+    compute = [e for e in spans if e["name"] == "compute" and e["tid"] == sma["tid"]
+               and sma["ts"] <= e["ts"] <= sma["ts"] + sma["dur"]]
+    assert len(compute) == 1
+
+def test_trace_sampling_and_ring():
+    x = np.random.random(100)
+    pytafast.start_trace(sample_rate=0.25, buffer_events=8)
+    try:
+        for _ in range(100):
+            pytafast.SMA(x, timeperiod=10)
+    finally:
+        pytafast.stop_trace()
+    events = pytafast.pytafast_ext.trace_events()
+    assert 0 < len(events) <= 8
+    with pytest.raises(ValueError):
+        pytafast.start_trace(sample_rate=0)
+
+
+# --- Batch 19: Table-generated bindings ---
+
+@pytest.mark.parametrize("name,inputs", [
+    ("ADD", 2), ("DIV", 2), ("STOCHF", 3), ("AD", 4), ("AVGPRICE", 4),
+    ("CORREL", 2), ("MIDPRICE", 2), ("ATR", 3), ("CDLDOJI", 4),
+])
+def test_input_lengths_must_match(name, inputs):
+    args = [np.random.random(50) for _ in range(inputs - 1)]
+    args.append(np.random.random(40))
+    with pytest.raises(Exception, match="Input lengths must match"):
+        getattr(pytafast.pytafast_ext, name)(*args)
+    with pytest.raises(Exception, match="Input lengths must match"):
+        getattr(pytafast, name)(*args)
+
+def test_table_functions_empty_input():
+    empty = np.array([], dtype=np.float64)
+    assert len(pytafast.ADD(empty, empty)) == 0
+    assert len(pytafast.SMA(empty, timeperiod=5)) == 0
+    assert len(pytafast.CDLDOJI(empty, empty, empty, empty)) == 0
+    assert len(pytafast.CDLMORNINGSTAR(empty, empty, empty, empty)) == 0
+
+
+# --- Batch 20: Lazy import ---
+
+def test_import_is_lazy():
+    import subprocess
+    import sys
+    code = (
+        "import sys, pytafast\n"
+        "assert 'pandas' not in sys.modules, 'pandas'\n"
+        "assert 'asyncio' not in sys.modules, 'asyncio'\n"
+        "assert 'pytafast.aio' not in sys.modules, 'aio'\n"
+        "assert 'SMA' not in vars(pytafast)\n"
+        "assert pytafast.SMA is pytafast.pytafast_ext.api.SMA\n"
+        "assert 'SMA' in vars(pytafast)\n"
+        "pytafast.aio.SMA\n"
+        "assert 'asyncio' in sys.modules\n"
+    )
+    subprocess.run([sys.executable, "-c", code], check=True)
+
+
+def test_lazy_names():
+    import pytafast.aio
+    assert pytafast.aio is pytafast.aio
+    assert set(pytafast.function_names()) <= set(dir(pytafast))
+    assert set(pytafast.function_names()) <= set(dir(pytafast.aio))
+    assert pytafast.aio.CDLDOJI.__name__ == "CDLDOJI"
+    with pytest.raises(AttributeError):
+        pytafast.NOT_A_FUNCTION
+    with pytest.raises(AttributeError):
+        pytafast.aio.NOT_A_FUNCTION
+
+
+def test_star_import():
+    namespace = {}
+    exec("from pytafast import *", namespace)
+    # Table, candlestick and custom-signature functions, and the module API
+    for name in ["SMA", "RSI", "CDLDOJI", "CDLMORNINGSTAR", "MA", "BBANDS",
+                 "HT_ALL", "MAType", "lookback", "StreamCDL"]:
+        assert namespace[name] is getattr(pytafast, name)
+    assert "np" not in namespace and "pytafast_ext" not in namespace
+
+    namespace = {}
+    exec("from pytafast.aio import *", namespace)
+    assert namespace["SMA"] is pytafast.aio.SMA
+    assert namespace["CDLMORNINGSTAR"] is pytafast.aio.CDLMORNINGSTAR
+
+
+# --- Batch 21: Native plugins ---
+
+_PLUGIN_SOURCE = r"""
+#include <pytafast/plugin.h>
+
+static const char *const inputs[] = {"inHigh", "inLow"};
+static const char *const outputs[] = {"range", "mid"};
+static const pytafast_param params[] = {
+    {"timeperiod", PYTAFAST_PARAM_INT, 5}, {"scale", PYTAFAST_PARAM_REAL, 1}};
+
+static int lookback(const double *p) { return (int)p[0] - 1; }
+
+static int compute(int size, int lookback, const double *const *in,
+                   const double *p, void *const *out) {
+  double *range = (double *)out[0], *mid = (double *)out[1];
+  if (p[0] < 1) return 2;
+  for (int i = lookback; i < size; ++i) {
+    double hi = in[0][i], lo = in[1][i];
+    for (int k = i - lookback; k < i; ++k) {
+      if (in[0][k] > hi) hi = in[0][k];
+      if (in[1][k] < lo) lo = in[1][k];
+    }
+    range[i] = (hi - lo) * p[1];
+    mid[i] = (hi + lo) / 2;
+  }
+  return 0;
+}
+
+static const pytafast_function functions[] = {
+    {"TEST_RANGE", "Custom", 2, inputs, 2, outputs, 0, 2, params, lookback,
+     compute, 1}};
+static const pytafast_plugin plugin = {PYTAFAST_PLUGIN_ABI, 1, functions};
+
+PYTAFAST_PLUGIN_EXPORT const pytafast_plugin *pytafast_plugin_entry(void) {
+  return &plugin;
+}
+"""
+
+
+@pytest.fixture(scope="module")
+def range_plugin(tmp_path_factory):
+    import pathlib
+    import shutil
+    import subprocess
+    import sys
+    cc = shutil.which("cc") or shutil.which("gcc") or shutil.which("clang")
+    if cc is None or sys.platform == "win32":
+        pytest.skip("no C compiler to build the test plugin")
+    include = pathlib.Path(__file__).resolve().parents[1] / "include"
+    tmp = tmp_path_factory.mktemp("plugin")
+    (tmp / "range.c").write_text(_PLUGIN_SOURCE)
+    library = tmp / "librange.so"
+    subprocess.run([cc, "-shared", "-fPIC", "-O2", f"-I{include}",
+                    str(tmp / "range.c"), "-o", str(library)], check=True)
+    assert pytafast.load_plugin(library) == ["TEST_RANGE"]
+    return library
+
+
+def _rolling_range(high, low, timeperiod, scale=1.0):
+    hi = pd.Series(high).rolling(timeperiod).max().to_numpy()
+    lo = pd.Series(low).rolling(timeperiod).min().to_numpy()
+    return (hi - lo) * scale, (hi + lo) / 2
+
+
+def test_plugin_function(range_plugin):
+    high = np.random.random(200) + 1
+    low = high - np.random.random(200)
+    rng, mid = pytafast.TEST_RANGE(high, low, timeperiod=10, scale=2)
+    exp_rng, exp_mid = _rolling_range(high, low, 10, 2.0)
+    np.testing.assert_allclose(rng, exp_rng, equal_nan=True)
+    np.testing.assert_allclose(mid, exp_mid, equal_nan=True)
+
+    # Same conventions as the built-in functions
+    assert "TEST_RANGE" in pytafast.function_names()
+    info = pytafast.function_info("test_range")
+    assert info["outputs"] == ["range", "mid"]
+    assert info["parameters"] == {"timeperiod": 5, "scale": 1.0}
+    assert info["windowed"] and info["lookback"] == 4
+    assert pytafast.lookback("TEST_RANGE", timeperiod=10) == 9
+    block = pytafast.TEST_RANGE(high, low, 10, layout="kN")
+    np.testing.assert_array_equal(block[0], rng / 2)
+    df = pytafast.TEST_RANGE(pd.Series(high), pd.Series(low), layout="Nk")
+    assert list(df.columns) == ["range", "mid"]
+    with pytest.raises(RuntimeError, match="TEST_RANGE failed"):
+        pytafast.TEST_RANGE(high, low, timeperiod=0)
+    with pytest.raises(Exception, match="Input lengths must match"):
+        pytafast.TEST_RANGE(high, low[:-1])
+
+    # Loading again is a no-op; names are unique across all functions
+    assert pytafast.load_plugin(range_plugin) == ["TEST_RANGE"]
+    with pytest.raises(ValueError):
+        pytafast.load_plugin(range_plugin.parent / "missing.so")
+
+
+def test_plugin_nan_policy_cache_and_aio(range_plugin):
+    import asyncio
+    high = np.random.random(100) + 1
+    low = high - np.random.random(100)
+    high[40] = np.nan
+    rng, _ = pytafast.TEST_RANGE(high, low, nan_policy="skip")
+    assert np.isnan(rng[40]) and not np.isnan(rng[41])
+
+    pytafast.enable_cache()
+    try:
+        first = pytafast.TEST_RANGE(high[50:], low[50:])
+        again = pytafast.TEST_RANGE(high[50:].copy(), low[50:].copy())
+        np.testing.assert_array_equal(first[0], again[0])
+        assert pytafast.cache_info()["hits"] >= 1
+    finally:
+        pytafast.disable_cache()
+
+    result = asyncio.run(pytafast.aio.TEST_RANGE(high[50:], low[50:]))
+    np.testing.assert_array_equal(result[0], first[0])
+
+
+def test_plugin_shared_memory_engine(range_plugin):
+    import multiprocessing
+    from pytafast.parallel import SharedMemoryEngine
+
+    high = np.random.random((4, 120)) + 1
+    low = high - np.random.random((4, 120))
+    # Spawned workers load the plugin again from its path
+    with SharedMemoryEngine(workers=2,
+                            mp_context=multiprocessing.get_context("spawn")) as engine:
+        rng, mid = engine.run("TEST_RANGE", high, low, timeperiod=7)
+    for row in range(len(high)):
+        exp_rng, exp_mid = pytafast.TEST_RANGE(high[row], low[row], 7)
+        np.testing.assert_array_equal(rng[row], exp_rng)
+        np.testing.assert_array_equal(mid[row], exp_mid)
+
+
+# --- Batch 22: TA-Lib context lifetime and thread engine ---
+
+def test_ta_context_lifetime():
+    import subprocess
+    import sys
+    np.random.seed(1)
+    c = np.cumsum(np.random.randn(300)) + 100
+    o, h, l = c + np.random.randn(300), c + 2, c - 2
+    expected = pytafast.CDLENGULFING(o, h, l, c)
+    # The context belongs to the module: Python code cannot release it
+    assert not hasattr(pytafast.pytafast_ext, "initialize")
+    assert not hasattr(pytafast.pytafast_ext, "shutdown")
+    np.testing.assert_array_equal(pytafast.CDLENGULFING(o, h, l, c), expected)
+
+    # atexit hooks registered before the import still see a live context
+    code = (
+        "import atexit, numpy as np\n"
+        "np.random.seed(1)\n"
+        "c = np.cumsum(np.random.randn(300)) + 100\n"
+        "o, h, l = c + np.random.randn(300), c + 2, c - 2\n"
+        "def at_exit():\n"
+        "    assert (pytafast.CDLENGULFING(o, h, l, c) == expected).all()\n"
+        "    print('ok')\n"
+        "atexit.register(at_exit)\n"
+        "import pytafast\n"
+        "expected = pytafast.CDLENGULFING(o, h, l, c)\n"
+    )
+    out = subprocess.run([sys.executable, "-c", code], check=True,
+                         capture_output=True, text=True).stdout
+    assert out.strip() == "ok"
+
+
+def test_thread_engine():
+    from pytafast.parallel import ThreadEngine
+
+    np.random.seed(42)
+    closes = np.random.random((7, 300)) * 100 + 50
+    with ThreadEngine(workers=3) as engine:
+        rsi = engine.run("RSI", closes, timeperiod=14)
+        upper, middle, lower = engine.run("BBANDS", closes[2:], timeperiod=20,
+                                          matype=pytafast.MAType.EMA)
+        cdl = engine.run("CDLDOJI", closes, closes + 1, closes - 1, closes)
+        willr, slowk = engine.run("STOCH_ALL", closes + 1, closes - 1, closes,
+                                  outputs=("willr", "slowk"))
+        with pytest.raises(ValueError, match="2-D"):
+            engine.run("SMA", closes[0])
+        with pytest.raises(ValueError, match="Input shapes must match"):
+            engine.run("CDLDOJI", closes, closes, closes, closes[1:])
+        with pytest.raises(TypeError, match="no parameter"):
+            engine.run("SMA", closes, period=5)
+        with pytest.raises(RuntimeError, match="SMA"):
+            engine.run("SMA", closes, timeperiod=0)
+
+    assert rsi.shape == (7, 300) and cdl.dtype == np.int32
+    for row in range(len(closes)):
+        np.testing.assert_array_equal(rsi[row], pytafast.RSI(closes[row], 14))
+        np.testing.assert_array_equal(cdl[row], pytafast.CDLDOJI(
+            closes[row], closes[row] + 1, closes[row] - 1, closes[row]))
+        exp_willr, exp_slowk = pytafast.STOCH_ALL(
+            closes[row] + 1, closes[row] - 1, closes[row],
+            outputs=("willr", "slowk"))
+        np.testing.assert_array_equal(willr[row], exp_willr)
+        np.testing.assert_array_equal(slowk[row], exp_slowk)
+    for got, exp in zip((upper, middle, lower),
+                        pytafast.BBANDS(closes[-1], timeperiod=20,
+                                        matype=pytafast.MAType.EMA)):
+        assert got.shape == (5, 300)
+        np.testing.assert_array_equal(got[-1], exp)
+
+
+# --- Batch 23: Fused price transforms ---
+
+def test_price_all_matches_standalone():
+    np.random.seed(42)
+    # Longer than one block of the fused kernel, ending mid-block
+    n = 1500
+    in_close = np.cumsum(np.random.randn(n)) + 100
+    in_open = in_close + np.random.randn(n)
+    in_high = np.maximum(in_open, in_close) + np.random.random(n)
+    in_low = np.minimum(in_open, in_close) - np.random.random(n)
+    in_close[700] = np.nan
+    avg, med, typ, wcl, tr = pytafast.PRICE_ALL(in_open, in_high, in_low, in_close)
+    # TA-Lib itself may be built with FMA contraction; allow for the last bit
+    close = dict(rtol=1e-12, atol=0, equal_nan=True)
+    np.testing.assert_allclose(avg, pytafast.AVGPRICE(in_open, in_high, in_low, in_close),
+                               **close)
+    np.testing.assert_allclose(med, pytafast.MEDPRICE(in_high, in_low), **close)
+    np.testing.assert_allclose(typ, pytafast.TYPPRICE(in_high, in_low, in_close), **close)
+    np.testing.assert_allclose(wcl, pytafast.WCLPRICE(in_high, in_low, in_close), **close)
+    np.testing.assert_allclose(tr, pytafast.TRANGE(in_high, in_low, in_close), **close)
+
+    block = pytafast.PRICE_ALL(in_open, in_high, in_low, in_close,
+                               outputs=["trange", "medprice"], layout="Nk")
+    assert block.shape == (n, 2)
+    np.testing.assert_array_equal(block[:, 0], tr)
+    np.testing.assert_array_equal(block[:, 1], med)
+
+
+def test_price_all_selection_and_edge_cases():
+    np.random.seed(42)
+    close = pd.Series(np.random.random(60) * 100 + 10)
+    high, low, open_ = close + 1, close - 1, close.shift(1).fillna(close[0])
+    (typ,) = pytafast.PRICE_ALL(open_, high, low, close, outputs="typprice")
+    assert isinstance(typ, pd.Series) and typ.name == "TYPPRICE"
+    tr, avg, tr2 = pytafast.PRICE_ALL(open_, high, low, close,
+                                      outputs=["trange", "avgprice", "trange"])
+    assert (tr.name, avg.name) == ("TRANGE", "AVGPRICE")
+    np.testing.assert_array_equal(tr, tr2)
+    assert np.isnan(tr.iloc[0]) and not np.isnan(avg.iloc[0])
+
+    one = np.array([1.0])
+    avg, tr = pytafast.PRICE_ALL(one, one, one, one, outputs=["avgprice", "trange"])
+    assert avg[0] == 1.0 and np.isnan(tr[0])
+    empty = np.array([])
+    assert all(o.size == 0 for o in pytafast.PRICE_ALL(empty, empty, empty, empty))
+    with pytest.raises(ValueError):
+        pytafast.PRICE_ALL(open_, high, low, close, outputs=["close"])
+    with pytest.raises(RuntimeError, match="Input lengths must match"):
+        pytafast.PRICE_ALL(open_.values, high.values, low.values[:10], close.values)
+
+
+# --- Batch 24: Fused Hilbert transform ---
+
+def test_ht_all_matches_standalone():
+    np.random.seed(42)
+    in_real = np.cumsum(np.random.random(500) - 0.5) + 100
+    (dcperiod, dcphase, inphase, quadrature, sine, leadsine, trendline,
+     trendmode) = pytafast.HT_ALL(in_real)
+    close = dict(rtol=1e-9, atol=1e-12, equal_nan=True)
+    np.testing.assert_allclose(dcperiod, pytafast.HT_DCPERIOD(in_real), **close)
+    np.testing.assert_allclose(dcphase, pytafast.HT_DCPHASE(in_real), **close)
+    exp_inphase, exp_quadrature = pytafast.HT_PHASOR(in_real)
+    np.testing.assert_allclose(inphase, exp_inphase, **close)
+    np.testing.assert_allclose(quadrature, exp_quadrature, **close)
+    exp_sine, exp_leadsine = pytafast.HT_SINE(in_real)
+    np.testing.assert_allclose(sine, exp_sine, **close)
+    np.testing.assert_allclose(leadsine, exp_leadsine, **close)
+    np.testing.assert_allclose(trendline, pytafast.HT_TRENDLINE(in_real), **close)
+    lookback = pytafast.lookback("HT_TRENDMODE")
+    assert np.isnan(trendmode[:lookback]).all()
+    np.testing.assert_array_equal(trendmode[lookback:],
+                                  pytafast.HT_TRENDMODE(in_real)[lookback:])
+
+    block = pytafast.HT_ALL(in_real, layout="kN")
+    assert block.shape == (8, 500)
+    np.testing.assert_array_equal(block[0], dcperiod)
+
+
+def test_ht_all_edge_cases():
+    np.random.seed(42)
+    close = pd.Series(np.cumsum(np.random.random(100) - 0.5) + 100)
+    outs = pytafast.HT_ALL(close)
+    assert [o.name for o in outs] == ["dcperiod", "dcphase", "inphase", "quadrature",
+                                      "sine", "leadsine", "trendline", "trendmode"]
+    frame = pytafast.HT_ALL(close, layout="Nk")
+    assert list(frame.columns) == [o.name for o in outs]
+
+    # Shorter than every lookback: all NaN
+    short = pytafast.HT_ALL(close.values[:30])
+    assert all(np.isnan(o).all() for o in short)
+    assert all(o.size == 0 for o in pytafast.HT_ALL(np.array([])))
+
+
+def test_ht_stream_matches_batch():
+    np.random.seed(42)
+    in_real = np.cumsum(np.random.random(300) - 0.5) + 100
+    batch = np.array(pytafast.HT_ALL(in_real))
+
+    stream = pytafast.HTStream()
+    assert stream.lookback == pytafast.lookback("HT_ALL")
+    bars = np.array([stream.update(v) for v in in_real[:120]]).T
+    rest = stream.extend(in_real[120:], layout="kN")
+    assert stream.bars == 300
+    close = dict(rtol=1e-12, atol=1e-12, equal_nan=True)
+    np.testing.assert_allclose(np.hstack([bars, rest]), batch, **close)
+
+    stream.reset()
+    assert stream.bars == 0
+    again = stream.extend(in_real)
+    np.testing.assert_allclose(np.array(again), batch, **close)
+
+
+# --- Batch 25: Streaming candlestick patterns ---
+
+def _cdl_bars(n):
+    np.random.seed(42)
+    in_open = np.random.random(n) * 50 + 50
+    in_high = in_open + np.random.random(n) * 5
+    in_low = in_open - np.random.random(n) * 5
+    in_close = in_low + (in_high - in_low) * np.random.random(n)
+    return in_open, in_high, in_low, in_close
+
+
+def test_stream_cdl_matches_batch():
+    bars = _cdl_bars(300)
+    stream = pytafast.StreamCDL()
+    assert sorted(stream.patterns) == sorted(_CDL_STANDARD_LIST + _CDL_PEN_LIST)
+    first = np.array([stream.update(*bar) for bar in zip(*(b[:100] for b in bars))])
+    rest = stream.extend(*(b[100:] for b in bars))
+    signals = np.vstack([first, rest])
+    assert signals.shape == (300, 61) and signals.dtype == np.int32
+    assert stream.bars == 300
+    for j, name in enumerate(stream.patterns):
+        np.testing.assert_array_equal(signals[:, j], getattr(pytafast, name)(*bars),
+                                      err_msg=name)
+
+
+def test_stream_cdl_selection():
+    bars = _cdl_bars(120)
+    stream = pytafast.StreamCDL(["cdlmathold", "CDLDOJI", "CDLMORNINGSTAR"],
+                                penetration=0.1)
+    assert stream.patterns == ["CDLMATHOLD", "CDLDOJI", "CDLMORNINGSTAR"]
+    signals = stream.extend(*bars)
+    np.testing.assert_array_equal(signals[:, 0],
+                                  pytafast.CDLMATHOLD(*bars, penetration=0.1))
+    np.testing.assert_array_equal(signals[:, 1], pytafast.CDLDOJI(*bars))
+    np.testing.assert_array_equal(signals[:, 2],
+                                  pytafast.CDLMORNINGSTAR(*bars, penetration=0.1))
+
+    stream.reset()
+    assert stream.bars == 0
+    np.testing.assert_array_equal(stream.extend(*bars), signals)
+    with pytest.raises(ValueError, match="not a candlestick pattern"):
+        pytafast.StreamCDL(["SMA"])
+    with pytest.raises(ValueError):
+        pytafast.StreamCDL(["CDLNOPE"])
+    with pytest.raises(RuntimeError, match="Input lengths must match"):
+        stream.extend(bars[0], bars[1], bars[2], bars[3][:10])